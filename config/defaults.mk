@@ -92,6 +92,7 @@ MFEM_USE_LIBUNWIND   = NO
 MFEM_USE_LAPACK      = NO
 MFEM_THREAD_SAFE     = NO
 MFEM_USE_OPENMP      = NO
+MFEM_USE_PTHREADS    = NO
 MFEM_USE_MEMALLOC    = YES
 MFEM_TIMER_TYPE      = $(if $(NOTMAC),2,4)
 MFEM_USE_SUNDIALS    = NO
@@ -150,6 +151,10 @@ LAPACK_LIB = $(if $(NOTMAC),-llapack -lblas,-framework Accelerate)
 OPENMP_OPT = -fopenmp
 OPENMP_LIB =
 
+# POSIX threads configuration
+PTHREADS_OPT =
+PTHREADS_LIB = -lpthread
+
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
@@ -30,7 +30,17 @@
 #endif
 
 #define MFEM_TEMPLATE_BLOCK_SIZE 4
+// SIMD width in bytes of the widest x86 instruction set enabled at compile
+// time (or of a double, without SIMD); used for alignment and by NativeSIMD.
+#if defined(__AVX512F__)
+#define MFEM_SIMD_SIZE 64
+#elif defined(__AVX__)
 #define MFEM_SIMD_SIZE 32
+#elif defined(__SSE2__)
+#define MFEM_SIMD_SIZE 16
+#else
+#define MFEM_SIMD_SIZE 8
+#endif
 #define MFEM_TEMPLATE_ENABLE_SERIALIZE
 
 // #define MFEM_TEMPLATE_ELTRANS_HAS_NODE_DOFS
@@ -47,14 +57,20 @@ namespace mfem
 {
 namespace internal
 {
-long long flop_count;
+// The counter is a static member of a class template, so that this header can
+// be included in multiple translation units.
+template <bool dummy = true>
+struct FlopCount { static long long value; };
+
+template <bool dummy>
+long long FlopCount<dummy>::value = 0;
 }
 }
 
 #ifdef MFEM_COUNT_FLOPS
-#define MFEM_FLOPS_RESET() (mfem::internal::flop_count = 0)
-#define MFEM_FLOPS_ADD(cnt) (mfem::internal::flop_count += (cnt))
-#define MFEM_FLOPS_GET() (mfem::internal::flop_count)
+#define MFEM_FLOPS_RESET() (mfem::internal::FlopCount<>::value = 0)
+#define MFEM_FLOPS_ADD(cnt) (mfem::internal::FlopCount<>::value += (cnt))
+#define MFEM_FLOPS_GET() (mfem::internal::FlopCount<>::value)
 #else
 #define MFEM_FLOPS_RESET()
 #define MFEM_FLOPS_ADD(cnt)
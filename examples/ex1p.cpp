@@ -24,6 +24,7 @@
 //               mpirun -np 4 ex1p -m ../data/amr-hex.mesh
 //               mpirun -np 4 ex1p -m ../data/mobius-strip.mesh
 //               mpirun -np 4 ex1p -m ../data/mobius-strip.mesh -o -1 -sc
+//               mpirun -np 4 ex1p -m ../data/fichera.mesh -pr
 //
 // Description:  This example code demonstrates the use of MFEM to define a
 //               simple finite element discretization of the Laplace problem
@@ -59,6 +60,7 @@ int main(int argc, char *argv[])
    const char *mesh_file = "../data/star.mesh";
    int order = 1;
    bool static_cond = false;
+   bool par_read = false;
    bool visualization = 1;
 
    OptionsParser args(argc, argv);
@@ -69,6 +71,9 @@ int main(int argc, char *argv[])
                   " isoparametric space.");
    args.AddOption(&static_cond, "-sc", "--static-condensation", "-no-sc",
                   "--no-static-condensation", "Enable static condensation.");
+   args.AddOption(&par_read, "-pr", "--parallel-read", "-no-pr",
+                  "--no-parallel-read",
+                  "Read the mesh file in parallel, without a serial mesh.");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -89,34 +94,48 @@ int main(int argc, char *argv[])
 
    // 3. Read the (serial) mesh from the given mesh file on all processors.  We
    //    can handle triangular, quadrilateral, tetrahedral, hexahedral, surface
-   //    and volume meshes with the same code.
-   Mesh *mesh = new Mesh(mesh_file, 1, 1);
-   int dim = mesh->Dimension();
-
-   // 4. Refine the serial mesh on all processors to increase the resolution. In
-   //    this example we do 'ref_levels' of uniform refinement. We choose
-   //    'ref_levels' to be the largest number that gives a final mesh with no
-   //    more than 10,000 elements.
+   //    and volume meshes with the same code. With the '-pr' option, the file
+   //    is instead read in parallel, each processor reading only a part of it,
+   //    and the elements are distributed in blocks without forming the serial
+   //    mesh (only linear meshes in the MFEM format are supported).
+   ParMesh *pmesh;
+   int par_ref_levels = 2;
+   if (!par_read)
    {
-      int ref_levels =
-         (int)floor(log(10000./mesh->GetNE())/log(2.)/dim);
-      for (int l = 0; l < ref_levels; l++)
+      Mesh *mesh = new Mesh(mesh_file, 1, 1);
+      int dim = mesh->Dimension();
+
+      // 4. Refine the serial mesh on all processors to increase the
+      //    resolution. In this example we do 'ref_levels' of uniform
+      //    refinement. We choose 'ref_levels' to be the largest number that
+      //    gives a final mesh with no more than 10,000 elements.
       {
-         mesh->UniformRefinement();
+         int ref_levels =
+            (int)floor(log(10000./mesh->GetNE())/log(2.)/dim);
+         for (int l = 0; l < ref_levels; l++)
+         {
+            mesh->UniformRefinement();
+         }
       }
-   }
 
-   // 5. Define a parallel mesh by a partitioning of the serial mesh. Refine
-   //    this mesh further in parallel to increase the resolution. Once the
-   //    parallel mesh is defined, the serial mesh can be deleted.
-   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, *mesh);
-   delete mesh;
+      // 5. Define a parallel mesh by a partitioning of the serial mesh. Once
+      //    the parallel mesh is defined, the serial mesh can be deleted.
+      pmesh = new ParMesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+   }
+   else
    {
-      int par_ref_levels = 2;
-      for (int l = 0; l < par_ref_levels; l++)
-      {
-         pmesh->UniformRefinement();
-      }
+      // 4-5. Read the parallel mesh directly from the file. The serial
+      //      refinement is replaced by the same number of additional parallel
+      //      refinement levels.
+      pmesh = new ParMesh(MPI_COMM_WORLD, mesh_file);
+      par_ref_levels += (int)floor(log(10000./pmesh->GetGlobalNE())/log(2.)/
+                                   pmesh->Dimension());
+   }
+   int dim = pmesh->Dimension();
+   for (int l = 0; l < par_ref_levels; l++)
+   {
+      pmesh->UniformRefinement();
    }
 
    // 6. Define a parallel finite element space on the parallel mesh. Here we
@@ -12,6 +12,7 @@
 // Implementation of class BilinearForm
 
 #include "fem.hpp"
+#include "../general/profiler.hpp"
 #include <cmath>
 
 namespace mfem
@@ -289,6 +290,7 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble (int skip_zeros)
 {
+   MFEM_PROFILE_REGION("BilinearForm::Assemble");
    ElementTransformation *eltrans;
    Mesh *mesh = fes -> GetMesh();
    DenseMatrix elmat, *elmat_p;
@@ -309,7 +311,12 @@ void BilinearForm::Assemble (int skip_zeros)
    }
 #endif
 
-   if (dbfi.Size())
+   if (dbfi.Size() && static_cond && element_matrices)
+   {
+      // Factor the element matrices concurrently
+      static_cond->AssembleMatrices(*element_matrices);
+   }
+   else if (dbfi.Size())
    {
       for (i = 0; i < fes -> GetNE(); i++)
       {
@@ -713,6 +720,52 @@ void BilinearForm::ComputeElementMatrices()
    }
 }
 
+BSRMatrix *BilinearForm::AssembleBSR()
+{
+   const int vdim = fes->GetVDim();
+   MFEM_VERIFY(vdim == 1 || fes->GetOrdering() == Ordering::byVDIM,
+               "the FE space must use Ordering::byVDIM");
+   MFEM_VERIFY(fes->GetConformingProlongation() == NULL,
+               "non-conforming spaces are not supported");
+   MFEM_VERIFY(bbfi.Size() == 0 && fbfi.Size() == 0 && bfbfi.Size() == 0,
+               "only domain integrators are supported");
+   MFEM_VERIFY(!static_cond && !hybridization,
+               "static condensation and hybridization are not supported");
+
+   // the block sparsity pattern is defined from the map: element->dof
+   const Table &elem_dof = fes->GetElementToDofTable();
+   Table dof_elem, dof_dof;
+   Transpose(elem_dof, dof_elem, fes->GetNDofs());
+   mfem::Mult(dof_elem, elem_dof, dof_dof);
+
+   BSRMatrix *A = new BSRMatrix(dof_dof, vdim);
+   if (dbfi.Size() == 0) { return A; }
+
+   DenseMatrix elmat, *elmat_p;
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      if (element_matrices)
+      {
+         elmat_p = &(*element_matrices)(i);
+      }
+      else
+      {
+         const FiniteElement &fe = *fes->GetFE(i);
+         ElementTransformation *eltrans = fes->GetElementTransformation(i);
+         dbfi[0]->AssembleElementMatrix(fe, *eltrans, elmat);
+         for (int k = 1; k < dbfi.Size(); k++)
+         {
+            dbfi[k]->AssembleElementMatrix(fe, *eltrans, elemmat);
+            elmat += elemmat;
+         }
+         elmat_p = &elmat;
+      }
+      A->AddSubMatrix(vdofs, vdofs, *elmat_p);
+   }
+   return A;
+}
+
 void BilinearForm::EliminateEssentialBC(const Array<int> &bdr_attr_is_ess,
                                         const Vector &sol, Vector &rhs, DiagonalPolicy dpolicy)
 {
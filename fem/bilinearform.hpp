@@ -139,6 +139,9 @@ public:
                             BilinearFormIntegrator *constr_integ,
                             const Array<int> &ess_tdof_list);
 
+   /// Return the Hybridization object, if hybridization is enabled.
+   Hybridization *GetHybridization() const { return hybridization; }
+
    /** For scalar FE spaces, precompute the sparsity pattern of the matrix
        (assuming dense element matrices) based on the types of integrators
        present in the bilinear form. */
@@ -333,6 +336,16 @@ public:
    /// Compute and store internally all element matrices.
    void ComputeElementMatrices();
 
+   /** @brief Assemble the domain integrators into a new BSRMatrix with
+       vdim x vdim blocks, without forming the internal SparseMatrix.
+
+       The FE space must be conforming and, for vdim > 1, use Ordering::byVDIM.
+       Boundary and face integrators, static condensation and hybridization are
+       not supported. Essential boundary conditions can be imposed with
+       BSRMatrix::EliminateRowsCols(). The returned matrix is owned by the
+       caller. */
+   BSRMatrix *AssembleBSR();
+
    /// Free the memory used by the element matrices.
    void FreeElementMatrices()
    { delete element_matrices; element_matrices = NULL; }
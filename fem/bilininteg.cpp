@@ -61,6 +61,16 @@ void BilinearFormIntegrator::AssembleElementVector(
               "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssembleElementGradAction(
+   const FiniteElement &el, ElementTransformation &Tr, const Vector &elfun,
+   const Vector &elv, Vector &elvect)
+{
+   DenseMatrix elmat;
+   AssembleElementMatrix(el, Tr, elmat);
+   elvect.SetSize(elmat.Height());
+   elmat.Mult(elv, elvect);
+}
+
 
 void TransposeIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
@@ -524,13 +534,14 @@ void DiffusionIntegrator::AssembleElementVector(
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix dshape(nd,dim), invdfdx(dim), mq(dim);
+   Vector vec(dim), pointflux(dim);
 #else
    dshape.SetSize(nd,dim);
    invdfdx.SetSize(dim);
    mq.SetSize(dim);
-#endif
    vec.SetSize(dim);
    pointflux.SetSize(dim);
+#endif
 
    elvect.SetSize(nd);
 
@@ -603,12 +614,13 @@ void DiffusionIntegrator::ComputeElementFlux
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix dshape(nd,dim), invdfdx(dim, spaceDim);
+   Vector vec(dim), pointflux(spaceDim);
 #else
    dshape.SetSize(nd,dim);
    invdfdx.SetSize(dim, spaceDim);
-#endif
    vec.SetSize(dim);
    pointflux.SetSize(spaceDim);
+#endif
 
    const IntegrationRule &ir = fluxelem.GetNodes();
    fnd = ir.GetNPoints();
@@ -659,6 +671,7 @@ double DiffusionIntegrator::ComputeFluxEnergy
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix mq;
+   Vector shape, pointflux, vec;
 #endif
 
    shape.SetSize(nd);
@@ -1503,6 +1516,7 @@ double CurlCurlIntegrator::ComputeFluxEnergy(const FiniteElement &fluxelem,
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix vshape;
+   Vector pointflux, vec;
 #endif
    vshape.SetSize(nd, dim);
    pointflux.SetSize(dim);
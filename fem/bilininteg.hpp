@@ -63,6 +63,12 @@ public:
                                     const Vector &elfun, DenseMatrix &elmat)
    { AssembleElementMatrix(el, Tr, elmat); }
 
+   /// Compute the action of the (exact) local gradient, i.e. the element matrix.
+   virtual void AssembleElementGradAction(const FiniteElement &el,
+                                          ElementTransformation &Tr,
+                                          const Vector &elfun,
+                                          const Vector &elv, Vector &elvect);
+
    virtual void AssembleFaceGrad(const FiniteElement &el1,
                                  const FiniteElement &el2,
                                  FaceElementTransformations &Tr,
@@ -1627,8 +1633,8 @@ protected:
 class DiffusionIntegrator: public BilinearFormIntegrator
 {
 private:
-   Vector vec, pointflux, shape;
 #ifndef MFEM_THREAD_SAFE
+   Vector vec, pointflux, shape;
    DenseMatrix dshape, dshapedxt, invdfdx, mq;
    DenseMatrix te_dshape, te_dshapedxt;
 #endif
@@ -1896,8 +1902,8 @@ public:
 class CurlCurlIntegrator: public BilinearFormIntegrator
 {
 private:
-   Vector vec, pointflux;
 #ifndef MFEM_THREAD_SAFE
+   Vector vec, pointflux;
    DenseMatrix curlshape, curlshape_dFt, M;
    DenseMatrix vshape, projcurl;
 #endif
@@ -28,6 +28,18 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void Coefficient::Eval(Vector &V, ElementTransformation &T,
+                       const IntegrationRule &ir)
+{
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      V(i) = Eval(T, ip);
+   }
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +58,32 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
+                               const IntegrationRule &ir)
+{
+   DenseMatrix pts;
+   Vector transip;
+   T.Transform(ir, pts);
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      pts.GetColumnReference(i, transip);
+      V(i) = Function ? (*Function)(transip) : (*TDFunction)(transip, GetTime());
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T.ElementNo, ip, Component);
 }
 
+void GridFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
+                                   const IntegrationRule &ir)
+{
+   GridF->GetValues(T.ElementNo, ir, V, Component);
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
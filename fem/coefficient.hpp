@@ -59,6 +59,13 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient in the element described by @a T at all
+       points of @a ir, storing the values in @a V. */
+   /** The default implementation calls T.SetIntPoint() and Eval() at every
+       point; derived classes can evaluate all points at once. */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -72,10 +79,15 @@ public:
    /// c is value of constant function
    explicit ConstantCoefficient(double c = 1.0) { constant=c; }
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir)
+   { V.SetSize(ir.GetNPoints()); V = constant; }
 };
 
 /// class for piecewise constant coefficient
@@ -107,6 +119,7 @@ public:
    /// Returns the number of constants
    int GetNConst() { return constants.Size(); }
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient function
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
@@ -152,9 +165,14 @@ public:
       TDFunction = reinterpret_cast<double(*)(const Vector&,double)>(tdf);
    }
 
+   using Coefficient::Eval;
    /// Evaluate coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// Evaluate the coefficient at all points of @a ir, see Coefficient.
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
 };
 
 class GridFunction;
@@ -176,8 +194,14 @@ public:
    void SetGridFunction(GridFunction *gf) { GridF = gf; }
    GridFunction * GetGridFunction() const { return GridF; }
 
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the GridFunction at all points of @a ir, using
+       GridFunction::GetValues(). */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
 };
 
 class TransformedCoefficient : public Coefficient
@@ -195,6 +219,7 @@ public:
                            double (*F)(double,double))
       : Q1(q1), Q2(q2), Transform2(F) { Transform1 = 0; }
 
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 };
 
@@ -254,6 +279,7 @@ public:
    void GetDeltaCenter(Vector& center);
    /// Return the Scale() multiplied by the weight Coefficient, if any.
    virtual double EvalDelta(ElementTransformation &T, const IntegrationPoint &ip);
+   using Coefficient::Eval;
    /** @brief A DeltaFunction cannot be evaluated. Calling this method will
        cause an MFEM error, terminating the application. */
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip)
@@ -272,6 +298,7 @@ public:
    RestrictedCoefficient(Coefficient &_c, Array<int> &attr)
    { c = &_c; attr.Copy(active_attr); }
 
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip)
    { return active_attr[T.Attribute-1] ? c->Eval(T, ip, GetTime()) : 0.0; }
 };
@@ -466,6 +493,7 @@ public:
    void SetGridFunction(GridFunction *gf) { GridFunc = gf; }
    GridFunction * GetGridFunction() const { return GridFunc; }
 
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
 
@@ -678,6 +706,7 @@ public:
                   double _alpha = 1.0, double _beta = 1.0)
       : a(&A), b(&B), alpha(_alpha), beta(_beta) { }
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
@@ -695,6 +724,7 @@ public:
    ProductCoefficient(Coefficient &A, Coefficient &B)
       : a(&A), b(&B) { }
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
@@ -714,6 +744,7 @@ public:
    PowerCoefficient(Coefficient &A, double _p)
       : a(&A), p(_p) { }
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
@@ -732,6 +763,7 @@ private:
 public:
    InnerProductCoefficient(VectorCoefficient &A, VectorCoefficient &B);
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
@@ -750,6 +782,7 @@ private:
 public:
    VectorRotProductCoefficient(VectorCoefficient &A, VectorCoefficient &B);
 
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
 };
@@ -765,6 +798,7 @@ private:
 public:
    DeterminantCoefficient(MatrixCoefficient &A);
 
+   using Coefficient::Eval;
    /// Evaluate the coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
@@ -17,6 +17,11 @@
 #include <fstream>
 #include <cerrno>      // errno
 #include <sstream>
+#include <deque>
+#include <vector>
+#ifdef MFEM_USE_PTHREADS
+#include <pthread.h>
+#endif
 
 #ifndef _WIN32
 #include <sys/stat.h>  // mkdir
@@ -68,6 +73,259 @@ int DataCollection::create_directory(const std::string &dir_name,
    return err;
 }
 
+// class DataCollection::AsyncWriter
+
+/** A queue of files, each staged with a snapshot of its contents, that are
+    written to disk by a background thread in the order they were pushed. The
+    files are tagged with the number of the Save() that staged them, which is
+    used to limit the number of pending saves. The snapshots are created and
+    deleted by the calling thread, the background thread only prints them. */
+class DataCollection::AsyncWriter
+{
+public:
+   /// A file to be written, owning the snapshot of its contents.
+   class File
+   {
+   public:
+      std::string name;
+      int precision;
+
+      File(const std::string &name_, int precision_)
+         : name(name_), precision(precision_) { }
+
+      /// Write the file, return false on error.
+      bool Write() const
+      {
+         std::ofstream file(name.c_str());
+         file.precision(precision);
+         Print(file);
+         return file.good();
+      }
+
+      virtual void Print(std::ostream &out) const = 0;
+
+      virtual ~File() { }
+   };
+
+   /// A file with given text, e.g. a root file.
+   class TextFile : public File
+   {
+   public:
+      std::string text;
+
+      TextFile(const std::string &name_, int precision_)
+         : File(name_, precision_) { }
+
+      virtual void Print(std::ostream &out) const { out << text; }
+   };
+
+   /// A mesh file, written from an (owned) copy of the mesh.
+   class MeshFile : public File
+   {
+   public:
+      Mesh *mesh;
+      bool par_format;
+
+      MeshFile(const std::string &name_, int precision_, Mesh *mesh_,
+               bool par_format_)
+         : File(name_, precision_), mesh(mesh_), par_format(par_format_) { }
+
+      virtual void Print(std::ostream &out) const
+      {
+#ifdef MFEM_USE_MPI
+         const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+         if (pmesh && par_format)
+         {
+            pmesh->ParPrint(out);
+         }
+         else
+#endif
+         {
+            mesh->Print(out);
+         }
+      }
+
+      virtual ~MeshFile() { delete mesh; }
+   };
+
+   /** A GridFunction or QuadratureFunction file: the header with the
+       description of the space followed by the data, as written by
+       GridFunction::Save() and QuadratureFunction::Save(). */
+   class FieldFile : public File
+   {
+   public:
+      std::string header;
+      Vector data;
+      int vdim;
+
+      FieldFile(const std::string &name_, int precision_)
+         : File(name_, precision_), vdim(1) { }
+
+      virtual void Print(std::ostream &out) const
+      {
+         out << header;
+         data.Print(out, vdim);
+      }
+   };
+
+protected:
+   int max_pending;
+   long last_save; ///< number of the last save, files are tagged with it
+   long writing;   ///< number of the save being written, or -1 if idle
+
+   std::deque<std::pair<long, File*> > queue;
+   std::vector<File*> written;
+   std::vector<std::string> failed;
+
+#ifdef MFEM_USE_PTHREADS
+   bool stop;
+   pthread_t thread;
+   pthread_mutex_t mutex;
+   pthread_cond_t cond; // signals any change of the queue or of 'writing'
+
+   static void *Run(void *writer)
+   {
+      static_cast<AsyncWriter*>(writer)->Loop();
+      return NULL;
+   }
+
+   void Loop()
+   {
+      pthread_mutex_lock(&mutex);
+      while (1)
+      {
+         while (queue.empty() && !stop)
+         {
+            pthread_cond_wait(&cond, &mutex);
+         }
+         if (queue.empty()) { break; }
+
+         File *file = queue.front().second;
+         writing = queue.front().first;
+         queue.pop_front();
+
+         pthread_mutex_unlock(&mutex);
+         bool ok = file->Write();
+         pthread_mutex_lock(&mutex);
+
+         Written(file, ok);
+         writing = -1;
+         pthread_cond_broadcast(&cond);
+      }
+      pthread_mutex_unlock(&mutex);
+   }
+#endif
+
+   void Lock()
+   {
+#ifdef MFEM_USE_PTHREADS
+      pthread_mutex_lock(&mutex);
+#endif
+   }
+
+   void Unlock()
+   {
+#ifdef MFEM_USE_PTHREADS
+      pthread_mutex_unlock(&mutex);
+#endif
+   }
+
+   /// Block until the condition changes.
+   void WaitChange()
+   {
+#ifdef MFEM_USE_PTHREADS
+      pthread_cond_wait(&cond, &mutex);
+#endif
+   }
+
+   void Written(File *file, bool ok)
+   {
+      written.push_back(file);
+      if (!ok) { failed.push_back(file->name); }
+   }
+
+   /// The number of saves that still have files to write.
+   long Pending() const
+   {
+      long first = (writing >= 0) ? writing :
+                   (queue.empty() ? last_save + 1 : queue.front().first);
+      return last_save + 1 - first;
+   }
+
+public:
+   AsyncWriter(int max_pending_)
+      : max_pending(max_pending_), last_save(0), writing(-1)
+   {
+#ifdef MFEM_USE_PTHREADS
+      stop = false;
+      pthread_mutex_init(&mutex, NULL);
+      pthread_cond_init(&cond, NULL);
+      int err = pthread_create(&thread, NULL, Run, this);
+      MFEM_VERIFY(!err, "error creating the output thread: " << err);
+#endif
+   }
+
+   /** Start a new save: wait until less than max_pending saves are pending,
+       then tag the following files with a new save number. */
+   void BeginSave()
+   {
+      Lock();
+      while (Pending() >= max_pending) { WaitChange(); }
+      last_save++;
+      Unlock();
+   }
+
+   /// Add a file to the queue, taking ownership of it.
+   void Push(File *file)
+   {
+#ifdef MFEM_USE_PTHREADS
+      Lock();
+      queue.push_back(std::make_pair(last_save, file));
+      pthread_cond_broadcast(&cond);
+      Unlock();
+#else
+      Written(file, file->Write());
+#endif
+   }
+
+   /// Wait until all files in the queue are written.
+   void Wait()
+   {
+      Lock();
+      while (Pending() > 0) { WaitChange(); }
+      Unlock();
+   }
+
+   /** Delete the files written so far, append the names of the ones that could
+       not be written to @a failed_names. */
+   void Collect(std::vector<std::string> &failed_names)
+   {
+      std::vector<File*> done;
+      Lock();
+      done.swap(written);
+      failed_names.insert(failed_names.end(), failed.begin(), failed.end());
+      failed.clear();
+      Unlock();
+      for (unsigned i = 0; i < done.size(); i++) { delete done[i]; }
+   }
+
+   /// Write the remaining files and stop the background thread.
+   ~AsyncWriter()
+   {
+#ifdef MFEM_USE_PTHREADS
+      Lock();
+      stop = true;
+      pthread_cond_broadcast(&cond);
+      Unlock();
+      pthread_join(thread, NULL);
+      pthread_cond_destroy(&cond);
+      pthread_mutex_destroy(&mutex);
+#endif
+      for (unsigned i = 0; i < written.size(); i++) { delete written[i]; }
+   }
+};
+
+
 // class DataCollection implementation
 
 DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
@@ -109,6 +367,7 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    pad_digits_cycle = pad_digits_rank = pad_digits_default;
    format = SERIAL_FORMAT; // use serial mesh format
    error = NO_ERROR;
+   async_writer = NULL;
 }
 
 void DataCollection::SetMesh(Mesh *new_mesh)
@@ -182,22 +441,80 @@ void DataCollection::Load(int cycle)
    MFEM_ABORT("this method is not implemented");
 }
 
+void DataCollection::SetAsyncSave(bool async, int max_pending)
+{
+   MFEM_VERIFY(max_pending >= 1, "invalid max_pending: " << max_pending);
+   if (async_writer)
+   {
+      WaitSave();
+      delete async_writer;
+      async_writer = NULL;
+   }
+   if (async)
+   {
+      async_writer = new AsyncWriter(max_pending);
+   }
+}
+
+void DataCollection::WaitSave()
+{
+   if (async_writer)
+   {
+      async_writer->Wait();
+      CollectAsyncErrors();
+   }
+}
+
+void DataCollection::CollectAsyncErrors()
+{
+   std::vector<std::string> failed;
+   async_writer->Collect(failed);
+   for (unsigned i = 0; i < failed.size(); i++)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error writing file: " << failed[i]);
+   }
+}
+
+void DataCollection::SaveAsyncText(const std::string &file_name,
+                                   const std::string &text)
+{
+   AsyncWriter::TextFile *file =
+      new AsyncWriter::TextFile(file_name, precision);
+   file->text = text;
+   async_writer->Push(file);
+}
+
 void DataCollection::Save()
 {
-   SaveMesh();
+   if (async_writer)
+   {
+      // wait until less than max_pending saves are pending
+      async_writer->BeginSave();
+   }
 
-   if (error) { return; }
+   SaveMesh();
 
-   for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+   if (!error)
    {
-      SaveOneField(it);
-      // Even if there is an error, try saving the other fields
+      for (FieldMapIterator it = field_map.begin(); it != field_map.end();
+           ++it)
+      {
+         SaveOneField(it);
+         // Even if there is an error, try saving the other fields
+      }
+
+      for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+           ++it)
+      {
+         SaveOneQField(it);
+      }
    }
 
-   for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
-        ++it)
+   if (async_writer)
    {
-      SaveOneQField(it);
+      // report the errors of the previous saves
+      CollectAsyncErrors();
    }
 }
 
@@ -219,6 +536,21 @@ void DataCollection::SaveMesh()
    }
 
    std::string mesh_name = GetMeshFileName();
+   if (async_writer)
+   {
+      // the background thread writes a copy of the mesh
+#ifdef MFEM_USE_MPI
+      const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+      Mesh *mesh_copy = pmesh ? new ParMesh(*pmesh) : new Mesh(*mesh);
+#else
+      Mesh *mesh_copy = new Mesh(*mesh);
+#endif
+      async_writer->Push(
+         new AsyncWriter::MeshFile(mesh_name, precision, mesh_copy,
+                                   format == PARALLEL_FORMAT));
+      return;
+   }
+
    std::ofstream mesh_file(mesh_name.c_str());
    mesh_file.precision(precision);
 #ifdef MFEM_USE_MPI
@@ -267,6 +599,24 @@ const
 
 void DataCollection::SaveOneField(const FieldMapIterator &it)
 {
+   if (async_writer)
+   {
+      const GridFunction *gf = it->second;
+      const FiniteElementSpace *fes = gf->FESpace();
+      AsyncWriter::FieldFile *file =
+         new AsyncWriter::FieldFile(GetFieldFileName(it->first), precision);
+      std::ostringstream header;
+      header.precision(precision);
+      fes->Save(header);
+      header << '\n';
+      file->header = header.str();
+      gf->GetSaveData(file->data);
+      file->vdim =
+         (fes->GetOrdering() == Ordering::byNODES) ? 1 : fes->GetVDim();
+      async_writer->Push(file);
+      return;
+   }
+
    std::ofstream field_file(GetFieldFileName(it->first).c_str());
    field_file.precision(precision);
    (it->second)->Save(field_file);
@@ -279,6 +629,22 @@ void DataCollection::SaveOneField(const FieldMapIterator &it)
 
 void DataCollection::SaveOneQField(const QFieldMapIterator &it)
 {
+   if (async_writer)
+   {
+      const QuadratureFunction *qf = it->second;
+      AsyncWriter::FieldFile *file =
+         new AsyncWriter::FieldFile(GetFieldFileName(it->first), precision);
+      std::ostringstream header;
+      qf->GetSpace()->Save(header);
+      header << "VDim: " << qf->GetVDim() << '\n'
+             << '\n';
+      file->header = header.str();
+      file->data = *qf;
+      file->vdim = qf->GetVDim();
+      async_writer->Push(file);
+      return;
+   }
+
    std::ofstream q_field_file(GetFieldFileName(it->first).c_str());
    q_field_file.precision(precision);
    (it->second)->Save(q_field_file);
@@ -326,6 +692,7 @@ void DataCollection::DeleteAll()
 
 DataCollection::~DataCollection()
 {
+   SetAsyncSave(false);
    DeleteData();
 }
 
@@ -452,6 +819,12 @@ void VisItDataCollection::SaveRootFile()
    std::string root_name = prefix_path + name + "_" +
                            to_padded_string(cycle, pad_digits_cycle) +
                            ".mfem_root";
+   if (async_writer)
+   {
+      // queued after the data files, so it appears when they are complete
+      SaveAsyncText(root_name, GetVisItRootString());
+      return;
+   }
    std::ofstream root_file(root_name.c_str());
    root_file << GetVisItRootString();
    if (!root_file)
@@ -463,6 +836,7 @@ void VisItDataCollection::SaveRootFile()
 
 void VisItDataCollection::Load(int cycle_)
 {
+   WaitSave(); // the files may still be written
    DeleteAll();
    time_step = 0.0;
    error = NO_ERROR;
@@ -212,6 +212,11 @@ protected:
    /// Error state
    int error;
 
+   /// Writes the files of the asynchronous saves, see SetAsyncSave().
+   class AsyncWriter;
+   /// The background writer, or NULL if the asynchronous mode is off
+   AsyncWriter *async_writer;
+
    /// Delete data owned by the DataCollection keeping field information
    void DeleteData();
    /// Delete data owned by the DataCollection including field information
@@ -227,6 +232,11 @@ protected:
    /// Save one q-field to disk, assuming the collection directory exists
    void SaveOneQField(const QFieldMapIterator &it);
 
+   /// Report the errors of the completed asynchronous writes (if any)
+   void CollectAsyncErrors();
+   /// In the asynchronous mode, hand a text file to the background writer
+   void SaveAsyncText(const std::string &file_name, const std::string &text);
+
    // Helper method
    static int create_directory(const std::string &dir_name,
                                const Mesh *mesh, int myid);
@@ -364,6 +374,25 @@ public:
    /// Save one q-field, assuming the collection directory already exists.
    virtual void SaveQField(const std::string &q_field_name);
 
+   /// Turn on/off the asynchronous save mode.
+   /** In this mode, Save(), SaveMesh(), SaveField() and SaveQField() take a
+       snapshot of the mesh and of the field data and return, while the files
+       are written by a background thread, so that the output overlaps with
+       the computation. At most @a max_pending saves can be staged or in the
+       process of being written: when the limit is reached, Save() blocks until
+       the oldest one is on disk. The default, 2, double-buffers the output.
+
+       Errors from the background writes are reported by Error() after the
+       next Save() or WaitSave(). Turning the mode off waits for the pending
+       saves. Without MFEM_USE_PTHREADS, the snapshots are written right away
+       by the calling thread. Derived classes that override Save() with their
+       own output format, e.g. SidreDataCollection, ignore this mode. */
+   void SetAsyncSave(bool async, int max_pending = 2);
+   /// Is the asynchronous save mode on?
+   bool GetAsyncSave() const { return async_writer != NULL; }
+   /// Wait for all asynchronous saves to be written to disk.
+   void WaitSave();
+
    /// Load the collection. Not implemented in the base class DataCollection.
    virtual void Load(int cycle_ = 0);
 
@@ -68,6 +68,12 @@ public:
 
     The required BilinearFormIntegrator must implement the methods
     ComputeElementFlux() and ComputeFluxEnergy().
+
+    When MFEM is built with OpenMP, the flux recovery and the element estimates
+    are computed in parallel, so these methods must be thread-safe, as is the
+    case for DiffusionIntegrator, CurlCurlIntegrator and ElasticityIntegrator
+    (OpenMP builds use MFEM_THREAD_SAFE, where these integrators use local work
+    arrays).
  */
 class ZienkiewiczZhuEstimator : public AnisotropicErrorEstimator
 {
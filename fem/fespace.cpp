@@ -12,6 +12,8 @@
 // Implementation of FiniteElementSpace
 
 #include "../general/text.hpp"
+#include "../general/profiler.hpp"
+#include "../general/sort_pairs.hpp"
 #include "../mesh/mesh_headers.hpp"
 #include "fem.hpp"
 
@@ -60,6 +62,7 @@ FiniteElementSpace::FiniteElementSpace()
      ndofs(0), nvdofs(0), nedofs(0), nfdofs(0), nbdofs(0),
      fdofs(NULL), bdofs(NULL),
      elem_dof(NULL), bdrElem_dof(NULL),
+     dof_reordering(DofReordering::NONE),
      NURBSext(NULL), own_ext(false),
      cP(NULL), cR(NULL), cP_is_set(false),
      Th(Operator::ANY_TYPE),
@@ -89,6 +92,10 @@ FiniteElementSpace::FiniteElementSpace(const FiniteElementSpace &orig,
       }
    }
    Constructor(mesh, NURBSext, fec, orig.vdim, orig.ordering);
+   if (orig.dof_reordering != DofReordering::NONE)
+   {
+      ReorderDofs(orig.dof_reordering);
+   }
 }
 
 int FiniteElementSpace::GetOrder(int i) const
@@ -259,6 +266,175 @@ void FiniteElementSpace::ReorderElementToDofTable()
    }
 }
 
+// Breadth-first search in the graph 'adj' from the vertex 'root', restricted to
+// the vertices with mark[v] == 0. Return the number of levels and the vertices
+// of the last level in 'last'. On entry and exit, all entries of 'level' are
+// negative.
+static int RCMLevels(const Table &adj, int root, const Array<int> &mark,
+                     Array<int> &level, Array<int> &queue, Array<int> &last)
+{
+   queue.SetSize(0);
+   queue.Append(root);
+   level[root] = 0;
+   for (int h = 0; h < queue.Size(); h++)
+   {
+      const int v = queue[h];
+      const int *row = adj.GetRow(v);
+      for (int j = 0; j < adj.RowSize(v); j++)
+      {
+         const int u = row[j];
+         if (!mark[u] && level[u] < 0)
+         {
+            level[u] = level[v] + 1;
+            queue.Append(u);
+         }
+      }
+   }
+   const int num_levels = level[queue.Last()] + 1;
+   last.SetSize(0);
+   for (int h = 0; h < queue.Size(); h++)
+   {
+      if (level[queue[h]] == num_levels - 1) { last.Append(queue[h]); }
+      level[queue[h]] = -1;
+   }
+   return num_levels;
+}
+
+// Compute the reverse Cuthill-McKee ordering of the graph 'adj' as a map from
+// the old to the new vertex numbers. Each connected component is started from
+// a pseudo-peripheral vertex, found with the George-Liu algorithm.
+static void ReverseCuthillMcKee(const Table &adj, Array<int> &new_num)
+{
+   const int n = adj.Size();
+   Array<int> mark(n), level(n), order(n), queue, last;
+   Array<Pair<int, int> > nbrs;
+   mark = 0;
+   level = -1;
+
+   int num = 0;
+   for (int seed = 0; seed < n; seed++)
+   {
+      if (mark[seed]) { continue; }
+
+      // Find a pseudo-peripheral root of the component of 'seed'
+      int root = seed;
+      int num_levels = RCMLevels(adj, root, mark, level, queue, last);
+      while (1)
+      {
+         int cand = last[0];
+         for (int i = 1; i < last.Size(); i++)
+         {
+            if (adj.RowSize(last[i]) < adj.RowSize(cand)) { cand = last[i]; }
+         }
+         const int cand_levels = RCMLevels(adj, cand, mark, level, queue,
+                                           last);
+         if (cand_levels <= num_levels) { break; }
+         root = cand;
+         num_levels = cand_levels;
+      }
+
+      // Cuthill-McKee: visit the unmarked neighbors by increasing degree
+      int head = num;
+      order[num++] = root;
+      mark[root] = 1;
+      while (head < num)
+      {
+         const int v = order[head++];
+         const int *row = adj.GetRow(v);
+         nbrs.SetSize(0);
+         for (int j = 0; j < adj.RowSize(v); j++)
+         {
+            const int u = row[j];
+            if (!mark[u])
+            {
+               mark[u] = 1;
+               nbrs.Append(Pair<int, int>(adj.RowSize(u), u));
+            }
+         }
+         SortPairs<int, int>(nbrs, nbrs.Size());
+         for (int j = 0; j < nbrs.Size(); j++)
+         {
+            order[num++] = nbrs[j].two;
+         }
+      }
+   }
+
+   new_num.SetSize(n);
+   for (int i = 0; i < n; i++)
+   {
+      new_num[order[i]] = n - 1 - i;
+   }
+}
+
+void FiniteElementSpace::ReorderDofs(DofReordering::Type type)
+{
+#ifdef MFEM_USE_MPI
+   MFEM_VERIFY(dynamic_cast<const ParFiniteElementSpace*>(this) == NULL,
+               "DOF reordering is not supported for a ParFiniteElementSpace");
+#endif
+   MFEM_VERIFY(!NURBSext, "DOF reordering is not supported for NURBS spaces");
+   MFEM_VERIFY(mesh->GetNodalFESpace() != this,
+               "DOF reordering is not supported for the mesh nodes space");
+
+   // Clear the data that uses the current DOF numbering
+   delete cR;
+   delete cP;
+   cP = cR = NULL;
+   cP_is_set = false;
+   Th.Clear();
+   dof_elem_array.DeleteAll();
+   dof_ldof_array.DeleteAll();
+
+   dof_reordering = type;
+   dof_map.DeleteAll();
+   RebuildElementToDofTable();
+   if (dof_reordering != DofReordering::NONE)
+   {
+      BuildDofReordering();
+   }
+}
+
+void FiniteElementSpace::BuildDofReordering()
+{
+   MFEM_ASSERT(dof_map.Size() == 0, "the DOFs are already reordered");
+
+   const int NE = elem_dof->Size();
+   const int *I = elem_dof->GetI(), *J = elem_dof->GetJ();
+   const int nnz = I[NE];
+
+   if (dof_reordering == DofReordering::FIRST_TOUCH)
+   {
+      dof_map.SetSize(ndofs);
+      dof_map = -1;
+      int dof_counter = 0;
+      for (int k = 0; k < nnz; k++)
+      {
+         const int dof = (J[k] >= 0) ? J[k] : -1-J[k];
+         if (dof_map[dof] < 0) { dof_map[dof] = dof_counter++; }
+      }
+      // DOFs which are not used by any element are numbered last
+      for (int dof = 0; dof < ndofs; dof++)
+      {
+         if (dof_map[dof] < 0) { dof_map[dof] = dof_counter++; }
+      }
+   }
+   else
+   {
+      // The graph of the DOFs connected through the elements, built from an
+      // unsigned copy of the element-to-dof table
+      int *el_I = new int[NE+1], *el_J = new int[nnz];
+      for (int i = 0; i <= NE; i++) { el_I[i] = I[i]; }
+      for (int k = 0; k < nnz; k++) { el_J[k] = (J[k] >= 0) ? J[k] : -1-J[k]; }
+      Table el_dof, dof_el, dof_dof;
+      el_dof.SetIJ(el_I, el_J, NE);
+      Transpose(el_dof, dof_el, ndofs);
+      mfem::Mult(dof_el, el_dof, dof_dof);
+      ReverseCuthillMcKee(dof_dof, dof_map);
+   }
+
+   RebuildElementToDofTable();
+}
+
 void FiniteElementSpace::BuildDofToArrays()
 {
    if (dof_elem_array.Size()) { return; }
@@ -623,7 +799,7 @@ void FiniteElementSpace::BuildConformingInterpolation() const
             GetEntityDofs(entity, slave.index, slave_dofs);
             if (!slave_dofs.Size()) { continue; }
 
-            slave.OrientedPointMatrix(T.GetPointMat());
+            list.OrientedPointMatrix(slave, T.GetPointMat());
             T.FinalizeTransformation();
             fe->GetLocalInterpolation(T, I);
 
@@ -1153,6 +1329,7 @@ void FiniteElementSpace::Constructor(Mesh *mesh, NURBSExtension *NURBSext,
    this->ordering = (Ordering::Type) ordering;
 
    elem_dof = NULL;
+   dof_reordering = DofReordering::NONE;
    sequence = mesh->GetSequence();
    Th.SetType(Operator::ANY_TYPE);
 
@@ -1386,6 +1563,7 @@ void FiniteElementSpace::GetElementDofs (int i, Array<int> &dofs) const
             dofs[ne+j] = k + j;
          }
       }
+      MapDofs(dofs);
    }
 }
 
@@ -1482,6 +1660,7 @@ void FiniteElementSpace::GetBdrElementDofs(int i, Array<int> &dofs) const
             }
          }
       }
+      MapDofs(dofs);
    }
 }
 
@@ -1542,6 +1721,7 @@ void FiniteElementSpace::GetFaceDofs(int i, Array<int> &dofs) const
          dofs[ne+k] = j;
       }
    }
+   MapDofs(dofs);
 }
 
 void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
@@ -1571,6 +1751,7 @@ void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
    {
       dofs[nv+j] = k;
    }
+   MapDofs(dofs);
 }
 
 void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
@@ -1583,6 +1764,7 @@ void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
    {
       dofs[j] = i*nv+j;
    }
+   MapDofs(dofs);
 }
 
 void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
@@ -1596,6 +1778,7 @@ void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k + j;
    }
+   MapDofs(dofs);
 }
 
 void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
@@ -1608,6 +1791,7 @@ void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k;
    }
+   MapDofs(dofs);
 }
 
 void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
@@ -1623,6 +1807,7 @@ void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
          dofs[j] = k;
       }
    }
+   MapDofs(dofs);
 }
 
 const FiniteElement *FiniteElementSpace::GetBE (int i) const
@@ -1698,6 +1883,7 @@ void FiniteElementSpace::Destroy()
 
    dof_elem_array.DeleteAll();
    dof_ldof_array.DeleteAll();
+   dof_map.DeleteAll();
 
    if (NURBSext)
    {
@@ -1781,6 +1967,7 @@ void FiniteElementSpace::GetTrueTransferOperator(
 
 void FiniteElementSpace::Update(bool want_transform)
 {
+   MFEM_PROFILE_REGION("FiniteElementSpace::Update");
    if (mesh->GetSequence() == sequence)
    {
       return; // mesh and space are in sync, no-op
@@ -1812,6 +1999,10 @@ void FiniteElementSpace::Update(bool want_transform)
    Destroy(); // calls Th.Clear()
    Construct();
    BuildElementToDofTable();
+   if (dof_reordering != DofReordering::NONE)
+   {
+      BuildDofReordering();
+   }
 
    if (want_transform)
    {
@@ -44,6 +44,23 @@ public:
    static void DofsToVDofs(int ndofs, int vdim, Array<int> &dofs);
 };
 
+/** @brief The renumbering of the scalar DOFs applied by
+    FiniteElementSpace::ReorderDofs(). */
+class DofReordering
+{
+public:
+   /// %Reordering methods:
+   enum Type
+   {
+      NONE,        /**< the canonical numbering: first all vertex DOFs, then all
+                        edge, face and element interior DOFs */
+      FIRST_TOUCH, /**< number the DOFs in the order in which they are first
+                        used in the loop over the elements */
+      RCM          /**< reverse Cuthill-McKee ordering of the DOF graph, which
+                        reduces the bandwidth of the assembled matrices */
+   };
+};
+
 template <> inline int
 Ordering::Map<Ordering::byNODES>(int ndofs, int vdim, int dof, int vd)
 {
@@ -91,6 +108,12 @@ protected:
 
    Array<int> dof_elem_array, dof_ldof_array;
 
+   /// The renumbering of the DOFs, see ReorderDofs().
+   DofReordering::Type dof_reordering;
+   /** Map from the canonical DOF numbers to the reordered ones; empty when
+       #dof_reordering is DofReordering::NONE. */
+   Array<int> dof_map;
+
    NURBSExtension *NURBSext;
    int own_ext;
 
@@ -114,6 +137,20 @@ protected:
 
    void BuildElementToDofTable() const;
 
+   /// Compute #dof_map from the canonical #elem_dof and rebuild #elem_dof.
+   void BuildDofReordering();
+
+   /// Apply #dof_map, if set, to the canonical (signed) DOFs @a dofs.
+   inline void MapDofs(Array<int> &dofs) const
+   {
+      if (!dof_map.Size()) { return; }
+      for (int i = 0; i < dofs.Size(); i++)
+      {
+         const int d = dofs[i];
+         dofs[i] = (d >= 0) ? dof_map[d] : -1-dof_map[-1-d];
+      }
+   }
+
    /// Helper to remove encoded sign from a DOF
    static inline int DecodeDof(int dof, double& sign)
    { return (dof >= 0) ? (sign = 1, dof) : (sign = -1, (-1 - dof)); }
@@ -385,6 +422,27 @@ public:
        is preserved. */
    void ReorderElementToDofTable();
 
+   /** @brief Renumber the scalar DOFs of the space to improve the locality of
+       the element gather/scatter and of the matrix-vector products.
+
+       Unlike ReorderElementToDofTable(), the new numbering is used by all
+       methods returning DOFs, e.g. GetBdrElementDofs(), GetEdgeDofs() and the
+       conforming interpolation on nonconforming meshes, and it is recomputed
+       after Update(). GridFunction::Save() writes the data in the canonical
+       numbering, so the output does not depend on the reordering.
+
+       This method must be called before any GridFunction or form is defined
+       on the space. Reordering the DOFs of the mesh nodes, of NURBS spaces
+       and of parallel spaces is not supported. */
+   void ReorderDofs(DofReordering::Type type);
+
+   /// Return the DOF reordering method set with ReorderDofs().
+   DofReordering::Type GetDofReordering() const { return dof_reordering; }
+
+   /** Return the map from the canonical DOF numbers to the current ones, see
+       ReorderDofs(); the array is empty if the DOFs are not reordered. */
+   const Array<int> &GetDofReorderingMap() const { return dof_map; }
+
    void BuildDofToArrays();
 
    const Table &GetElementToDofTable() const { return *elem_dof; }
@@ -565,6 +623,9 @@ public:
    /// Return the total number of quadrature points.
    int GetSize() const { return size; }
 
+   /// Return the mesh of the QuadratureSpace.
+   Mesh *GetMesh() const { return mesh; }
+
    /// Get the IntegrationRule associated with mesh element @a idx.
    const IntegrationRule &GetElementIntRule(int idx) const
    { return *int_rule[mesh->GetElementBaseGeometry(idx)]; }
@@ -21,6 +21,9 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -30,6 +33,7 @@ using namespace std;
 GridFunction::GridFunction(Mesh *m, std::istream &input)
    : Vector()
 {
+   tp_eval = NULL;
    fes = new FiniteElementSpace;
    fec = fes->Load(m, input);
 
@@ -63,6 +67,7 @@ GridFunction::GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces)
    // all GridFunctions must have the same FE collection, vdim, ordering
    int vdim, ordering;
 
+   tp_eval = NULL;
    fes = gf_array[0]->FESpace();
    fec = FiniteElementCollection::New(fes->FEColl()->Name());
    vdim = fes->GetVDim();
@@ -234,41 +239,95 @@ void GridFunction::SumFluxAndCount(BilinearFormIntegrator &blfi,
 {
    GridFunction &u = *this;
 
-   ElementTransformation *Transf;
-
    FiniteElementSpace *ufes = u.FESpace();
    FiniteElementSpace *ffes = flux.FESpace();
 
    int nfe = ufes->GetNE();
-   Array<int> udofs;
-   Array<int> fdofs;
-   Vector ul, fl;
+   int fsize = flux.Size();
 
    flux = 0.0;
    count = 0;
 
-   for (int i = 0; i < nfe; i++)
+   // Thread 0 accumulates directly into 'flux' and 'count'; all other threads
+   // use private copies which are summed (in thread order) at the end.
+#ifdef MFEM_USE_OPENMP
+   int nthreads = omp_get_max_threads();
+#else
+   int nthreads = 1;
+#endif
+   Vector t_flux((nthreads-1)*fsize);
+   Array<int> t_count((nthreads-1)*fsize);
+   t_flux = 0.0;
+   t_count = 0;
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel num_threads(nthreads)
+#endif
    {
-      if (subdomain >= 0 && ufes->GetAttribute(i) != subdomain)
+#ifdef MFEM_USE_OPENMP
+      int tid = omp_get_thread_num();
+#else
+      int tid = 0;
+#endif
+      Vector flux_acc;
+      Array<int> count_acc;
+      if (tid == 0)
       {
-         continue;
+         flux_acc.NewDataAndSize(flux.GetData(), fsize);
+         count_acc.MakeRef(count);
+      }
+      else
+      {
+         flux_acc.NewDataAndSize(t_flux.GetData() + (tid-1)*fsize, fsize);
+         count_acc.MakeRef(t_count.GetData() + (tid-1)*fsize, fsize);
       }
 
-      ufes->GetElementVDofs(i, udofs);
-      ffes->GetElementVDofs(i, fdofs);
+      IsoparametricTransformation Transf;
+      Array<int> udofs;
+      Array<int> fdofs;
+      Vector ul, fl;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nfe; i++)
+      {
+         if (subdomain >= 0 && ufes->GetAttribute(i) != subdomain)
+         {
+            continue;
+         }
+
+         ufes->GetElementVDofs(i, udofs);
+         ffes->GetElementVDofs(i, fdofs);
+
+         u.GetSubVector(udofs, ul);
 
-      u.GetSubVector(udofs, ul);
+         ufes->GetElementTransformation(i, &Transf);
+         blfi.ComputeElementFlux(*ufes->GetFE(i), Transf, ul,
+                                 *ffes->GetFE(i), fl, wcoef);
 
-      Transf = ufes->GetElementTransformation(i);
-      blfi.ComputeElementFlux(*ufes->GetFE(i), *Transf, ul,
-                              *ffes->GetFE(i), fl, wcoef);
+         flux_acc.AddElementVector(fdofs, fl);
 
-      flux.AddElementVector(fdofs, fl);
+         FiniteElementSpace::AdjustVDofs(fdofs);
+         for (int j = 0; j < fdofs.Size(); j++)
+         {
+            count_acc[fdofs[j]]++;
+         }
+      }
+   }
 
-      FiniteElementSpace::AdjustVDofs(fdofs);
-      for (int j = 0; j < fdofs.Size(); j++)
+   if (nthreads > 1)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int j = 0; j < fsize; j++)
       {
-         count[fdofs[j]]++;
+         for (int t = 0; t < nthreads-1; t++)
+         {
+            flux(j) += t_flux(t*fsize + j);
+            count[j] += t_count[t*fsize + j];
+         }
       }
    }
 }
@@ -382,6 +441,194 @@ void GridFunction::GetNodalValues(int i, Array<double> &nval, int vdim) const
    }
 }
 
+// Evaluation of a TensorBasisElement at the points of a tensor-product
+// IntegrationRule by sum factorization: the 1D basis functions and their
+// derivatives are tabulated at the 1D points and contracted one direction at a
+// time, which takes O(p^{dim+1}) operations per element instead of the
+// O(p^{2 dim}) of calling CalcShape()/CalcDShape() at every point.
+class TensorProductEvaluator
+{
+protected:
+   int dim, nd1, nq1, wsize;
+   DenseMatrix B, G; // B(q,i) = phi_i(x_q), G(q,i) = phi_i'(x_q)
+   const int *dof_map; // lexicographic to native dofs, NULL = identity
+
+   // The 1D basis and points B and G were tabulated for, see Setup()
+   const Poly_1D::Basis *basis1d;
+   Vector x1d;
+
+   // out(a,q,c) = sum_i M(q,i) in(a,i,c), where in has dimensions na x ni x nc.
+   static void Contract(const DenseMatrix &M, const double *in, int na,
+                        int nc, double *out)
+   {
+      const int nq = M.Height(), ni = M.Width();
+      for (int c = 0; c < nc; c++)
+      {
+         for (int q = 0; q < nq; q++)
+         {
+            double *o = out + na*(q + nq*c);
+            for (int a = 0; a < na; a++) { o[a] = 0.0; }
+            for (int i = 0; i < ni; i++)
+            {
+               const double m = M(q,i);
+               const double *x = in + na*(i + ni*c);
+               for (int a = 0; a < na; a++) { o[a] += m*x[a]; }
+            }
+         }
+      }
+   }
+
+   // Apply M[d] in direction d to the lexicographic dofs u; res has size nq1^dim.
+   void Apply(const DenseMatrix *M[], const double *u, double *res,
+              double *work) const
+   {
+      int na = 1, nc = 1;
+      for (int d = 1; d < dim; d++) { nc *= nd1; }
+      const double *in = u;
+      for (int d = 0; d < dim; d++)
+      {
+         double *out = (d == dim-1) ? res : work + (d%2)*wsize;
+         Contract(*M[d], in, na, nc, out);
+         in = out;
+         na *= nq1;
+         nc /= nd1;
+      }
+   }
+
+   // Copy the native element dofs u to the lexicographic order in work.
+   double *Lexicographic(const Vector &u, Vector &work) const
+   {
+      const int nd = u.Size();
+      work.SetSize(nd + 2*wsize);
+      double *ul = work.GetData() + 2*wsize;
+      for (int i = 0; i < nd; i++)
+      {
+         ul[i] = dof_map ? u(dof_map[i]) : u(i);
+      }
+      return ul;
+   }
+
+public:
+   TensorProductEvaluator()
+      : dim(0), nd1(0), nq1(0), wsize(0), dof_map(NULL), basis1d(NULL) { }
+
+   /** Return true if @a fe is a TensorBasisElement and the points of @a ir
+       form a tensor product of the same 1D points in every direction, ordered
+       as in the IntegrationRule tensor-product constructors. Otherwise return
+       false and leave the evaluator unusable. The 1D tabulation is reused when
+       the 1D basis and points are the same as in the previous call. */
+   bool Setup(const FiniteElement &fe, const IntegrationRule &ir)
+   {
+      const TensorBasisElement *tfe =
+         dynamic_cast<const TensorBasisElement *>(&fe);
+      if (!tfe) { return false; }
+      const int d = fe.GetDim(), nd = fe.GetOrder() + 1;
+      if (TensorBasisElement::Pow(nd, d) != fe.GetDof()) { return false; }
+
+      const int nq = ir.GetNPoints();
+      const int n = (int) floor(pow(double(nq), 1.0/d) + 0.5);
+      if (TensorBasisElement::Pow(n, d) != nq) { return false; }
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         if (ip.x != ir.IntPoint(q%n).x) { return false; }
+         if (d > 1 && ip.y != ir.IntPoint(((q/n)%n)*n).y) { return false; }
+         if (d > 2 && ip.z != ir.IntPoint((q/(n*n))*n*n).z) { return false; }
+      }
+      // the y and z points must be the x points: B and G are the same in all
+      // directions
+      for (int j = 0; j < n; j++)
+      {
+         const double x = ir.IntPoint(j).x;
+         if (d > 1 && ir.IntPoint(j*n).y != x) { return false; }
+         if (d > 2 && ir.IntPoint(j*n*n).z != x) { return false; }
+      }
+
+      dim = d;
+      nd1 = nd;
+      nq1 = n;
+      wsize = TensorBasisElement::Pow(std::max(nd1, nq1), dim);
+      dof_map = tfe->GetDofMap().Size() ? tfe->GetDofMap().GetData() : NULL;
+
+      const Poly_1D::Basis &basis = tfe->GetBasis1D();
+      bool same = (&basis == basis1d && x1d.Size() == nq1 &&
+                   B.Width() == nd1);
+      for (int q = 0; same && q < nq1; q++)
+      {
+         same = (x1d(q) == ir.IntPoint(q).x);
+      }
+      if (same) { return true; }
+
+      basis1d = &basis;
+      x1d.SetSize(nq1);
+      Vector u(nd1), du(nd1);
+      B.SetSize(nq1, nd1);
+      G.SetSize(nq1, nd1);
+      for (int q = 0; q < nq1; q++)
+      {
+         x1d(q) = ir.IntPoint(q).x;
+         basis.Eval(x1d(q), u, du);
+         for (int i = 0; i < nd1; i++)
+         {
+            B(q,i) = u(i);
+            G(q,i) = du(i);
+         }
+      }
+      return true;
+   }
+
+   /// Number of points of the integration rule given to Setup().
+   int GetNPoints() const { return TensorBasisElement::Pow(nq1, dim); }
+
+   /** Compute the values at the points from the native element dofs @a u.
+       The vector @a work is used as temporary storage. */
+   void Values(const Vector &u, Vector &vals, Vector &work) const
+   {
+      const double *ul = Lexicographic(u, work);
+      const DenseMatrix *M[3] = { &B, &B, &B };
+      vals.SetSize(GetNPoints());
+      Apply(M, ul, vals.GetData(), work.GetData());
+   }
+
+   /** Compute the reference gradients at the points, @a grad(d,q), from the
+       native element dofs @a u. The vector @a work is used as temporary
+       storage. */
+   void Gradients(const Vector &u, DenseMatrix &grad, Vector &work) const
+   {
+      const double *ul = Lexicographic(u, work);
+      const int nq = GetNPoints();
+      grad.SetSize(dim, nq);
+      Vector gd(nq);
+      for (int d = 0; d < dim; d++)
+      {
+         const DenseMatrix *M[3] = { &B, &B, &B };
+         M[d] = &G;
+         Apply(M, ul, gd.GetData(), work.GetData());
+         for (int q = 0; q < nq; q++) { grad(d,q) = gd(q); }
+      }
+   }
+};
+
+GridFunction::~GridFunction()
+{
+   delete tp_eval;
+   Destroy();
+}
+
+const TensorProductEvaluator *
+GridFunction::GetTensorEvaluator(const FiniteElement &fe,
+                                 const IntegrationRule &ir,
+                                 TensorProductEvaluator &local) const
+{
+#ifndef MFEM_THREAD_SAFE
+   if (!tp_eval) { tp_eval = new TensorProductEvaluator; }
+   TensorProductEvaluator &tpe = *tp_eval;
+#else
+   TensorProductEvaluator &tpe = local;
+#endif
+   return tpe.Setup(fe, ir) ? &tpe : NULL;
+}
+
 double GridFunction::GetValue(int i, const IntegrationPoint &ip, int vdim)
 const
 {
@@ -446,6 +693,14 @@ const
    int dof = FElem->GetDof();
    Vector DofVal(dof), loc_data(dof);
    GetSubVector(dofs, loc_data);
+   TensorProductEvaluator tpe_local;
+   const TensorProductEvaluator *tpe =
+      GetTensorEvaluator(*FElem, ir, tpe_local);
+   if (tpe)
+   {
+      tpe->Values(loc_data, vals, DofVal);
+      return;
+   }
    for (int k = 0; k < n; k++)
    {
       FElem->CalcShape(ir.IntPoint(k), DofVal);
@@ -532,6 +787,20 @@ void GridFunction::GetVectorValues(ElementTransformation &T,
       Vector shape(dof);
       int vdim = fes->GetVDim();
       vals.SetSize(vdim, nip);
+      TensorProductEvaluator tpe_local;
+      const TensorProductEvaluator *tpe =
+         GetTensorEvaluator(*FElem, ir, tpe_local);
+      if (tpe)
+      {
+         Vector comp_data, comp_vals;
+         for (int k = 0; k < vdim; k++)
+         {
+            comp_data.NewDataAndSize(loc_data.GetData() + dof * k, dof);
+            tpe->Values(comp_data, comp_vals, shape);
+            for (int j = 0; j < nip; j++) { vals(k,j) = comp_vals(j); }
+         }
+         return;
+      }
       for (int j = 0; j < nip; j++)
       {
          const IntegrationPoint &ip = ir.IntPoint(j);
@@ -1020,6 +1289,22 @@ void GridFunction::GetGradients(ElementTransformation &tr,
    fes->GetElementDofs(elNo, dofs);
    GetSubVector(dofs, lval);
    grad.SetSize(fe->GetDim(), ir.GetNPoints());
+   TensorProductEvaluator tpe_local;
+   const TensorProductEvaluator *tpe = GetTensorEvaluator(*fe, ir, tpe_local);
+   if (tpe)
+   {
+      DenseMatrix ref_grad;
+      Vector work;
+      tpe->Gradients(lval, ref_grad, work);
+      for (int i = 0; i < ir.GetNPoints(); i++)
+      {
+         tr.SetIntPoint(&ir.IntPoint(i));
+         ref_grad.GetColumnReference(i, gh);
+         grad.GetColumnReference(i, gcol);
+         tr.InverseJacobian().MultTranspose(gh, gcol);
+      }
+      return;
+   }
    for (int i = 0; i < ir.GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir.IntPoint(i);
@@ -1032,6 +1317,201 @@ void GridFunction::GetGradients(ElementTransformation &tr,
    }
 }
 
+// Element loops can run in parallel unless the space uses NURBS: the elements
+// of NURBS spaces share a FiniteElement object updated by GetFE().
+static bool ThreadedElementLoop(const FiniteElementSpace &fes)
+{
+   return (fes.GetMesh()->NURBSext == NULL);
+}
+
+// Set up the sum-factorized evaluators for the elements of fes and the rules
+// of qspace: element i uses tpe[tpe_idx[i]], or the generic evaluation when
+// tpe_idx[i] < 0. The evaluators in tpe are owned by the caller.
+static void SetupTensorEvaluators(const FiniteElementSpace &fes,
+                                  const QuadratureSpace &qspace,
+                                  Array<TensorProductEvaluator*> &tpe,
+                                  Array<int> &tpe_idx)
+{
+   Array<const FiniteElement*> fe_list;
+   tpe.SetSize(0);
+   tpe_idx.SetSize(fes.GetNE());
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      const FiniteElement *fe = fes.GetFE(i);
+      int k = fe_list.Find(fe);
+      if (k < 0)
+      {
+         k = fe_list.Append(fe) - 1;
+         TensorProductEvaluator *e = new TensorProductEvaluator;
+         if (!e->Setup(*fe, qspace.GetElementIntRule(i)))
+         {
+            delete e;
+            e = NULL;
+         }
+         tpe.Append(e);
+      }
+      tpe_idx[i] = tpe[k] ? k : -1;
+   }
+}
+
+void GridFunction::GetQuadratureValues(QuadratureFunction &qf) const
+{
+   const QuadratureSpace &qspace = *qf.GetSpace();
+   MFEM_VERIFY(qspace.GetMesh() == fes->GetMesh(), "incompatible meshes");
+   const int ne = fes->GetNE();
+   const int vdim = VectorDim();
+   qf.SetVDim(vdim);
+
+   Array<TensorProductEvaluator*> tpe;
+   Array<int> tpe_idx;
+   SetupTensorEvaluators(*fes, qspace, tpe, tpe_idx);
+
+   // Generic evaluation, which uses the shared element transformations
+   DenseMatrix vals;
+   Vector qvals;
+   for (int i = 0; i < ne; i++)
+   {
+      if (tpe_idx[i] >= 0) { continue; }
+      GetVectorValues(*fes->GetElementTransformation(i),
+                      qspace.GetElementIntRule(i), vals);
+      qf.GetElementValues(i, qvals);
+      qvals = vals.Data();
+   }
+
+   // Sum-factorized evaluation
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      Array<int> vdofs;
+      Vector loc_data, comp_data, comp_vals, work;
+      DenseMatrix el_vals;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < ne; i++)
+      {
+         if (tpe_idx[i] < 0) { continue; }
+         const TensorProductEvaluator &e = *tpe[tpe_idx[i]];
+         fes->GetElementVDofs(i, vdofs);
+         GetSubVector(vdofs, loc_data);
+         const int dof = loc_data.Size()/vdim;
+         qf.GetElementValues(i, el_vals);
+         for (int c = 0; c < vdim; c++)
+         {
+            comp_data.NewDataAndSize(loc_data.GetData() + dof*c, dof);
+            e.Values(comp_data, comp_vals, work);
+            for (int q = 0; q < comp_vals.Size(); q++)
+            {
+               el_vals(c,q) = comp_vals(q);
+            }
+         }
+      }
+   }
+
+   for (int k = 0; k < tpe.Size(); k++) { delete tpe[k]; }
+}
+
+void GridFunction::GetQuadratureGradients(QuadratureFunction &qf) const
+{
+   const QuadratureSpace &qspace = *qf.GetSpace();
+   Mesh *mesh = fes->GetMesh();
+   MFEM_VERIFY(qspace.GetMesh() == mesh, "incompatible meshes");
+   const int ne = fes->GetNE();
+   const int vdim = fes->GetVDim();
+   const int sdim = mesh->SpaceDimension();
+   qf.SetVDim(vdim*sdim);
+
+   Array<TensorProductEvaluator*> tpe;
+   Array<int> tpe_idx;
+   SetupTensorEvaluators(*fes, qspace, tpe, tpe_idx);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if(ThreadedElementLoop(*fes))
+#endif
+   {
+      IsoparametricTransformation T;
+      Array<int> vdofs;
+      Vector loc_data, comp_data, work, gh, gcol;
+      DenseMatrix dshape, ref_grad, comp_grad, el_grad, grad(sdim, vdim);
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < ne; i++)
+      {
+         const FiniteElement *fe = fes->GetFE(i);
+         MFEM_ASSERT(fe->GetRangeType() == FiniteElement::SCALAR &&
+                     fe->GetMapType() == FiniteElement::VALUE,
+                     "invalid FE type");
+         const IntegrationRule &ir = qspace.GetElementIntRule(i);
+         const int nq = ir.GetNPoints(), dof = fe->GetDof();
+         const int dim = fe->GetDim();
+
+         fes->GetElementVDofs(i, vdofs);
+         GetSubVector(vdofs, loc_data);
+
+         // Reference gradients: column q + nq*c of ref_grad is the gradient
+         // of component c at point q.
+         ref_grad.SetSize(dim, nq*vdim);
+         if (tpe_idx[i] >= 0)
+         {
+            for (int c = 0; c < vdim; c++)
+            {
+               comp_data.NewDataAndSize(loc_data.GetData() + dof*c, dof);
+               tpe[tpe_idx[i]]->Gradients(comp_data, comp_grad, work);
+               for (int q = 0; q < nq; q++)
+               {
+                  for (int d = 0; d < dim; d++)
+                  {
+                     ref_grad(d,q+nq*c) = comp_grad(d,q);
+                  }
+               }
+            }
+         }
+         else
+         {
+            dshape.SetSize(dof, dim);
+            for (int q = 0; q < nq; q++)
+            {
+               fe->CalcDShape(ir.IntPoint(q), dshape);
+               for (int c = 0; c < vdim; c++)
+               {
+                  comp_data.NewDataAndSize(loc_data.GetData() + dof*c, dof);
+                  ref_grad.GetColumnReference(q+nq*c, gh);
+                  dshape.MultTranspose(comp_data, gh);
+               }
+            }
+         }
+
+         fes->GetElementTransformation(i, &T);
+         qf.GetElementValues(i, el_grad);
+         for (int q = 0; q < nq; q++)
+         {
+            T.SetIntPoint(&ir.IntPoint(q));
+            const DenseMatrix &Jinv = T.InverseJacobian();
+            for (int c = 0; c < vdim; c++)
+            {
+               ref_grad.GetColumnReference(q+nq*c, gh);
+               grad.GetColumnReference(c, gcol);
+               Jinv.MultTranspose(gh, gcol);
+            }
+            // el_grad(c + vdim*d, q) = grad(d, c)
+            for (int d = 0; d < sdim; d++)
+            {
+               for (int c = 0; c < vdim; c++)
+               {
+                  el_grad(c+vdim*d,q) = grad(d,c);
+               }
+            }
+         }
+      }
+   }
+
+   for (int k = 0; k < tpe.Size(); k++) { delete tpe[k]; }
+}
+
 void GridFunction::GetVectorGradient(
    ElementTransformation &tr, DenseMatrix &grad) const
 {
@@ -1877,56 +2357,70 @@ void GridFunction::ProjectBdrCoefficientTangent(
 #endif
 }
 
+// Return the integration rule used by the error norms for the element fe.
+static const IntegrationRule *ErrorIntRule(const FiniteElement &fe,
+                                           const IntegrationRule *irs[],
+                                           int intorder)
+{
+   if (irs)
+   {
+      return irs[fe.GetGeomType()];
+   }
+   return &(IntRules.Get(fe.GetGeomType(), intorder));
+}
+
+// Sum the element contributions in element order, so that the result does not
+// depend on the number of threads used to compute them.
+static double SumElementContributions(const Vector &elem_err)
+{
+   double error = 0.0;
+   for (int i = 0; i < elem_err.Size(); i++)
+   {
+      error += elem_err(i);
+   }
+   return error;
+}
+
 double GridFunction::ComputeL2Error(
    Coefficient *exsol[], const IntegrationRule *irs[]) const
 {
-   double error = 0.0, a;
-   const FiniteElement *fe;
-   ElementTransformation *transf;
-   Vector shape;
-   Array<int> vdofs;
-   int fdof, d, i, intorder, j, k;
+   const int ne = fes->GetNE();
+   Vector elem_err(ne);
 
-   for (i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if(ThreadedElementLoop(*fes))
+#endif
    {
-      fe = fes->GetFE(i);
-      fdof = fe->GetDof();
-      transf = fes->GetElementTransformation(i);
-      shape.SetSize(fdof);
-      intorder = 2*fe->GetOrder() + 1; // <----------
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      fes->GetElementVDofs(i, vdofs);
-      for (j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         fe->CalcShape(ip, shape);
-         for (d = 0; d < fes->GetVDim(); d++)
+      IsoparametricTransformation T;
+      Vector vals, exact_vals;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < ne; i++)
+      {
+         const FiniteElement *fe = fes->GetFE(i);
+         const IntegrationRule *ir =
+            ErrorIntRule(*fe, irs, 2*fe->GetOrder() + 1); // <----------
+         fes->GetElementTransformation(i, &T);
+         double error = 0.0;
+         for (int d = 0; d < fes->GetVDim(); d++)
          {
-            a = 0;
-            for (k = 0; k < fdof; k++)
-               if (vdofs[fdof*d+k] >= 0)
-               {
-                  a += (*this)(vdofs[fdof*d+k]) * shape(k);
-               }
-               else
-               {
-                  a -= (*this)(-1-vdofs[fdof*d+k]) * shape(k);
-               }
-            transf->SetIntPoint(&ip);
-            a -= exsol[d]->Eval(*transf, ip);
-            error += ip.weight * transf->Weight() * a * a;
+            GetValues(i, *ir, vals, d+1);
+            exsol[d]->Eval(exact_vals, T, *ir);
+            for (int j = 0; j < ir->GetNPoints(); j++)
+            {
+               const IntegrationPoint &ip = ir->IntPoint(j);
+               T.SetIntPoint(&ip);
+               const double a = vals(j) - exact_vals(j);
+               error += ip.weight * T.Weight() * a * a;
+            }
          }
+         elem_err(i) = error;
       }
    }
 
+   const double error = SumElementContributions(elem_err);
    if (error < 0.0)
    {
       return -sqrt(-error);
@@ -1938,40 +2432,11 @@ double GridFunction::ComputeL2Error(
    VectorCoefficient &exsol, const IntegrationRule *irs[],
    Array<int> *elems) const
 {
-   double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   DenseMatrix vals, exact_vals;
-   Vector loc_errs;
-
-   for (int i = 0; i < fes->GetNE(); i++)
-   {
-      if (elems != NULL && (*elems)[i] == 0) { continue; }
-      fe = fes->GetFE(i);
-      int intorder = 2*fe->GetOrder() + 1; // <----------
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      T = fes->GetElementTransformation(i);
-      GetVectorValues(*T, *ir, vals);
-      exsol.Eval(exact_vals, *T, *ir);
-      vals -= exact_vals;
-      loc_errs.SetSize(vals.Width());
-      vals.Norm2(loc_errs);
-      for (int j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         error += ip.weight * T->Weight() * (loc_errs(j) * loc_errs(j));
-      }
-   }
+   Vector elem_err;
+   ComputeElementLpContributions(2.0, exsol, NULL, NULL, irs, elems,
+                                 elem_err);
 
+   const double error = SumElementContributions(elem_err);
    if (error < 0.0)
    {
       return -sqrt(-error);
@@ -1989,54 +2454,55 @@ double GridFunction::ComputeH1Error(
    const FiniteElement *fe;
    ElementTransformation *transf;
    FaceElementTransformations *face_elem_transf;
-   Vector e_grad, a_grad, shape, el_dofs, err_val, ell_coeff_val;
-   DenseMatrix dshape, dshapet, Jinv;
+   Vector shape, el_dofs, err_val, ell_coeff_val;
    Array<int> vdofs;
    IntegrationPoint eip;
    double error = 0.0;
 
    mesh = fes->GetMesh();
    dim = mesh->Dimension();
-   e_grad.SetSize(dim);
-   a_grad.SetSize(dim);
-   Jinv.SetSize(dim);
 
    if (norm_type & 1)
-      for (i = 0; i < mesh->GetNE(); i++)
+   {
+      const int ne = mesh->GetNE();
+      Vector elem_err(ne);
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel if(ThreadedElementLoop(*fes))
+#endif
       {
-         fe = fes->GetFE(i);
-         fdof = fe->GetDof();
-         transf = mesh->GetElementTransformation(i);
-         el_dofs.SetSize(fdof);
-         dshape.SetSize(fdof, dim);
-         dshapet.SetSize(fdof, dim);
-         intorder = 2 * fe->GetOrder(); // <----------
-         const IntegrationRule &ir = IntRules.Get(fe->GetGeomType(), intorder);
-         fes->GetElementVDofs(i, vdofs);
-         for (k = 0; k < fdof; k++)
-            if (vdofs[k] >= 0)
-            {
-               el_dofs(k) =   (*this)(vdofs[k]);
-            }
-            else
+         IsoparametricTransformation T;
+         DenseMatrix grad, exact_grad;
+         Vector ell_vals, e_col;
+
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(static)
+#endif
+         for (int e = 0; e < ne; e++)
+         {
+            const FiniteElement *el_fe = fes->GetFE(e);
+            const int order = 2 * el_fe->GetOrder(); // <----------
+            const IntegrationRule &ir =
+               IntRules.Get(el_fe->GetGeomType(), order);
+            fes->GetElementTransformation(e, &T);
+            GetGradients(T, ir, grad);
+            exgrad->Eval(exact_grad, T, ir);
+            ell_coeff->Eval(ell_vals, T, ir);
+            exact_grad -= grad;
+            double el_error = 0.0;
+            for (int q = 0; q < ir.GetNPoints(); q++)
             {
-               el_dofs(k) = - (*this)(-1-vdofs[k]);
+               const IntegrationPoint &ip = ir.IntPoint(q);
+               T.SetIntPoint(&ip);
+               exact_grad.GetColumnReference(q, e_col);
+               el_error += (ip.weight * T.Weight() * ell_vals(q) *
+                            (e_col * e_col));
             }
-         for (j = 0; j < ir.GetNPoints(); j++)
-         {
-            const IntegrationPoint &ip = ir.IntPoint(j);
-            fe->CalcDShape(ip, dshape);
-            transf->SetIntPoint(&ip);
-            exgrad->Eval(e_grad, *transf, ip);
-            CalcInverse(transf->Jacobian(), Jinv);
-            Mult(dshape, Jinv, dshapet);
-            dshapet.MultTranspose(el_dofs, a_grad);
-            e_grad -= a_grad;
-            error += (ip.weight * transf->Weight() *
-                      ell_coeff->Eval(*transf, ip) *
-                      (e_grad * e_grad));
+            elem_err(e) = el_error;
          }
       }
+      error += SumElementContributions(elem_err);
+   }
 
    if (norm_type & 2)
       for (i = 0; i < mesh->GetNFaces(); i++)
@@ -2290,223 +2756,195 @@ double GridFunction::ComputeW11Error(
    return error;
 }
 
-double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
-                                    Coefficient *weight,
-                                    const IntegrationRule *irs[]) const
+// Apply the power 1/p to the Lp error contribution err; negative quadrature
+// weights may cause it to be negative.
+static double LpRoot(const double p, double err)
 {
-   double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   Vector vals;
-
-   for (int i = 0; i < fes->GetNE(); i++)
+   if (p < infinity())
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      GetValues(i, *ir, vals);
-      T = fes->GetElementTransformation(i);
-      for (int j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = fabs(vals(j) - exsol.Eval(*T, ip));
-         if (p < infinity())
-         {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error += ip.weight * T->Weight() * err;
-         }
-         else
-         {
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error = std::max(error, err);
-         }
-      }
+      return (err < 0.) ? -pow(-err, 1./p) : pow(err, 1./p);
    }
+   return err;
+}
 
-   if (p < infinity())
+// Accumulate the pointwise errors loc_errs of one element into its Lp error
+// contribution; weights is the optional scalar weight at the points.
+static double AccumulateLpError(const double p, const Vector &loc_errs,
+                                const Vector *weights,
+                                ElementTransformation &T,
+                                const IntegrationRule &ir)
+{
+   double error = 0.0;
+   for (int j = 0; j < ir.GetNPoints(); j++)
    {
-      // negative quadrature weights may cause the error to be negative
-      if (error < 0.)
+      double err = loc_errs(j);
+      if (p < infinity())
       {
-         error = -pow(-error, 1./p);
+         const IntegrationPoint &ip = ir.IntPoint(j);
+         T.SetIntPoint(&ip);
+         err = pow(err, p);
+         if (weights)
+         {
+            err *= (*weights)(j);
+         }
+         error += ip.weight * T.Weight() * err;
       }
       else
       {
-         error = pow(error, 1./p);
+         if (weights)
+         {
+            err *= (*weights)(j);
+         }
+         error = std::max(error, err);
       }
    }
-
    return error;
 }
 
-void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
-                                          GridFunction &error,
-                                          Coefficient *weight,
-                                          const IntegrationRule *irs[]) const
+void GridFunction::ComputeElementLpContributions(
+   const double p, Coefficient &exsol, Coefficient *weight,
+   const IntegrationRule *irs[], Vector &elem_err) const
 {
-   error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   Vector vals;
+   const int ne = fes->GetNE();
+   elem_err.SetSize(ne);
 
-   for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if(ThreadedElementLoop(*fes))
+#endif
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      GetValues(i, *ir, vals);
-      T = fes->GetElementTransformation(i);
-      for (int j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = fabs(vals(j) - exsol.Eval(*T, ip));
-         if (p < infinity())
-         {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error[i] += ip.weight * T->Weight() * err;
-         }
-         else
-         {
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error[i] = std::max(error[i], err);
-         }
-      }
-      if (p < infinity())
-      {
-         // negative quadrature weights may cause the error to be negative
-         if (error[i] < 0.)
+      IsoparametricTransformation T;
+      Vector vals, exact_vals, weights;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < ne; i++)
+      {
+         const FiniteElement *fe = fes->GetFE(i);
+         const IntegrationRule *ir =
+            ErrorIntRule(*fe, irs, 2*fe->GetOrder() + 1); // <----------
+         GetValues(i, *ir, vals);
+         fes->GetElementTransformation(i, &T);
+         exsol.Eval(exact_vals, T, *ir);
+         if (weight)
          {
-            error[i] = -pow(-error[i], 1./p);
+            weight->Eval(weights, T, *ir);
          }
-         else
+         for (int j = 0; j < vals.Size(); j++)
          {
-            error[i] = pow(error[i], 1./p);
+            vals(j) = fabs(vals(j) - exact_vals(j));
          }
+         elem_err(i) = AccumulateLpError(p, vals, weight ? &weights : NULL,
+                                         T, *ir);
       }
    }
 }
 
-double GridFunction::ComputeLpError(const double p, VectorCoefficient &exsol,
-                                    Coefficient *weight,
-                                    VectorCoefficient *v_weight,
-                                    const IntegrationRule *irs[]) const
+void GridFunction::ComputeElementLpContributions(
+   const double p, VectorCoefficient &exsol, Coefficient *weight,
+   VectorCoefficient *v_weight, const IntegrationRule *irs[],
+   const Array<int> *elems, Vector &elem_err) const
 {
-   double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   DenseMatrix vals, exact_vals;
-   Vector loc_errs;
+   const int ne = fes->GetNE();
+   elem_err.SetSize(ne);
 
-   for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if(ThreadedElementLoop(*fes))
+#endif
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      T = fes->GetElementTransformation(i);
-      GetVectorValues(*T, *ir, vals);
-      exsol.Eval(exact_vals, *T, *ir);
-      vals -= exact_vals;
-      loc_errs.SetSize(vals.Width());
-      if (!v_weight)
-      {
-         // compute the lengths of the errors at the integration points
-         // thus the vector norm is rotationally invariant
-         vals.Norm2(loc_errs);
-      }
-      else
+      IsoparametricTransformation T;
+      DenseMatrix vals, exact_vals;
+      Vector loc_errs, weights;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < ne; i++)
       {
-         v_weight->Eval(exact_vals, *T, *ir);
-         // column-wise dot product of the vector error (in vals) and the
-         // vector weight (in exact_vals)
-         for (int j = 0; j < vals.Width(); j++)
+         if (elems != NULL && (*elems)[i] == 0)
          {
-            double err = 0.0;
-            for (int d = 0; d < vals.Height(); d++)
-            {
-               err += vals(d,j)*exact_vals(d,j);
-            }
-            loc_errs(j) = fabs(err);
+            elem_err(i) = 0.0;
+            continue;
          }
-      }
-      for (int j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = loc_errs(j);
-         if (p < infinity())
+         const FiniteElement *fe = fes->GetFE(i);
+         const IntegrationRule *ir =
+            ErrorIntRule(*fe, irs, 2*fe->GetOrder() + 1); // <----------
+         fes->GetElementTransformation(i, &T);
+         GetVectorValues(T, *ir, vals);
+         exsol.Eval(exact_vals, T, *ir);
+         vals -= exact_vals;
+         loc_errs.SetSize(vals.Width());
+         if (!v_weight)
          {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error += ip.weight * T->Weight() * err;
+            // compute the lengths of the errors at the integration points
+            // thus the vector norm is rotationally invariant
+            vals.Norm2(loc_errs);
          }
          else
          {
-            if (weight)
+            v_weight->Eval(exact_vals, T, *ir);
+            // column-wise dot product of the vector error (in vals) and the
+            // vector weight (in exact_vals)
+            for (int j = 0; j < vals.Width(); j++)
             {
-               err *= weight->Eval(*T, ip);
+               double err = 0.0;
+               for (int d = 0; d < vals.Height(); d++)
+               {
+                  err += vals(d,j)*exact_vals(d,j);
+               }
+               loc_errs(j) = fabs(err);
             }
-            error = std::max(error, err);
          }
+         if (weight)
+         {
+            weight->Eval(weights, T, *ir);
+         }
+         elem_err(i) = AccumulateLpError(p, loc_errs,
+                                         weight ? &weights : NULL, T, *ir);
       }
    }
+}
 
+double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
+                                    Coefficient *weight,
+                                    const IntegrationRule *irs[]) const
+{
+   Vector elem_err;
+   ComputeElementLpContributions(p, exsol, weight, irs, elem_err);
    if (p < infinity())
    {
-      // negative quadrature weights may cause the error to be negative
-      if (error < 0.)
-      {
-         error = -pow(-error, 1./p);
-      }
-      else
-      {
-         error = pow(error, 1./p);
-      }
+      return LpRoot(p, SumElementContributions(elem_err));
    }
+   return elem_err.Size() ? elem_err.Max() : 0.0;
+}
 
-   return error;
+void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
+                                          GridFunction &error,
+                                          Coefficient *weight,
+                                          const IntegrationRule *irs[]) const
+{
+   Vector elem_err;
+   ComputeElementLpContributions(p, exsol, weight, irs, elem_err);
+   error = 0.0;
+   for (int i = 0; i < elem_err.Size(); i++)
+   {
+      error[i] = LpRoot(p, elem_err(i));
+   }
+}
+
+double GridFunction::ComputeLpError(const double p, VectorCoefficient &exsol,
+                                    Coefficient *weight,
+                                    VectorCoefficient *v_weight,
+                                    const IntegrationRule *irs[]) const
+{
+   Vector elem_err;
+   ComputeElementLpContributions(p, exsol, weight, v_weight, irs, NULL,
+                                 elem_err);
+   if (p < infinity())
+   {
+      return LpRoot(p, SumElementContributions(elem_err));
+   }
+   return elem_err.Size() ? elem_err.Max() : 0.0;
 }
 
 void GridFunction::ComputeElementLpErrors(const double p,
@@ -2516,86 +2954,13 @@ void GridFunction::ComputeElementLpErrors(const double p,
                                           VectorCoefficient *v_weight,
                                           const IntegrationRule *irs[]) const
 {
+   Vector elem_err;
+   ComputeElementLpContributions(p, exsol, weight, v_weight, irs, NULL,
+                                 elem_err);
    error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   DenseMatrix vals, exact_vals;
-   Vector loc_errs;
-
-   for (int i = 0; i < fes->GetNE(); i++)
+   for (int i = 0; i < elem_err.Size(); i++)
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      T = fes->GetElementTransformation(i);
-      GetVectorValues(*T, *ir, vals);
-      exsol.Eval(exact_vals, *T, *ir);
-      vals -= exact_vals;
-      loc_errs.SetSize(vals.Width());
-      if (!v_weight)
-      {
-         // compute the lengths of the errors at the integration points
-         // thus the vector norm is rotationally invariant
-         vals.Norm2(loc_errs);
-      }
-      else
-      {
-         v_weight->Eval(exact_vals, *T, *ir);
-         // column-wise dot product of the vector error (in vals) and the
-         // vector weight (in exact_vals)
-         for (int j = 0; j < vals.Width(); j++)
-         {
-            double err = 0.0;
-            for (int d = 0; d < vals.Height(); d++)
-            {
-               err += vals(d,j)*exact_vals(d,j);
-            }
-            loc_errs(j) = fabs(err);
-         }
-      }
-      for (int j = 0; j < ir->GetNPoints(); j++)
-      {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = loc_errs(j);
-         if (p < infinity())
-         {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error[i] += ip.weight * T->Weight() * err;
-         }
-         else
-         {
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error[i] = std::max(error[i], err);
-         }
-      }
-      if (p < infinity())
-      {
-         // negative quadrature weights may cause the error to be negative
-         if (error[i] < 0.)
-         {
-            error[i] = -pow(-error[i], 1./p);
-         }
-         else
-         {
-            error[i] = pow(error[i], 1./p);
-         }
-      }
+      error[i] = LpRoot(p, elem_err(i));
    }
 }
 
@@ -2626,17 +2991,45 @@ void GridFunction::Save(std::ostream &out) const
       return;
    }
 #endif
+   // Write the data in the canonical DOF numbering, see
+   // FiniteElementSpace::ReorderDofs()
+   const Vector *data = this;
+   Vector canonical_data;
+   if (fes->GetDofReorderingMap().Size())
+   {
+      GridFunction::GetSaveData(canonical_data);
+      data = &canonical_data;
+   }
    if (fes->GetOrdering() == Ordering::byNODES)
    {
-      Vector::Print(out, 1);
+      data->Print(out, 1);
    }
    else
    {
-      Vector::Print(out, fes->GetVDim());
+      data->Print(out, fes->GetVDim());
    }
    out.flush();
 }
 
+void GridFunction::GetSaveData(Vector &sdata) const
+{
+   const Array<int> &dof_map = fes->GetDofReorderingMap();
+   if (!dof_map.Size())
+   {
+      sdata = *this;
+      return;
+   }
+   sdata.SetSize(Size());
+   for (int vd = 0; vd < fes->GetVDim(); vd++)
+   {
+      for (int dof = 0; dof < fes->GetNDofs(); dof++)
+      {
+         sdata(fes->DofToVDof(dof, vd)) =
+            (*this)(fes->DofToVDof(dof_map[dof], vd));
+      }
+   }
+}
+
 void GridFunction::SaveVTK(std::ostream &out, const std::string &field_name,
                            int ref)
 {
@@ -2892,7 +3285,7 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
    const int with_coeff = 0;
    FiniteElementSpace *ufes = u.FESpace();
    FiniteElementSpace *ffes = flux.FESpace();
-   ElementTransformation *Transf;
+   IsoparametricTransformation Transf;
 
    int dim = ufes->GetMesh()->Dimension();
    int nfe = ufes->GetNE();
@@ -2905,7 +3298,6 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
    if (aniso_flags)
    {
       aniso_flags->SetSize(nfe);
-      d_xyz.SetSize(dim);
    }
 
    int nsd = 1;
@@ -2920,6 +3312,10 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
       // This calls the parallel version when u is a ParGridFunction
       u.ComputeFlux(blfi, flux, with_coeff, (with_subdomains ? s : -1));
 
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static) reduction(+:total_error) \
+      private(Transf,udofs,fdofs,ul,fl,fla,d_xyz)
+#endif
       for (int i = 0; i < nfe; i++)
       {
          if (with_subdomains && ufes->GetAttribute(i) != s) { continue; }
@@ -2930,13 +3326,14 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
          u.GetSubVector(udofs, ul);
          flux.GetSubVector(fdofs, fla);
 
-         Transf = ufes->GetElementTransformation(i);
-         blfi.ComputeElementFlux(*ufes->GetFE(i), *Transf, ul,
+         ufes->GetElementTransformation(i, &Transf);
+         blfi.ComputeElementFlux(*ufes->GetFE(i), Transf, ul,
                                  *ffes->GetFE(i), fl, with_coeff);
 
          fl -= fla;
 
-         double err = blfi.ComputeFluxEnergy(*ffes->GetFE(i), *Transf, fl,
+         if (aniso_flags) { d_xyz.SetSize(dim); }
+         double err = blfi.ComputeFluxEnergy(*ffes->GetFE(i), Transf, fl,
                                              (aniso_flags ? &d_xyz : NULL));
 
          error_estimates(i) = std::sqrt(err);
@@ -23,6 +23,9 @@
 namespace mfem
 {
 
+class QuadratureFunction;
+class TensorProductEvaluator;
+
 /// Class for grid function - Vector with associated FE space.
 class GridFunction : public Vector
 {
@@ -43,6 +46,18 @@ protected:
        associated true-dof values - either owned or external. */
    Vector t_vec;
 
+   /** Sum-factorization evaluator reused by GetValues(), GetVectorValues() and
+       GetGradients() while the element type and the integration points do not
+       change. Not used with MFEM_THREAD_SAFE. */
+   mutable TensorProductEvaluator *tp_eval;
+
+   /** Return an evaluator of @a fe at the points of @a ir, set up in
+       #tp_eval or, with MFEM_THREAD_SAFE, in @a local; return NULL if @a fe
+       and @a ir do not have a tensor-product structure. */
+   const TensorProductEvaluator *
+   GetTensorEvaluator(const FiniteElement &fe, const IntegrationRule &ir,
+                      TensorProductEvaluator &local) const;
+
    void SaveSTLTri(std::ostream &out, double p1[], double p2[], double p3[]);
 
    void GetVectorGradientHat(ElementTransformation &T, DenseMatrix &gh) const;
@@ -59,6 +74,24 @@ protected:
                         int wcoef,
                         int subdomain);
 
+   // Compute in elem_err(i) the contribution of element i to the Lp error:
+   // the integral of the p-th power of the (weighted) pointwise error, or its
+   // maximum for p = infinity. Elements with (*elems)[i] == 0 are skipped.
+   // With MFEM_USE_OPENMP the elements are processed in parallel, so the
+   // coefficients must be thread-safe.
+   void ComputeElementLpContributions(const double p, Coefficient &exsol,
+                                      Coefficient *weight,
+                                      const IntegrationRule *irs[],
+                                      Vector &elem_err) const;
+
+   void ComputeElementLpContributions(const double p,
+                                      VectorCoefficient &exsol,
+                                      Coefficient *weight,
+                                      VectorCoefficient *v_weight,
+                                      const IntegrationRule *irs[],
+                                      const Array<int> *elems,
+                                      Vector &elem_err) const;
+
    /** Project a discontinuous vector coefficient in a continuous space and
        return in dof_attr the maximal attribute of the elements containing each
        degree of freedom. */
@@ -68,15 +101,16 @@ protected:
 
 public:
 
-   GridFunction() { fes = NULL; fec = NULL; sequence = 0; }
+   GridFunction() { fes = NULL; fec = NULL; sequence = 0; tp_eval = NULL; }
 
    /// Copy constructor. The internal true-dof vector #t_vec is not copied.
    GridFunction(const GridFunction &orig)
-      : Vector(orig), fes(orig.fes), fec(NULL), sequence(orig.sequence) { }
+      : Vector(orig), fes(orig.fes), fec(NULL), sequence(orig.sequence),
+        tp_eval(NULL) { }
 
    /// Construct a GridFunction associated with the FiniteElementSpace @a *f.
    GridFunction(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; fec = NULL; sequence = f->GetSequence(); }
+   { fes = f; fec = NULL; sequence = f->GetSequence(); tp_eval = NULL; }
 
    /// Construct a GridFunction using previously allocated array @a data.
    /** The GridFunction does not assume ownership of @a data which is assumed to
@@ -85,7 +119,7 @@ public:
        array can be replaced later using the method SetData().
     */
    GridFunction(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; fec = NULL; sequence = f->GetSequence(); }
+   { fes = f; fec = NULL; sequence = f->GetSequence(); tp_eval = NULL; }
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
    /** The content of @a input should be in the format created by the method
@@ -192,6 +226,24 @@ public:
                      DenseMatrix &grad) const
    { GetGradients(*fes->GetElementTransformation(elem), ir, grad); }
 
+   /** @brief Evaluate the GridFunction at all points of the QuadratureSpace of
+       @a qf, setting the vector dimension of @a qf to VectorDim(). */
+   /** Elements derived from TensorBasisElement are evaluated by sum
+       factorization when their integration rule has tensor-product structure,
+       as the rules in #IntRules do for segments, squares and cubes. With
+       MFEM_USE_OPENMP, these elements are evaluated in parallel. */
+   void GetQuadratureValues(QuadratureFunction &qf) const;
+
+   /** @brief Evaluate the physical gradient of the GridFunction at all points
+       of the QuadratureSpace of @a qf. */
+   /** The space must use scalar finite elements with FiniteElement::VALUE map
+       type. The vector dimension of @a qf is set to vdim*sdim, where vdim is
+       the vector dimension of the space and sdim is the space dimension of the
+       mesh; at every point, the derivative d/dx_d of component c is stored at
+       index c + vdim*d. See GetQuadratureValues() for the evaluation
+       strategy. */
+   void GetQuadratureGradients(QuadratureFunction &qf) const;
+
    void GetVectorGradient(ElementTransformation &tr, DenseMatrix &grad) const;
 
    /** Compute \f$ (\int_{\Omega} (*this) \psi_i)/(\int_{\Omega} \psi_i) \f$,
@@ -298,6 +350,12 @@ public:
    virtual void ProjectBdrCoefficientTangent(VectorCoefficient &vcoeff,
                                              Array<int> &bdr_attr);
 
+   /** @name Error norms
+       With MFEM_USE_OPENMP, the element contributions to the L2, Lp and H1
+       errors below are computed in parallel, so the given coefficients must be
+       thread-safe. The contributions are summed in element order, so the
+       results do not depend on the number of threads. */
+   ///@{
    virtual double ComputeL2Error(Coefficient &exsol,
                                  const IntegrationRule *irs[] = NULL) const
    { return ComputeLpError(2.0, exsol, NULL, irs); }
@@ -406,6 +464,7 @@ public:
                                         const IntegrationRule *irs[] = NULL
                                        ) const
    { ComputeElementLpErrors(infinity(), exsol, error, NULL, NULL, irs); }
+   ///@}
 
    virtual void ComputeFlux(BilinearFormIntegrator &blfi,
                             GridFunction &flux,
@@ -467,6 +526,10 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Copy the values written by Save(), i.e. the data in the canonical
+       DOF numbering, see FiniteElementSpace::ReorderDofs(), to @a sdata. */
+   virtual void GetSaveData(Vector &sdata) const;
+
    /** Write the GridFunction in VTK format. Note that Mesh::PrintVTK must be
        called first. The parameter ref > 0 must match the one used in
        Mesh::PrintVTK. */
@@ -475,7 +538,7 @@ public:
    void SaveSTL(std::ostream &out, int TimesToRefine = 1);
 
    /// Destroys grid function.
-   virtual ~GridFunction() { Destroy(); }
+   virtual ~GridFunction();
 };
 
 
@@ -652,6 +715,7 @@ private:
 public:
    ExtrudeCoefficient(Mesh *m, Coefficient &s, int _n)
       : n(_n), mesh_in(m), sol_in(s) { }
+   using Coefficient::Eval;
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
    virtual ~ExtrudeCoefficient() { }
 };
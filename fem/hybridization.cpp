@@ -30,7 +30,7 @@ namespace mfem
 Hybridization::Hybridization(FiniteElementSpace *fespace,
                              FiniteElementSpace *c_fespace)
    : fes(fespace), c_fes(c_fespace), c_bfi(NULL), Ct(NULL), H(NULL),
-     Af_data(NULL), Af_ipiv(NULL)
+     Af_data(NULL), Af_ipiv(NULL), Af_data_sp(NULL), sp_factors(false)
 {
 #ifdef MFEM_USE_MPI
    pC = P_pc = NULL;
@@ -45,6 +45,7 @@ Hybridization::~Hybridization()
    delete pC;
 #endif
    delete [] Af_ipiv;
+   delete [] Af_data_sp;
    delete [] Af_data;
    delete H;
    delete Ct;
@@ -298,6 +299,9 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
       cP->BooleanMult(free_tdof_marker, free_vdofs_marker);
    }
 #endif
+   hat_dofs_first.SetSize(num_hat_dofs);
+   Array<bool> vdof_marker(fes->GetVSize());
+   vdof_marker = false;
    for (int i = 0; i < NE; i++)
    {
       fes->GetElementVDofs(i, vdofs);
@@ -305,8 +309,11 @@ void Hybridization::Init(const Array<int> &ess_tdof_list)
       for (int j = 0; j < vdofs.Size(); j++)
       {
          hat_dofs_marker[hat_offsets[i]+j] = ! free_vdofs_marker[vdofs[j]];
+         hat_dofs_first[hat_offsets[i]+j] = ! vdof_marker[vdofs[j]];
+         vdof_marker[vdofs[j]] = true;
       }
    }
+   vdof_marker.DeleteAll();
 #ifndef MFEM_DEBUG
    // In DEBUG mode this array is used below.
    free_tdof_marker.DeleteAll();
@@ -438,10 +445,20 @@ void Hybridization::GetBDofs(int el, int &num_idofs, Array<int> &b_dofs) const
    }
 }
 
+void Hybridization::AllocAfData()
+{
+   if (Af_data) { return; }
+   Af_data = new double[Af_offsets.Last()];
+   delete [] Af_data_sp;
+   Af_data_sp = NULL;
+}
+
 void Hybridization::AssembleMatrix(int el, const DenseMatrix &A)
 {
    Array<int> i_dofs, b_dofs;
 
+   AllocAfData();
+
    GetIBDofs(el, i_dofs, b_dofs);
 
    DenseMatrix A_ii(Af_data + Af_offsets[el], i_dofs.Size(), i_dofs.Size());
@@ -566,6 +583,28 @@ void Hybridization::AssembleBdrMatrix(int bdr_el, const DenseMatrix &A)
    }
 }
 
+void Hybridization::FactorElementMatrix(int el)
+{
+   const int f_size = Af_f_offsets[el+1] - Af_f_offsets[el];
+   int i_dofs_size = 0;
+   for (int j = hat_offsets[el]; j < hat_offsets[el+1]; j++)
+   {
+      if (hat_dofs_marker[j] == 0) { i_dofs_size++; }
+   }
+   const int b_dofs_size = f_size - i_dofs_size;
+
+   LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
+   double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
+   double *A_bi_data = A_ib_data + i_dofs_size*b_dofs_size;
+   LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs_size,
+                   LU_ii.ipiv + i_dofs_size);
+
+   LU_ii.Factor(i_dofs_size);
+   LU_ii.BlockFactor(i_dofs_size, b_dofs_size,
+                     A_ib_data, A_bi_data, LU_bb.data);
+   LU_bb.Factor(b_dofs_size);
+}
+
 void Hybridization::ComputeH()
 {
    const int skip_zeros = 1;
@@ -581,6 +620,15 @@ void Hybridization::ComputeH()
    SparseMatrix *V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
 #endif
 
+   // The local factorizations are independent
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int el = 0; el < NE; el++)
+   {
+      FactorElementMatrix(el);
+   }
+
    c_dof_marker = -1;
    int c_mark_start = 0;
    for (int el = 0; el < NE; el++)
@@ -588,16 +636,9 @@ void Hybridization::ComputeH()
       int i_dofs_size;
       GetBDofs(el, i_dofs_size, b_dofs);
 
-      LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
-      double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
-      double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
-      LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
-                      LU_ii.ipiv + i_dofs_size);
-
-      LU_ii.Factor(i_dofs_size);
-      LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
-                        A_ib_data, A_bi_data, LU_bb.data);
-      LU_bb.Factor(b_dofs.Size());
+      const int A_bb_offset = i_dofs_size*(i_dofs_size + 2*b_dofs.Size());
+      LUFactors LU_bb(Af_data + Af_offsets[el] + A_bb_offset,
+                      Af_ipiv + Af_f_offsets[el] + i_dofs_size);
 
       // Extract Cb_t from Ct, define c_dofs
       c_dofs.SetSize(0);
@@ -720,6 +761,18 @@ void Hybridization::Finalize()
 #else
    if (!H && !pH.Ptr()) { ComputeH(); }
 #endif
+   if (sp_factors && Af_data)
+   {
+      // Replace the factors with their single precision copy
+      const int size = Af_offsets.Last();
+      Af_data_sp = new float[size];
+      for (int i = 0; i < size; i++)
+      {
+         Af_data_sp[i] = (float)Af_data[i];
+      }
+      delete [] Af_data;
+      Af_data = NULL;
+   }
 }
 
 void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
@@ -739,8 +792,6 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
    }
 
    const int NE = fes->GetMesh()->GetNE();
-   Array<int> vdofs, i_dofs, b_dofs;
-   Vector el_vals, bf_i, i_vals, b_vals;
    bf.SetSize(hat_offsets[NE]);
    if (mode == 1)
    {
@@ -761,45 +812,68 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       Ct->Mult(lambda, bf);
 #endif
    }
-   // Apply Af^{-1}
-   Array<bool> vdof_marker(b1.Size());
-   vdof_marker = false;
-   for (int i = 0; i < NE; i++)
+   // Apply Af^{-1}; the elements are independent
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      fes->GetElementVDofs(i, vdofs);
-      b1.GetSubVector(vdofs, el_vals);
-      for (int j = 0; j < vdofs.Size(); j++)
-      {
-         int vdof = vdofs[j];
-         if (vdof < 0) { vdof = -1 - vdof; }
-         if (vdof_marker[vdof]) { el_vals(j) = 0.0; }
-         else { vdof_marker[vdof] = true; }
-      }
-      bf_i.SetDataAndSize(&bf[hat_offsets[i]], vdofs.Size());
-      if (mode == 1)
-      {
-         el_vals -= bf_i;
-      }
-      GetIBDofs(i, i_dofs, b_dofs);
-      el_vals.GetSubVector(i_dofs, i_vals);
-      el_vals.GetSubVector(b_dofs, b_vals);
+      Array<int> vdofs, i_dofs, b_dofs;
+      Vector el_vals, bf_i, i_vals, b_vals, el_factors;
 
-      LUFactors LU_ii(Af_data + Af_offsets[i], Af_ipiv + Af_f_offsets[i]);
-      double *U_ib = LU_ii.data + i_dofs.Size()*i_dofs.Size();
-      double *L_bi = U_ib + i_dofs.Size()*b_dofs.Size();
-      LUFactors LU_bb(L_bi + b_dofs.Size()*i_dofs.Size(),
-                      LU_ii.ipiv + i_dofs.Size());
-      LU_ii.BlockForwSolve(i_dofs.Size(), b_dofs.Size(), 1, L_bi,
-                           i_vals.GetData(), b_vals.GetData());
-      LU_bb.Solve(b_dofs.Size(), 1, b_vals.GetData());
-      bf_i = 0.0;
-      if (mode == 1)
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < NE; i++)
       {
-         LU_ii.BlockBackSolve(i_dofs.Size(), b_dofs.Size(), 1, U_ib,
-                              b_vals.GetData(), i_vals.GetData());
-         bf_i.SetSubVector(i_dofs, i_vals);
+         fes->GetElementVDofs(i, vdofs);
+         b1.GetSubVector(vdofs, el_vals);
+         for (int j = 0; j < vdofs.Size(); j++)
+         {
+            // Only the first hat_dof of each vdof gets the value of b1
+            if (!hat_dofs_first[hat_offsets[i]+j]) { el_vals(j) = 0.0; }
+         }
+         bf_i.SetDataAndSize(&bf[hat_offsets[i]], vdofs.Size());
+         if (mode == 1)
+         {
+            el_vals -= bf_i;
+         }
+         GetIBDofs(i, i_dofs, b_dofs);
+         el_vals.GetSubVector(i_dofs, i_vals);
+         el_vals.GetSubVector(b_dofs, b_vals);
+
+         double *Af_i;
+         if (Af_data)
+         {
+            Af_i = Af_data + Af_offsets[i];
+         }
+         else
+         {
+            const int size = Af_offsets[i+1] - Af_offsets[i];
+            const float *Af_i_sp = Af_data_sp + Af_offsets[i];
+            el_factors.SetSize(size);
+            for (int j = 0; j < size; j++)
+            {
+               el_factors(j) = Af_i_sp[j];
+            }
+            Af_i = el_factors.GetData();
+         }
+         LUFactors LU_ii(Af_i, Af_ipiv + Af_f_offsets[i]);
+         double *U_ib = LU_ii.data + i_dofs.Size()*i_dofs.Size();
+         double *L_bi = U_ib + i_dofs.Size()*b_dofs.Size();
+         LUFactors LU_bb(L_bi + b_dofs.Size()*i_dofs.Size(),
+                         LU_ii.ipiv + i_dofs.Size());
+         LU_ii.BlockForwSolve(i_dofs.Size(), b_dofs.Size(), 1, L_bi,
+                              i_vals.GetData(), b_vals.GetData());
+         LU_bb.Solve(b_dofs.Size(), 1, b_vals.GetData());
+         bf_i = 0.0;
+         if (mode == 1)
+         {
+            LU_ii.BlockBackSolve(i_dofs.Size(), b_dofs.Size(), 1, U_ib,
+                                 b_vals.GetData(), i_vals.GetData());
+            bf_i.SetSubVector(i_dofs, i_vals);
+         }
+         bf_i.SetSubVector(b_dofs, b_vals);
       }
-      bf_i.SetSubVector(b_dofs, b_vals);
    }
 }
 
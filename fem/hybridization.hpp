@@ -66,9 +66,14 @@ protected:
    SparseMatrix *Ct, *H;
 
    Array<int> hat_offsets, hat_dofs_marker;
+   // Marks the first hat_dof (in element order) of every vdof of fes
+   Array<bool> hat_dofs_first;
    Array<int> Af_offsets, Af_f_offsets;
    double *Af_data;
    int *Af_ipiv;
+   // Single precision copy of the factors, replacing Af_data after ComputeH()
+   float *Af_data_sp;
+   bool sp_factors;
 
 #ifdef MFEM_USE_MPI
    HypreParMatrix *pC, *P_pc; // for parallel non-conforming meshes
@@ -81,6 +86,13 @@ protected:
 
    void GetBDofs(int el, int &num_idofs, Array<int> &b_dofs) const;
 
+   // Allocate Af_data, if it was released in favor of Af_data_sp.
+   void AllocAfData();
+
+   // Factor the blocks of the element matrix stored in Af_data, element 'el'.
+   // Different elements can be factored concurrently.
+   void FactorElementMatrix(int el);
+
    void ComputeH();
 
    // Compute depending on mode:
@@ -108,13 +120,23 @@ public:
    /// Prepare the Hybridization object for assembly.
    void Init(const Array<int> &ess_tdof_list);
 
+   /** @brief Store the local factors, used by ReduceRHS() and
+       ComputeSolution(), in single precision, halving their memory.
+
+       The hybridized matrix is always computed with the double precision
+       factors, while the local solves in ReduceRHS() and ComputeSolution()
+       have the accuracy of single precision. This method should be called
+       before Finalize(). */
+   void SetSinglePrecisionFactors(bool sp = true) { sp_factors = sp; }
+
    /// Assemble the element matrix A into the hybridized system matrix.
    void AssembleMatrix(int el, const DenseMatrix &A);
 
    /// Assemble the boundary element matrix A into the hybridized system matrix.
    void AssembleBdrMatrix(int bdr_el, const DenseMatrix &A);
 
-   /// Finalize the construction of the hybridized matrix.
+   /** @brief Finalize the construction of the hybridized matrix. With
+       MFEM_USE_OPENMP, the local factorizations are computed in parallel. */
    void Finalize();
 
    /// Return the serial hybridized matrix.
@@ -133,12 +155,14 @@ public:
 #endif
 
    /** Perform the reduction of the given r.h.s. vector, b, to a r.h.s vector,
-       b_r, for the hybridized system. */
+       b_r, for the hybridized system. With MFEM_USE_OPENMP, the local solves
+       are performed in parallel. */
    void ReduceRHS(const Vector &b, Vector &b_r) const;
 
    /** Reconstruct the solution of the original system, sol, from solution of
        the hybridized system, sol_r, and the original r.h.s. vector, b.
-       It is assumed that the vector sol has the right essential b.c. */
+       It is assumed that the vector sol has the right essential b.c. With
+       MFEM_USE_OPENMP, the local solves are performed in parallel. */
    void ComputeSolution(const Vector &b, const Vector &sol_r,
                         Vector &sol) const;
 
@@ -11,6 +11,10 @@
 
 #include "fem.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -69,7 +73,13 @@ double NonlinearForm::GetGridFunctionEnergy(const Vector &x) const
 
    if (dnfi.Size())
    {
-      for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+      const bool threaded = threaded_mult &&
+                            GetDomainEnergyThreaded(x, energy);
+#else
+      const bool threaded = false;
+#endif
+      for (int i = 0; !threaded && i < fes->GetNE(); i++)
       {
          fe = fes->GetFE(i);
          fes->GetElementVDofs(i, vdofs);
@@ -121,7 +131,13 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
 
    if (dnfi.Size())
    {
-      for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+      const bool threaded = threaded_mult &&
+                            AssembleDomainVectorThreaded(px, py);
+#else
+      const bool threaded = false;
+#endif
+      for (int i = 0; !threaded && i < fes->GetNE(); i++)
       {
          fe = fes->GetFE(i);
          fes->GetElementVDofs(i, vdofs);
@@ -232,6 +248,19 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
 
 Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
+   if (mf_grad)
+   {
+      MFEM_VERIFY(fnfi.Size() == 0 && bfnfi.Size() == 0,
+                  "face integrators are not supported by the matrix-free "
+                  "gradient");
+      if (mfGrad == NULL)
+      {
+         mfGrad = new NonlinearFormGradient(*this);
+      }
+      mfGrad->SetState(x);
+      return *mfGrad;
+   }
+
    const int skip_zeros = 0;
    Array<int> vdofs;
    Vector el_x;
@@ -252,17 +281,26 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 
    if (dnfi.Size())
    {
-      for (int i = 0; i < fes->GetNE(); i++)
+#ifdef MFEM_USE_OPENMP
+      const bool threaded = threaded_grad &&
+                            AssembleDomainGradThreaded(px, skip_zeros);
+#else
+      const bool threaded = false;
+#endif
+      if (!threaded)
       {
-         fe = fes->GetFE(i);
-         fes->GetElementVDofs(i, vdofs);
-         T = fes->GetElementTransformation(i);
-         px.GetSubVector(vdofs, el_x);
-         for (int k = 0; k < dnfi.Size(); k++)
+         for (int i = 0; i < fes->GetNE(); i++)
          {
-            dnfi[k]->AssembleElementGrad(*fe, *T, el_x, elmat);
-            Grad->AddSubMatrix(vdofs, vdofs, elmat, skip_zeros);
-            // Grad->AddSubMatrix(vdofs, vdofs, elmat, 1);
+            fe = fes->GetFE(i);
+            fes->GetElementVDofs(i, vdofs);
+            T = fes->GetElementTransformation(i);
+            px.GetSubVector(vdofs, el_x);
+            for (int k = 0; k < dnfi.Size(); k++)
+            {
+               dnfi[k]->AssembleElementGrad(*fe, *T, el_x, elmat);
+               Grad->AddSubMatrix(vdofs, vdofs, elmat, skip_zeros);
+               // Grad->AddSubMatrix(vdofs, vdofs, elmat, 1);
+            }
          }
       }
    }
@@ -373,11 +411,219 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
    return *mGrad;
 }
 
+#ifdef MFEM_USE_OPENMP
+bool NonlinearForm::CloneDomainIntegrators(
+   int nt, Array<NonlinearFormIntegrator*> &integs) const
+{
+   // Every thread uses its own copies of the integrators, since their methods
+   // modify the integrator (and model) data.
+   const int ni = dnfi.Size();
+   integs.SetSize(nt*ni);
+   bool cloned = true;
+   for (int k = 0; k < nt*ni; k++)
+   {
+      integs[k] = cloned ? dnfi[k%ni]->Clone() : NULL;
+      cloned = cloned && integs[k];
+   }
+   if (!cloned)
+   {
+      for (int k = 0; k < nt*ni; k++) { delete integs[k]; }
+      integs.SetSize(0);
+   }
+   return cloned;
+}
+
+bool NonlinearForm::GetDomainEnergyThreaded(const Vector &x,
+                                            double &energy) const
+{
+   const int nt = omp_get_max_threads(), ni = dnfi.Size();
+   Array<NonlinearFormIntegrator*> integs;
+   if (!CloneDomainIntegrators(nt, integs)) { return false; }
+
+   // The energies of each thread are summed separately, then added in the
+   // order of the threads.
+   const int NE = fes->GetNE();
+   Vector thread_energy(nt);
+   thread_energy = 0.0;
+
+   #pragma omp parallel num_threads(nt)
+   {
+      const int t = omp_get_thread_num();
+      NonlinearFormIntegrator **integ = integs.GetData() + t*ni;
+      IsoparametricTransformation T;
+      Array<int> vdofs;
+      Vector el_x;
+      double e = 0.0;
+
+      #pragma omp for schedule(static)
+      for (int i = 0; i < NE; i++)
+      {
+         const FiniteElement *fe = fes->GetFE(i);
+         fes->GetElementVDofs(i, vdofs);
+         fes->GetElementTransformation(i, &T);
+         x.GetSubVector(vdofs, el_x);
+         for (int k = 0; k < ni; k++)
+         {
+            e += integ[k]->GetElementEnergy(*fe, T, el_x);
+         }
+      }
+      thread_energy(t) = e;
+   }
+
+   for (int t = 0; t < nt; t++) { energy += thread_energy(t); }
+   for (int k = 0; k < nt*ni; k++) { delete integs[k]; }
+   return true;
+}
+
+bool NonlinearForm::AssembleDomainVectorThreaded(const Vector &px,
+                                                 Vector &py) const
+{
+   const int nt = omp_get_max_threads(), ni = dnfi.Size();
+   Array<NonlinearFormIntegrator*> integs;
+   if (!CloneDomainIntegrators(nt, integs)) { return false; }
+
+   // As in AssembleDomainGradThreaded(), the element vectors of a batch of
+   // elements are computed in parallel and then added to py serially.
+   const int NE = fes->GetNE();
+   const int batch_size = 16*nt;
+   Vector *el_vects = new Vector[batch_size];
+   Array<int> *el_vdofs = new Array<int>[batch_size];
+
+   #pragma omp parallel num_threads(nt)
+   {
+      NonlinearFormIntegrator **integ =
+         integs.GetData() + omp_get_thread_num()*ni;
+      IsoparametricTransformation T;
+      Vector el_x, el_y;
+
+      for (int i0 = 0; i0 < NE; i0 += batch_size)
+      {
+         const int i1 = std::min(NE, i0 + batch_size);
+
+         #pragma omp for schedule(static)
+         for (int i = i0; i < i1; i++)
+         {
+            const FiniteElement *fe = fes->GetFE(i);
+            Vector &el_vect = el_vects[i-i0];
+            Array<int> &vdofs = el_vdofs[i-i0];
+
+            fes->GetElementVDofs(i, vdofs);
+            fes->GetElementTransformation(i, &T);
+            px.GetSubVector(vdofs, el_x);
+            integ[0]->AssembleElementVector(*fe, T, el_x, el_vect);
+            for (int k = 1; k < ni; k++)
+            {
+               integ[k]->AssembleElementVector(*fe, T, el_x, el_y);
+               el_vect += el_y;
+            }
+         }
+
+         #pragma omp single
+         for (int i = i0; i < i1; i++)
+         {
+            py.AddElementVector(el_vdofs[i-i0], el_vects[i-i0]);
+         }
+      }
+   }
+
+   delete [] el_vdofs;
+   delete [] el_vects;
+   for (int k = 0; k < nt*ni; k++) { delete integs[k]; }
+   return true;
+}
+
+bool NonlinearForm::AssembleDomainGradThreaded(const Vector &px,
+                                               int skip_zeros) const
+{
+   const int nt = omp_get_max_threads(), ni = dnfi.Size();
+   Array<NonlinearFormIntegrator*> integs;
+   if (!CloneDomainIntegrators(nt, integs)) { return false; }
+
+   // Compute the element gradients of a batch of elements in parallel, then
+   // add them to Grad serially; this bounds the memory used for storing the
+   // element matrices.
+   const int NE = fes->GetNE();
+   const int batch_size = 16*nt;
+   DenseMatrix *el_grads = new DenseMatrix[batch_size];
+   Array<int> *el_vdofs = new Array<int>[batch_size];
+
+   #pragma omp parallel num_threads(nt)
+   {
+      NonlinearFormIntegrator **integ =
+         integs.GetData() + omp_get_thread_num()*ni;
+      IsoparametricTransformation T;
+      Vector el_x;
+      DenseMatrix elmat;
+
+      for (int i0 = 0; i0 < NE; i0 += batch_size)
+      {
+         const int i1 = std::min(NE, i0 + batch_size);
+
+         #pragma omp for schedule(static)
+         for (int i = i0; i < i1; i++)
+         {
+            const FiniteElement *fe = fes->GetFE(i);
+            DenseMatrix &el_grad = el_grads[i-i0];
+            Array<int> &vdofs = el_vdofs[i-i0];
+
+            fes->GetElementVDofs(i, vdofs);
+            fes->GetElementTransformation(i, &T);
+            px.GetSubVector(vdofs, el_x);
+            integ[0]->AssembleElementGrad(*fe, T, el_x, el_grad);
+            for (int k = 1; k < ni; k++)
+            {
+               integ[k]->AssembleElementGrad(*fe, T, el_x, elmat);
+               el_grad += elmat;
+            }
+         }
+
+         #pragma omp single
+         for (int i = i0; i < i1; i++)
+         {
+            Grad->AddSubMatrix(el_vdofs[i-i0], el_vdofs[i-i0],
+                               el_grads[i-i0], skip_zeros);
+         }
+      }
+   }
+
+   delete [] el_vdofs;
+   delete [] el_grads;
+   for (int k = 0; k < nt*ni; k++) { delete integs[k]; }
+   return true;
+}
+#endif
+
+void NonlinearForm::GradientMult(const Vector &px, const Vector &pv,
+                                 Vector &py) const
+{
+   Array<int> vdofs;
+   Vector el_x, el_v, el_y;
+   const FiniteElement *fe;
+   ElementTransformation *T;
+
+   py = 0.0;
+
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      fe = fes->GetFE(i);
+      fes->GetElementVDofs(i, vdofs);
+      T = fes->GetElementTransformation(i);
+      px.GetSubVector(vdofs, el_x);
+      pv.GetSubVector(vdofs, el_v);
+      for (int k = 0; k < dnfi.Size(); k++)
+      {
+         dnfi[k]->AssembleElementGradAction(*fe, *T, el_x, el_v, el_y);
+         py.AddElementVector(vdofs, el_y);
+      }
+   }
+}
+
 void NonlinearForm::Update()
 {
    if (sequence == fes->GetSequence()) { return; }
 
    height = width = fes->GetTrueVSize();
+   delete mfGrad; mfGrad = NULL;
    delete cGrad; cGrad = NULL;
    delete Grad; Grad = NULL;
    ess_tdof_list.SetSize(0); // essential b.c. will need to be set again
@@ -389,6 +635,7 @@ void NonlinearForm::Update()
 
 NonlinearForm::~NonlinearForm()
 {
+   delete mfGrad;
    delete cGrad;
    delete Grad;
    for (int i = 0; i <  dnfi.Size(); i++) { delete  dnfi[i]; }
@@ -397,6 +644,53 @@ NonlinearForm::~NonlinearForm()
 }
 
 
+void NonlinearFormGradient::SetState(const Vector &x)
+{
+   const Operator *P = form.GetProlongation();
+   if (P)
+   {
+      state.SetSize(P->Height());
+      P->Mult(x, state);
+   }
+   else
+   {
+      state = x;
+   }
+}
+
+void NonlinearFormGradient::Mult(const Vector &v, Vector &y) const
+{
+   const Operator *P = form.GetProlongation();
+   const Array<int> &ess_tdof_list = form.GetEssentialTrueDofs();
+
+   // Eliminate the essential columns by zeroing the input essential dofs.
+   v_e = v;
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      v_e(ess_tdof_list[i]) = 0.0;
+   }
+
+   if (P)
+   {
+      pv.SetSize(P->Height());
+      py.SetSize(P->Height());
+      P->Mult(v_e, pv);
+      form.GradientMult(state, pv, py);
+      P->MultTranspose(py, y);
+   }
+   else
+   {
+      form.GradientMult(state, v_e, y);
+   }
+
+   // Identity on the essential rows.
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      y(ess_tdof_list[i]) = v(ess_tdof_list[i]);
+   }
+}
+
+
 BlockNonlinearForm::BlockNonlinearForm() :
    fes(0), BlockGrad(NULL)
 {
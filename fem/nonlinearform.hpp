@@ -19,6 +19,8 @@
 namespace mfem
 {
 
+class NonlinearFormGradient;
+
 class NonlinearForm : public Operator
 {
 protected:
@@ -37,6 +39,16 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// Compute the domain element gradients with OpenMP threads.
+   bool threaded_grad;
+
+   /// Compute the domain element energies and vectors with OpenMP threads.
+   bool threaded_mult;
+
+   /// Return a matrix-free gradient from GetGradient().
+   bool mf_grad;
+   mutable NonlinearFormGradient *mfGrad; // owned
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -54,12 +66,41 @@ protected:
    bool Serial() const { return (!P || cP); }
    const Vector &Prolongate(const Vector &x) const;
 
+#ifdef MFEM_USE_OPENMP
+   /** @brief Set @a integs to @a nt copies of the domain integrators, one set
+       per thread; return false, with @a integs empty, if an integrator cannot
+       be cloned. */
+   bool CloneDomainIntegrators(int nt,
+                               Array<NonlinearFormIntegrator*> &integs) const;
+
+   /** @brief Threaded version of the domain integrator part of
+       GetGridFunctionEnergy(); return false if an integrator cannot be
+       cloned. */
+   bool GetDomainEnergyThreaded(const Vector &x, double &energy) const;
+
+   /** @brief Threaded version of the domain integrator part of Mult(); return
+       false, without assembling, if an integrator cannot be cloned. */
+   bool AssembleDomainVectorThreaded(const Vector &px, Vector &py) const;
+
+   /** @brief Threaded version of the domain integrator part of GetGradient();
+       return false, without assembling, if an integrator cannot be cloned. */
+   bool AssembleDomainGradThreaded(const Vector &px, int skip_zeros) const;
+#endif
+
+   /** @brief Compute @a py = Grad(@a px) @a pv without assembling the gradient;
+       all vectors are "GridFunction size" vectors. */
+   void GradientMult(const Vector &px, const Vector &pv, Vector &py) const;
+
+   friend class NonlinearFormGradient;
+
 public:
    /// Construct a NonlinearForm on the given FiniteElementSpace, @a f.
    /** As an Operator, the NonlinearForm has input and output size equal to the
        number of true degrees of freedom, i.e. f->GetTrueVSize(). */
    NonlinearForm(FiniteElementSpace *f)
       : Operator(f->GetTrueVSize()), fes(f), Grad(NULL), cGrad(NULL),
+        threaded_grad(false), threaded_mult(false), mf_grad(false),
+        mfGrad(NULL),
         sequence(f->GetSequence()), P(f->GetProlongationMatrix()),
         cP(dynamic_cast<const SparseMatrix*>(P))
    { }
@@ -104,6 +145,39 @@ public:
    /// Return a (read-only) list of all essential true dofs.
    const Array<int> &GetEssentialTrueDofs() const { return ess_tdof_list; }
 
+   /** @brief Compute the element gradients of the domain integrators in
+       parallel, using OpenMP threads. */
+   /** This option has effect only when MFEM is built with MFEM_USE_OPENMP.
+       The element matrices are computed in batches, in parallel, and are then
+       added serially to the gradient matrix whose sparsity pattern is reused
+       after the first call to GetGradient(). Every thread uses its own copies
+       of the domain integrators, made with NonlinearFormIntegrator::Clone(),
+       e.g. HyperelasticNLFIntegrator with InverseHarmonicModel or
+       NeoHookeanModel, or TMOP_Integrator. The copies share the
+       Coefficient%s of the originals, so their Eval() methods must be
+       thread-safe. If one of the integrators does not support Clone(), the
+       gradient is assembled serially. */
+   void UseThreadedGradient(bool tg = true) { threaded_grad = tg; }
+
+   /** @brief Compute the element energies and vectors of the domain
+       integrators in GetEnergy() and Mult() in parallel, using OpenMP
+       threads. */
+   /** This option has effect only when MFEM is built with MFEM_USE_OPENMP. As
+       with UseThreadedGradient(), every thread uses its own copies of the
+       domain integrators, and the evaluation is serial if one of them does
+       not support Clone(). The element vectors are computed in batches and
+       added serially to the result. */
+   void UseThreadedMult(bool tm = true) { threaded_mult = tm; }
+
+   /// Make GetGradient() return a matrix-free gradient Operator.
+   /** The returned NonlinearFormGradient computes the action of the gradient
+       element by element, using the method AssembleElementGradAction() of the
+       domain integrators. This avoids storing the gradient matrix, which is
+       large for high-order discretizations. The gradient can be used with
+       Krylov solvers, e.g. GMRESSolver, but not with preconditioners that
+       require the gradient matrix. Face integrators are not supported. */
+   void UseMatrixFreeGradient(bool mfg = true) { mf_grad = mfg; }
+
    /// Compute the enery corresponding to the state @a x.
    /** In general, @a x may have non-homogeneous essential boundary values.
 
@@ -156,6 +230,30 @@ public:
 };
 
 
+/// Matrix-free gradient Operator of a NonlinearForm at a given state.
+/** The action of the gradient is computed element by element with
+    NonlinearFormIntegrator::AssembleElementGradAction(), so the gradient matrix
+    is never assembled. As in NonlinearForm::GetGradient(), the rows and columns
+    of the essential true dofs are replaced by those of the identity. Both the
+    input and the output of Mult() are true-dof vectors. */
+class NonlinearFormGradient : public Operator
+{
+protected:
+   const NonlinearForm &form;
+   Vector state; ///< The current state, as a "GridFunction size" vector.
+   mutable Vector v_e, pv, py; // auxiliary vectors
+
+public:
+   NonlinearFormGradient(const NonlinearForm &nlf)
+      : Operator(nlf.Height(), nlf.Width()), form(nlf) { }
+
+   /// Set the true-dof state @a x at which the gradient is evaluated.
+   void SetState(const Vector &x);
+
+   virtual void Mult(const Vector &v, Vector &y) const;
+};
+
+
 /** @brief A class representing a general block nonlinear operator defined on
     the Cartesian product of multiple FiniteElementSpace%s. */
 class BlockNonlinearForm : public Operator
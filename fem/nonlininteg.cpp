@@ -11,6 +11,9 @@
 
 #include "fem.hpp"
 
+#include <limits>
+#include <algorithm>
+
 namespace mfem
 {
 
@@ -38,6 +41,27 @@ void NonlinearFormIntegrator::AssembleElementGrad(
               " is not overloaded!");
 }
 
+void NonlinearFormIntegrator::AssembleElementGradAction(
+   const FiniteElement &el, ElementTransformation &Tr, const Vector &elfun,
+   const Vector &elv, Vector &elvect)
+{
+   // elvect = (F(elfun + h elv) - F(elfun))/h, where F is the local action
+   const double v_norm = elv.Normlinf();
+   if (v_norm == 0.0)
+   {
+      elvect.SetSize(elfun.Size());
+      elvect = 0.0;
+      return;
+   }
+   const double h = std::sqrt(std::numeric_limits<double>::epsilon()) *
+                    std::max(1.0, elfun.Normlinf())/v_norm;
+   Vector elfun_h(elfun.Size()), elvect_h;
+   add(elfun, h, elv, elfun_h);
+   AssembleElementVector(el, Tr, elfun_h, elvect_h);
+   AssembleElementVector(el, Tr, elfun, elvect);
+   subtract(1.0/h, elvect_h, elvect, elvect);
+}
+
 void NonlinearFormIntegrator::AssembleFaceGrad(
    const FiniteElement &el1, const FiniteElement &el2,
    FaceElementTransformations &Tr, const Vector &elfun,
@@ -111,6 +135,9 @@ double BlockNonlinearFormIntegrator::GetElementEnergy(
 
 double InverseHarmonicModel::EvalW(const DenseMatrix &J) const
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z;
+#endif
    Z.SetSize(J.Width());
    CalcAdjugateTranspose(J, Z);
    return 0.5*(Z*Z)/J.Det();
@@ -121,6 +148,9 @@ void InverseHarmonicModel::EvalP(const DenseMatrix &J, DenseMatrix &P) const
    int dim = J.Width();
    double t;
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z, S;
+#endif
    Z.SetSize(dim);
    S.SetSize(dim);
    CalcAdjugateTranspose(J, Z);
@@ -142,6 +172,9 @@ void InverseHarmonicModel::AssembleH(
    int dof = DS.Height(), dim = DS.Width();
    double t;
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z, S, G, C;
+#endif
    Z.SetSize(dim);
    S.SetSize(dim);
    G.SetSize(dof, dim);
@@ -210,6 +243,31 @@ void InverseHarmonicModel::AssembleH(
 }
 
 
+void HyperelasticModel::EvalDP(const DenseMatrix &Jpt,
+                               const DenseMatrix &dJpt, DenseMatrix &dP) const
+{
+   // dP = (P(Jpt + h dJpt) - P(Jpt))/h
+   const int dim = Jpt.Width();
+   const double d_norm = dJpt.MaxMaxNorm();
+   dP.SetSize(dim);
+   if (d_norm == 0.0) { dP = 0.0; return; }
+   const double h = std::sqrt(std::numeric_limits<double>::epsilon()) *
+                    std::max(1.0, Jpt.MaxMaxNorm())/d_norm;
+   DenseMatrix Jpt_h(Jpt), P(dim);
+   Jpt_h.Add(h, dJpt);
+   EvalP(Jpt_h, dP);
+   EvalP(Jpt, P);
+   dP -= P;
+   dP *= 1.0/h;
+}
+
+
+HyperelasticModel *NeoHookeanModel::Clone() const
+{
+   if (have_coeffs) { return new NeoHookeanModel(*c_mu, *c_K, c_g); }
+   return new NeoHookeanModel(mu, K, g);
+}
+
 inline void NeoHookeanModel::EvalCoeffs() const
 {
    mu = c_mu->Eval(*Ttr, Ttr->GetIntPoint());
@@ -245,6 +303,9 @@ void NeoHookeanModel::EvalP(const DenseMatrix &J, DenseMatrix &P) const
       EvalCoeffs();
    }
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z;
+#endif
    Z.SetSize(dim);
    CalcAdjugateTranspose(J, Z);
 
@@ -267,6 +328,9 @@ void NeoHookeanModel::AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
       EvalCoeffs();
    }
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z, G, C;
+#endif
    Z.SetSize(dim);
    G.SetSize(dof, dim);
    C.SetSize(dof, dim);
@@ -326,6 +390,47 @@ void NeoHookeanModel::AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
 }
 
 
+void NeoHookeanModel::EvalDP(const DenseMatrix &J, const DenseMatrix &D,
+                             DenseMatrix &dP) const
+{
+   int dim = J.Width();
+
+   if (have_coeffs)
+   {
+      EvalCoeffs();
+   }
+
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Z, G, C;
+#endif
+   Z.SetSize(dim);
+   G.SetSize(dim);
+   C.SetSize(dim);
+   CalcAdjugateTranspose(J, Z);
+
+   // Differentiate P = a J + b Z, where Z = det(J) J^{-t}, using the relations
+   // d(det(J)) = Z:D and dZ = (d(det(J)) Z - Z D^t Z)/det(J).
+   double dJ = J.Det();
+   double JJ = J*J;
+   double a  = mu*pow(dJ, -2.0/dim);
+   double b  = K*(dJ/g - 1.0)/g - a*JJ/(dim*dJ);
+   double dd = Z*D; // d(det(J))
+   double da = -2.0*a*dd/(dim*dJ);
+   double db = K*dd/(g*g) - (da*JJ + 2.0*a*(J*D))/(dim*dJ) +
+               a*JJ*dd/(dim*dJ*dJ);
+
+   MultABt(Z, D, G);
+   Mult(G, Z, C); // C = Z D^t Z
+
+   dP.SetSize(dim);
+   dP = 0.0;
+   dP.Add(da, J);
+   dP.Add(a, D);
+   dP.Add(db + b*dd/dJ, Z);
+   dP.Add(-b/dJ, C);
+}
+
+
 double HyperelasticNLFIntegrator::GetElementEnergy(const FiniteElement &el,
                                                    ElementTransformation &Ttr,
                                                    const Vector &elfun)
@@ -333,6 +438,9 @@ double HyperelasticNLFIntegrator::GetElementEnergy(const FiniteElement &el,
    int dof = el.GetDof(), dim = el.GetDim();
    double energy;
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix DSh, Jrt, Jpr, Jpt, PMatI;
+#endif
    DSh.SetSize(dof, dim);
    Jrt.SetSize(dim);
    Jpr.SetSize(dim);
@@ -369,6 +477,9 @@ void HyperelasticNLFIntegrator::AssembleElementVector(
 {
    int dof = el.GetDof(), dim = el.GetDim();
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix DSh, DS, Jrt, Jpt, P, PMatI, PMatO;
+#endif
    DSh.SetSize(dof, dim);
    DS.SetSize(dof, dim);
    Jrt.SetSize(dim);
@@ -410,6 +521,9 @@ void HyperelasticNLFIntegrator::AssembleElementGrad(const FiniteElement &el,
 {
    int dof = el.GetDof(), dim = el.GetDim();
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix DSh, DS, Jrt, Jpt, PMatI;
+#endif
    DSh.SetSize(dof, dim);
    DS.SetSize(dof, dim);
    Jrt.SetSize(dim);
@@ -439,6 +553,61 @@ void HyperelasticNLFIntegrator::AssembleElementGrad(const FiniteElement &el,
    }
 }
 
+void HyperelasticNLFIntegrator::AssembleElementGradAction(
+   const FiniteElement &el, ElementTransformation &Ttr, const Vector &elfun,
+   const Vector &elv, Vector &elvect)
+{
+   int dof = el.GetDof(), dim = el.GetDim();
+
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix DSh, DS, Jrt, Jpt, P, dJpt, PMatI, PMatV, PMatO;
+#endif
+   DSh.SetSize(dof, dim);
+   DS.SetSize(dof, dim);
+   Jrt.SetSize(dim);
+   Jpt.SetSize(dim);
+   dJpt.SetSize(dim);
+   PMatI.UseExternalData(elfun.GetData(), dof, dim);
+   PMatV.UseExternalData(elv.GetData(), dof, dim);
+   elvect.SetSize(dof*dim);
+   PMatO.UseExternalData(elvect.GetData(), dof, dim);
+
+   const IntegrationRule *ir = IntRule;
+   if (!ir)
+   {
+      ir = &(IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3)); // <---
+   }
+
+   elvect = 0.0;
+   model->SetTransformation(Ttr);
+   for (int i = 0; i < ir->GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir->IntPoint(i);
+      Ttr.SetIntPoint(&ip);
+      CalcInverse(Ttr.Jacobian(), Jrt);
+
+      el.CalcDShape(ip, DSh);
+      Mult(DSh, Jrt, DS);
+      MultAtB(PMatI, DS, Jpt);
+      MultAtB(PMatV, DS, dJpt);
+
+      model->EvalDP(Jpt, dJpt, P);
+
+      P *= ip.weight * Ttr.Weight();
+      AddMultABt(DS, P, PMatO);
+   }
+}
+
+NonlinearFormIntegrator *HyperelasticNLFIntegrator::Clone() const
+{
+   HyperelasticModel *m = model->Clone();
+   if (!m) { return NULL; }
+   HyperelasticNLFIntegrator *integ = new HyperelasticNLFIntegrator(m);
+   integ->own_model = true;
+   integ->SetIntRule(IntRule);
+   return integ;
+}
+
 double IncompressibleNeoHookeanIntegrator::GetElementEnergy(
    const Array<const FiniteElement *>&el,
    ElementTransformation &Tr,
@@ -56,6 +56,15 @@ public:
                                     ElementTransformation &Tr,
                                     const Vector &elfun, DenseMatrix &elmat);
 
+   /** @brief Compute the action of the local gradient at the state @a elfun
+       on the vector @a elv, without assembling the local gradient matrix. */
+   /** The default implementation uses a first order finite difference of
+       AssembleElementVector(). */
+   virtual void AssembleElementGradAction(const FiniteElement &el,
+                                          ElementTransformation &Tr,
+                                          const Vector &elfun,
+                                          const Vector &elv, Vector &elvect);
+
    /// @brief Assemble the local action of the gradient of the
    /// NonlinearFormIntegrator resulting from a face integral term.
    virtual void AssembleFaceGrad(const FiniteElement &el1,
@@ -68,6 +77,13 @@ public:
                                    ElementTransformation &Tr,
                                    const Vector &elfun);
 
+   /** @brief Return a new copy of the integrator that does not share any
+       mutable state with it, or NULL if the integrator cannot be copied. */
+   /** Used by NonlinearForm::UseThreadedGradient() and
+       NonlinearForm::UseThreadedMult() to give every thread its own
+       integrator. The default implementation returns NULL. */
+   virtual NonlinearFormIntegrator *Clone() const { return NULL; }
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -153,6 +169,24 @@ public:
    */
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const = 0;
+
+   /** @brief Evaluate the derivative of the 1st Piola-Kirchhoff stress tensor
+       in the direction @a dJpt.
+       @param[in] Jpt   Represents the target->physical transformation
+                        Jacobian matrix.
+       @param[in] dJpt  The direction of differentiation (dim x dim).
+       @param[out] dP   The derivative dP(Jpt)/dJpt : dJpt.
+
+       The default implementation uses a first order finite difference of
+       EvalP(). */
+   virtual void EvalDP(const DenseMatrix &Jpt, const DenseMatrix &dJpt,
+                       DenseMatrix &dP) const;
+
+   /** @brief Return a new copy of the model that does not share any mutable
+       state with it, or NULL if the model cannot be copied. */
+   /** The transformation set with SetTransformation() is not copied. The
+       default implementation returns NULL. */
+   virtual HyperelasticModel *Clone() const { return NULL; }
 };
 
 
@@ -162,8 +196,10 @@ public:
 class InverseHarmonicModel : public HyperelasticModel
 {
 protected:
+#ifndef MFEM_THREAD_SAFE
    mutable DenseMatrix Z, S; // dim x dim
    mutable DenseMatrix G, C; // dof x dim
+#endif
 
 public:
    virtual double EvalW(const DenseMatrix &J) const;
@@ -172,6 +208,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual HyperelasticModel *Clone() const
+   { return new InverseHarmonicModel; }
 };
 
 
@@ -187,8 +226,10 @@ protected:
    Coefficient *c_mu, *c_K, *c_g;
    bool have_coeffs;
 
+#ifndef MFEM_THREAD_SAFE
    mutable DenseMatrix Z;    // dim x dim
    mutable DenseMatrix G, C; // dof x dim
+#endif
 
    inline void EvalCoeffs() const;
 
@@ -206,6 +247,12 @@ public:
 
    virtual void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual void EvalDP(const DenseMatrix &J, const DenseMatrix &D,
+                       DenseMatrix &dP) const;
+
+   /// The copy uses the same Coefficient%s, whose Eval() must be thread-safe.
+   virtual HyperelasticModel *Clone() const;
 };
 
 
@@ -220,6 +267,7 @@ class HyperelasticNLFIntegrator : public NonlinearFormIntegrator
 {
 private:
    HyperelasticModel *model;
+   bool own_model;
 
    //   Jrt: the Jacobian of the target-to-reference-element transformation.
    //   Jpr: the Jacobian of the reference-to-physical-element transformation.
@@ -231,11 +279,19 @@ private:
    // PMatI: coordinates of the deformed configuration (dof x dim).
    // PMatO: reshaped view into the local element contribution to the operator
    //        output - the result of AssembleElementVector() (dof x dim).
-   DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
+   //  dJpt: derivative of Jpt in the direction given by PMatV (dim x dim).
+   // PMatV: reshaped view into the direction of differentiation, the input of
+   //        AssembleElementGradAction() (dof x dim).
+#ifndef MFEM_THREAD_SAFE
+   DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO, dJpt, PMatV;
+#endif
 
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), own_model(false) { }
+
+   virtual ~HyperelasticNLFIntegrator() { if (own_model) { delete model; } }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -252,6 +308,16 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   /// Compute the action of the local gradient using HyperelasticModel::EvalDP.
+   virtual void AssembleElementGradAction(const FiniteElement &el,
+                                          ElementTransformation &Ttr,
+                                          const Vector &elfun,
+                                          const Vector &elv, Vector &elvect);
+
+   /** @brief Return a copy of the integrator with its own copy of the model,
+       or NULL if HyperelasticModel::Clone() returns NULL. */
+   virtual NonlinearFormIntegrator *Clone() const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
@@ -15,6 +15,7 @@
 
 #include "fem.hpp"
 #include "../general/sort_pairs.hpp"
+#include "../general/profiler.hpp"
 
 namespace mfem
 {
@@ -123,6 +124,7 @@ void ParBilinearForm::pAllocMat()
 
 void ParBilinearForm::ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local)
 {
+   MFEM_PROFILE_REGION("ParBilinearForm::ParallelAssemble");
    A.Clear();
 
    if (A_local == NULL) { return; }
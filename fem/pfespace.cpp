@@ -1917,7 +1917,7 @@ int ParFiniteElementSpace
                GetEntityDofs(entity, sf.index, slave_dofs);
                if (!slave_dofs.Size()) { continue; }
 
-               sf.OrientedPointMatrix(T.GetPointMat());
+               list.OrientedPointMatrix(sf, T.GetPointMat());
                T.FinalizeTransformation();
                fe->GetLocalInterpolation(T, I);
 
@@ -500,6 +500,21 @@ void ParGridFunction::Save(std::ostream &out) const
    }
 }
 
+void ParGridFunction::GetSaveData(Vector &sdata) const
+{
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data[i] = -data[i]; }
+   }
+
+   GridFunction::GetSaveData(sdata);
+
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data[i] = -data[i]; }
+   }
+}
+
 void ParGridFunction::SaveAsOne(std::ostream &out)
 {
    int i, p;
@@ -313,6 +313,9 @@ public:
        the local dofs. */
    virtual void Save(std::ostream &out) const;
 
+   /// Copy the values written by Save(), taking into account the dof signs.
+   virtual void GetSaveData(Vector &sdata) const;
+
    /// Merge the local grid functions
    void SaveAsOne(std::ostream &out = mfem::out);
 
@@ -137,7 +137,8 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
    // symm = symmetric; // TODO: handle the symmetric case
    A_offsets.SetSize(NE+1);
    A_ipiv_offsets.SetSize(NE+1);
-   A_offsets[0] = A_ipiv_offsets[0] = 0;
+   rvdof_offsets.SetSize(NE+1);
+   A_offsets[0] = A_ipiv_offsets[0] = rvdof_offsets[0] = 0;
    Array<int> rvdofs;
    for (int i = 0; i < NE; i++)
    {
@@ -146,6 +147,7 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
       const int npd = elem_pdof.RowSize(i);
       A_offsets[i+1] = A_offsets[i] + npd*(npd + (symm ? 1 : 2)*ned);
       A_ipiv_offsets[i+1] = A_ipiv_offsets[i] + npd;
+      rvdof_offsets[i+1] = rvdof_offsets[i] + ned;
    }
    A_data = new double[A_offsets[NE]];
    A_ipiv = new int[A_ipiv_offsets[NE]];
@@ -186,19 +188,19 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
    }
 }
 
-void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
+void StaticCondensation::FactorElementMatrix(int el, const DenseMatrix &elmat,
+                                             DenseMatrix &A_ee)
 {
-   Array<int> rvdofs;
-   tr_fes->GetElementVDofs(el, rvdofs);
    const int vdim = fes->GetVDim();
    const int nvpd = elem_pdof.RowSize(el);
-   const int nved = rvdofs.Size();
+   const int nved = rvdof_offsets[el+1] - rvdof_offsets[el];
+   MFEM_ASSERT(A_ee.Height() == nved && A_ee.Width() == nved,
+               "invalid A_ee size");
    DenseMatrix A_pp(A_data + A_offsets[el], nvpd, nvpd);
    DenseMatrix A_pe(A_pp.Data() + nvpd*nvpd, nvpd, nved);
    DenseMatrix A_ep;
    if (symm) { A_ep.SetSize(nved, nvpd); }
    else      { A_ep.UseExternalData(A_pe.Data() + nvpd*nved, nved, nvpd); }
-   DenseMatrix A_ee(nved, nved);
 
    const int npd = nvpd/vdim;
    const int ned = nved/vdim;
@@ -218,12 +220,59 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
    LUFactors lu(A_pp.Data(), A_ipiv + A_ipiv_offsets[el]);
    lu.Factor(nvpd);
    lu.BlockFactor(nvpd, nved, A_pe.Data(), A_ep.Data(), A_ee.Data());
+}
+
+void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
+{
+   Array<int> rvdofs;
+   tr_fes->GetElementVDofs(el, rvdofs);
+   DenseMatrix A_ee(rvdofs.Size());
+   FactorElementMatrix(el, elmat, A_ee);
 
    // Assemble the Schur complement
    const int skip_zeros = 0;
    S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
 }
 
+void StaticCondensation::AssembleMatrices(const DenseTensor &elmats)
+{
+   const int NE = fes->GetNE();
+   MFEM_VERIFY(elmats.SizeK() == NE, "invalid number of element matrices");
+
+   // The element Schur complements, stored contiguously
+   Array<int> A_ee_offsets(NE+1);
+   A_ee_offsets[0] = 0;
+   for (int i = 0; i < NE; i++)
+   {
+      const int nved = rvdof_offsets[i+1] - rvdof_offsets[i];
+      A_ee_offsets[i+1] = A_ee_offsets[i] + nved*nved;
+   }
+   Vector A_ee_data(A_ee_offsets[NE]);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      const int nved = rvdof_offsets[i+1] - rvdof_offsets[i];
+      const DenseMatrix elmat(const_cast<double*>(elmats.GetData(i)),
+                              elmats.SizeI(), elmats.SizeJ());
+      DenseMatrix A_ee(A_ee_data.GetData() + A_ee_offsets[i], nved, nved);
+      FactorElementMatrix(i, elmat, A_ee);
+   }
+
+   // Assemble the Schur complement
+   const int skip_zeros = 0;
+   Array<int> rvdofs;
+   for (int i = 0; i < NE; i++)
+   {
+      tr_fes->GetElementVDofs(i, rvdofs);
+      const DenseMatrix A_ee(A_ee_data.GetData() + A_ee_offsets[i],
+                             rvdofs.Size(), rvdofs.Size());
+      S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
+   }
+}
+
 void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
 {
    Array<int> rvdofs;
@@ -332,41 +381,60 @@ void StaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
       b_r(i) = b(rdof_edof[i]);
    }
 
-   DenseMatrix U_pe, L_ep;
-   Vector b_p, b_ep;
+   // The element contributions A_ep A_pp_inv b_p, stored contiguously
+   Vector b_ep_data(rvdof_offsets[NE]);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      DenseMatrix U_pe, L_ep;
+      Vector b_p, b_ep;
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < NE; i++)
+      {
+         const int ned = rvdof_offsets[i+1] - rvdof_offsets[i];
+         const int npd = elem_pdof.RowSize(i);
+         const int *pd = elem_pdof.GetRow(i);
+         b_p.SetSize(npd);
+         b_ep.SetDataAndSize(b_ep_data.GetData() + rvdof_offsets[i], ned);
+         for (int j = 0; j < npd; j++)
+         {
+            b_p(j) = b(pd[j]);
+         }
+
+         LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
+         lu.LSolve(npd, 1, b_p);
+
+         if (symm)
+         {
+            // TODO: handle the symmetric case correctly.
+            U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
+            U_pe.MultTranspose(b_p, b_ep);
+         }
+         else
+         {
+            L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
+            L_ep.Mult(b_p, b_ep);
+         }
+      }
+   }
+
+   // Subtract the element contributions in element order
    Array<int> rvdofs;
    for (int i = 0; i < NE; i++)
    {
       tr_fes->GetElementVDofs(i, rvdofs);
       const int ned = rvdofs.Size();
       const int *rd = rvdofs.GetData();
-      const int npd = elem_pdof.RowSize(i);
-      const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
-      b_ep.SetSize(ned);
-      for (int j = 0; j < npd; j++)
-      {
-         b_p(j) = b(pd[j]);
-      }
-
-      LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
-      lu.LSolve(npd, 1, b_p);
-
-      if (symm)
-      {
-         // TODO: handle the symmetric case correctly.
-         U_pe.UseExternalData(lu.data + npd*npd, npd, ned);
-         U_pe.MultTranspose(b_p, b_ep);
-      }
-      else
-      {
-         L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
-         L_ep.Mult(b_p, b_ep);
-      }
+      const double *b_ep = b_ep_data.GetData() + rvdof_offsets[i];
       for (int j = 0; j < ned; j++)
       {
-         if (rd[j] >= 0) { b_r(rd[j]) -= b_ep(j); }
-         else            { b_r(-1-rd[j]) += b_ep(j); }
+         if (rd[j] >= 0) { b_r(rd[j]) -= b_ep[j]; }
+         else            { b_r(-1-rd[j]) += b_ep[j]; }
       }
    }
    if (!Parallel())
@@ -510,29 +578,40 @@ void StaticCondensation::ComputeSolution(
       sol(rdof_edof[i]) = sol_r(i);
    }
    const int NE = fes->GetNE();
-   Vector b_p, s_e;
-   Array<int> rvdofs;
-   for (int i = 0; i < NE; i++)
+
+   // The private dofs of different elements are disjoint
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
-      const int npd = elem_pdof.RowSize(i);
-      const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
+      Vector b_p, s_e;
+      Array<int> rvdofs;
 
-      for (int j = 0; j < npd; j++)
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < NE; i++)
       {
-         b_p(j) = b(pd[j]);
-      }
-      sol_r.GetSubVector(rvdofs, s_e);
+         tr_fes->GetElementVDofs(i, rvdofs);
+         const int ned = rvdofs.Size();
+         const int npd = elem_pdof.RowSize(i);
+         const int *pd = elem_pdof.GetRow(i);
+         b_p.SetSize(npd);
 
-      LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
-      lu.LSolve(npd, 1, b_p);
-      lu.BlockBackSolve(npd, ned, 1, lu.data + npd*npd, s_e, b_p);
+         for (int j = 0; j < npd; j++)
+         {
+            b_p(j) = b(pd[j]);
+         }
+         sol_r.GetSubVector(rvdofs, s_e);
 
-      for (int j = 0; j < npd; j++)
-      {
-         sol(pd[j]) = b_p(j);
+         LUFactors lu(A_data + A_offsets[i], A_ipiv + A_ipiv_offsets[i]);
+         lu.LSolve(npd, 1, b_p);
+         lu.BlockBackSolve(npd, ned, 1, lu.data + npd*npd, s_e, b_p);
+
+         for (int j = 0; j < npd; j++)
+         {
+            sol(pd[j]) = b_p(j);
+         }
       }
    }
 }
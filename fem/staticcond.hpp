@@ -84,9 +84,17 @@ class StaticCondensation
    Array<int> A_offsets, A_ipiv_offsets;
    double *A_data;
    int *A_ipiv;
+   Array<int> rvdof_offsets; // Offsets of the element exposed/reduced vdofs
 
    Array<int> ess_rtdof_list;
 
+   // Copy the blocks of the element matrix 'elmat' to the internal storage,
+   // factor A_pp and compute the element Schur complement in A_ee, which must
+   // have the size of the exposed element vdofs. Different elements can be
+   // processed concurrently.
+   void FactorElementMatrix(int el, const DenseMatrix &elmat,
+                            DenseMatrix &A_ee);
+
 public:
    /// Construct a StaticCondensation object.
    StaticCondensation(FiniteElementSpace *fespace);
@@ -117,6 +125,13 @@ public:
        and A_ep. */
    void AssembleMatrix(int el, const DenseMatrix &elmat);
 
+   /** Assemble the contributions to the Schur complement from the element
+       matrices of all elements, stored in 'elmats', e.g. the ones computed by
+       BilinearForm::ComputeElementMatrices(). With MFEM_USE_OPENMP, the element
+       factorizations and Schur complements are computed in parallel; they are
+       added to the Schur complement matrix in element order. */
+   void AssembleMatrices(const DenseTensor &elmats);
+
    /** Assemble the contribution to the Schur complement from the given boundary
        element matrix 'elmat'. */
    void AssembleBdrMatrix(int el, const DenseMatrix &elmat);
@@ -176,7 +191,8 @@ public:
 #endif
 
    /** Given a RHS vector for the full linear system, compute the RHS for the
-       reduced linear system: sc_b = b_e - A_ep A_pp_inv b_p. */
+       reduced linear system: sc_b = b_e - A_ep A_pp_inv b_p. With
+       MFEM_USE_OPENMP, the element solves are performed in parallel. */
    void ReduceRHS(const Vector &b, Vector &sc_b) const;
 
    /** Restrict a solution vector on the full FE space dofs to a vector on the
@@ -210,7 +226,8 @@ public:
    }
 
    /** Given a solution of the reduced system 'sc_sol' and the RHS 'b' for the
-       full linear system, compute the solution of the full system 'sol'. */
+       full linear system, compute the solution of the full system 'sol'. With
+       MFEM_USE_OPENMP, the element solves are performed in parallel. */
    void ComputeSolution(const Vector &b, const Vector &sc_sol,
                         Vector &sol) const;
 };
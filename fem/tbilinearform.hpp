@@ -14,6 +14,7 @@
 
 #include "../config/tconfig.hpp"
 #include "../linalg/ttensor.hpp"
+#include "../linalg/simd.hpp"
 #include "bilinearform.hpp"
 #include "tevaluator.hpp"
 #include "teltrans.hpp"
@@ -72,6 +73,18 @@ protected:
       typedef typename Spec::ElementMatrix ElementMatrix;
    };
 
+   // Types for element vectorization: each SIMD lane of vcomplex_t holds the
+   // data of a different element.
+   typedef typename NativeSIMD<complex_t>::type vcomplex_t;
+   static const int simd_size = vcomplex_t::size;
+   typedef typename integ_t::template kernel<sdim,dim,vcomplex_t>::type
+   vkernel_t;
+   typedef typename vkernel_t::template p_asm_data<qpts>::type vp_assembled_t;
+   typedef FieldEvaluator<solFESpace,solVecLayout_t,IR,
+           vcomplex_t,real_t> vsolFieldEval;
+   typedef typename vsolFieldEval::template Spec<vkernel_t,1>::DataType
+   vS_data_t;
+
    // Data members
 
    meshType      mesh;
@@ -88,6 +101,12 @@ protected:
 
    p_assembled_t *assembled_data;
 
+   // Element-vectorized copy of assembled_data, see UseElementVectorization().
+   // The data is stored in v_assembled_buf which is aligned for vcomplex_t.
+   bool elem_vect;
+   char *v_assembled_buf;
+   vp_assembled_t *v_assembled_data;
+
    const FiniteElementSpace &in_fes;
 
 public:
@@ -102,11 +121,15 @@ public:
         int_rule(),
         coeff(integ.coeff),
         assembled_data(NULL),
+        elem_vect(false),
+        v_assembled_buf(NULL),
+        v_assembled_data(NULL),
         in_fes(sol_fes)
    { }
 
    virtual ~TBilinearForm()
    {
+      delete [] v_assembled_buf;
       delete [] assembled_data;
    }
 
@@ -119,7 +142,11 @@ public:
 
    virtual void Mult(const Vector &x, Vector &y) const
    {
-      if (assembled_data)
+      if (elem_vect && v_assembled_data)
+      {
+         MultAssembledVectorized(x, y);
+      }
+      else if (assembled_data)
       {
          const int num_elem = 1;
          MultAssembled<num_elem>(x, y);
@@ -174,6 +201,16 @@ public:
       }
    }
 
+   /** @brief Enable element vectorization of the partially assembled action.
+
+       With this option, Assemble() also stores the assembled data of batches
+       of NativeSIMD<complex_t>::type::size elements in SIMD vectors, one
+       element per lane, and Mult() processes each batch with the vector
+       instructions enabled at compile time, see linalg/simd.hpp. This is
+       useful when the compiler fails to vectorize the per-element
+       contractions. Must be called before Assemble(). */
+   void UseElementVectorization(bool ev = true) { elem_vect = ev; }
+
    // Partial assembly of quadrature point data
    void Assemble()
    {
@@ -202,8 +239,93 @@ public:
             kernel_t::Assemble(k, F, wQ, res, assembled_data[el+k]);
          }
       }
+#ifdef MFEM_TEMPLATE_ENABLE_SERIALIZE
+      if (elem_vect) { VectorizeAssembledData(); }
+      else
+#endif
+      {
+         // the vectorized data of a previous Assemble() is now stale
+         delete [] v_assembled_buf;
+         v_assembled_buf = NULL;
+         v_assembled_data = NULL;
+      }
+   }
+
+#ifdef MFEM_TEMPLATE_ENABLE_SERIALIZE
+   // Copy the partially assembled data of full batches of simd_size elements
+   // into v_assembled_data.
+   // complex_t = double
+   void VectorizeAssembledData()
+   {
+      const int NB = mesh.GetNE()/simd_size;
+      if (!v_assembled_data)
+      {
+         // new[] does not guarantee the alignment required by vcomplex_t.
+         const int align = MFEM_SIMD_SIZE;
+         v_assembled_buf = new char[NB*sizeof(vp_assembled_t) + align];
+         const int offset = (align - (size_t)v_assembled_buf%align)%align;
+         v_assembled_data = (vp_assembled_t *)(v_assembled_buf + offset);
+      }
+      for (int b = 0; b < NB; b++)
+      {
+         for (int k = 0; k < simd_size; k++)
+         {
+            const p_assembled_t &A = assembled_data[b*simd_size+k];
+            for (int i = 0; i < p_assembled_t::size; i++)
+            {
+               v_assembled_data[b][i][k] = A[i];
+            }
+         }
+      }
    }
 
+   // Element-vectorized partially assembled action: batches of simd_size
+   // elements are gathered into SIMD vectors, one element per lane, and
+   // processed together. The remaining elements use MultAssembled<1>().
+   // complex_t = double
+   void MultAssembledVectorized(const Vector &x, Vector &y) const
+   {
+      y = 0.0;
+
+      solVecLayout_t solVecLayout(this->solVecLayout);
+      solFESpace solFES(this->solFES);
+      solFieldEval solFEval(this->solFES, solEval, solVecLayout,
+                            x.GetData(), y.GetData());
+      vsolFieldEval vsolFEval(this->solFES, solEval, solVecLayout, NULL, NULL);
+
+      TTensor3<dofs,vdim,1,complex_t> el_dof;
+      TTensor3<dofs,vdim,1,vcomplex_t> v_dof;
+
+      const int NE = mesh.GetNE();
+      const int bNE = NE-NE%simd_size;
+      for (int el = 0; el < bNE; el += simd_size)
+      {
+         for (int k = 0; k < simd_size; k++)
+         {
+            solFES.SetElement(el+k);
+            solFES.VectorExtract(solVecLayout, x, el_dof.layout, el_dof);
+            for (int i = 0; i < el_dof.size; i++) { v_dof[i][k] = el_dof[i]; }
+         }
+
+         vS_data_t R;
+         vsolFEval.EvalSerialized(v_dof.data, R);
+         vkernel_t::MultAssembled(0, v_assembled_data[el/simd_size], R);
+         vsolFEval.template AssembleSerialized<false>(R, v_dof.data);
+
+         for (int k = 0; k < simd_size; k++)
+         {
+            for (int i = 0; i < el_dof.size; i++) { el_dof[i] = v_dof[i][k]; }
+            solFES.SetElement(el+k);
+            solFES.VectorAssemble(el_dof.layout, el_dof, solVecLayout, y);
+         }
+      }
+      for (int el = bNE; el < NE; el++)
+      {
+         ElementAddMultAssembled<1>(el, solFEval);
+      }
+   }
+#endif // MFEM_TEMPLATE_ENABLE_SERIALIZE
+
    template <int num_elem>
    inline MFEM_ALWAYS_INLINE
    void ElementAddMultAssembled(int el, solFieldEval &solFEval) const
@@ -554,6 +554,398 @@ struct TDiffusionKernel<3,3,complex_t>
    }
 };
 
+
+// Kernels for vector finite elements: H(curl) and H(div) mass, curl-curl and
+// div-div. These kernels use the reference values of the basis functions and
+// of their derivatives (curls or divergences, stored in the "gradients" data
+// of the FieldEvaluator, see ShapeEvaluator_base) and transform them with the
+// appropriate Piola maps. The spaces must have vdim = 1 and SDim = Dim.
+//
+// Only the matrix-free and the partially assembled actions are implemented;
+// full element matrix assembly is not supported by these kernels.
+
+namespace internal
+{
+
+// Types of the pointwise transformations used by TPiolaKernel:
+// - ScalarMap:        x = (w/det(J)) x
+// - CovariantMap:     x = (w/det(J)) adj(J) adj(J)^t x
+// - ContravariantMap: x = (w/det(J)) J^t J x
+enum PiolaMapType { ScalarMap, CovariantMap, ContravariantMap };
+
+// Access to the quadrature point data, values or "gradients", with ND
+// components: d is the component and j is the vector (vdim) component.
+template <bool Values> struct PiolaData;
+
+template <> struct PiolaData<true>
+{
+   template <int ND, typename complex_t, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   complex_t &get(S_data_t &R, int i, int d, int j, int k)
+   { return R.val_qpts(i,d+ND*j,k); }
+};
+
+template <> struct PiolaData<false>
+{
+   template <int ND, typename complex_t, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   complex_t &get(S_data_t &R, int i, int d, int j, int k)
+   { return R.grad_qpts(i,d,j,k); }
+};
+
+// Common implementation of the vector finite element kernels. The pointwise
+// ND x ND symmetric matrices are stored as ND*(ND+1)/2 entries, column by
+// column: (1,1), (2,1), ..., (ND,1), (2,2), ..., (ND,ND).
+template <int SDim, int Dim, typename complex_t, int MapType, bool Values>
+struct TPiolaKernel
+{
+   typedef complex_t complex_type;
+
+   // number of components of the transformed data
+   static const int ND = (MapType == ScalarMap) ? 1 : Dim;
+   // number of stored entries per quadrature point
+   static const int NA = ND*(ND+1)/2;
+
+   // needed for the TElementTransformation::Result class
+   static const bool uses_Jacobians = true;
+
+   // needed for the FieldEvaluator::Data class
+   static const bool in_values     = Values;
+   static const bool in_gradients  = !Values;
+   static const bool out_values    = Values;
+   static const bool out_gradients = !Values;
+
+   // Partially assembled data type for one element with the given number of
+   // quadrature points. Stores one symmetric ND x ND matrix per point.
+   template <int qpts>
+   struct p_asm_data { typedef TMatrix<qpts,NA,complex_t> type; };
+
+   // Full element matrix assembly is not supported, use p_asm_data.
+   template <int qpts>
+   struct f_asm_data { typedef TMatrix<qpts,NA,complex_t> type; };
+
+   template <typename IR, typename coeff_t, int NE>
+   struct CoefficientEval
+   {
+      typedef typename IntRuleCoefficient<IR,coeff_t,NE>::Type Type;
+   };
+
+   // Compute the packed matrix at quadrature point i of element k and store it
+   // in A(ia,0), ..., A(ia,NA-1).
+   template <typename T_result_t, typename Q_t, typename q_t, typename A_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Compute(const int i, const int k, const T_result_t &F,
+                const Q_t &Q, const q_t &q, const int ia, A_t &A)
+   {
+      MFEM_STATIC_ASSERT(SDim == Dim, "SDim != Dim is not supported");
+      typedef typename T_result_t::Jt_type::data_type real_t;
+      if (MapType == ScalarMap)
+      {
+         MFEM_FLOPS_ADD(1); // TDet counts its flops
+         A(ia,0) = Q.get(q,i,k) / TDet<real_t>(F.Jt.layout.ind14(i,k), F.Jt);
+         return;
+      }
+      TMatrix<Dim,Dim,real_t> P; // P = adj(J) or P = J^t
+      real_t det;
+      if (MapType == CovariantMap)
+      {
+         det = TAdjDet<real_t>(F.Jt.layout.ind14(i,k).transpose_12(), F.Jt,
+                               P.layout, P);
+      }
+      else
+      {
+         det = TDet<real_t>(F.Jt.layout.ind14(i,k), F.Jt);
+         TAssign<AssignOp::Set>(P.layout, P, F.Jt.layout.ind14(i,k), F.Jt);
+      }
+      const complex_t u = Q.get(q,i,k) / det;
+      MFEM_FLOPS_ADD(1+NA*2*Dim);
+      for (int c = 0, s = 0; c < ND; c++)
+      {
+         for (int r = c; r < ND; r++, s++)
+         {
+            real_t PPt = P(r,0)*P(c,0);
+            for (int l = 1; l < Dim; l++) { PPt += P(r,l)*P(c,l); }
+            A(ia,s) = u * PPt;
+         }
+      }
+   }
+
+   // Apply the packed matrix A(ia,:) at quadrature point i of element k to all
+   // vector components of the data in R.
+   template <typename A_t, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Mult(const int ia, const A_t &A, const int i, const int k, S_data_t &R)
+   {
+      typedef PiolaData<Values> Data;
+      const int NC = S_data_t::eval_type::vdim;
+      MFEM_FLOPS_ADD(NC*ND*(2*ND-1));
+      for (int j = 0; j < NC; j++)
+      {
+         complex_t x[ND];
+         for (int d = 0; d < ND; d++)
+         {
+            x[d] = Data::template get<ND,complex_t>(R,i,d,j,k);
+         }
+         for (int r = 0; r < ND; r++)
+         {
+            // the entry (r,c), r >= c, is stored at c*ND-c*(c-1)/2+(r-c)
+            complex_t y = A(ia,r) * x[0];
+            for (int c = 1; c < ND; c++)
+            {
+               const int s = (r >= c) ? c*ND-(c*(c-1))/2+(r-c) :
+                             r*ND-(r*(r-1))/2+(c-r);
+               y += A(ia,s) * x[c];
+            }
+            Data::template get<ND,complex_t>(R,i,r,j,k) = y;
+         }
+      }
+   }
+
+   // Method used for un-assembled (matrix free) action.
+   // Jt   [M x Dim x SDim x NE] - Jacobian transposed, data member in F
+   // Q                          - CoefficientEval<>::Type
+   // q                          - CoefficientEval<>::Type::result_t
+   // R                          - in/out data with ND components per point
+   template <typename T_result_t, typename Q_t, typename q_t,
+             typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Action(const int k, const T_result_t &F,
+               const Q_t &Q, const q_t &q, S_data_t &R)
+   {
+      const int M = S_data_t::eval_type::qpts;
+      MFEM_STATIC_ASSERT(T_result_t::Jt_type::layout_type::dim_1 == M,
+                         "incompatible dimensions");
+      for (int i = 0; i < M; i++)
+      {
+         TMatrix<1,NA,complex_t> A;
+         Compute(i, k, F, Q, q, 0, A);
+         Mult(0, A, i, k, R);
+      }
+   }
+
+   // Method defining partial assembly.
+   // A    [M x ND*(ND+1)/2]     - partially assembled ND x ND symm. matrices
+   template <typename T_result_t, typename Q_t, typename q_t, typename asm_type>
+   static inline MFEM_ALWAYS_INLINE
+   void Assemble(const int k, const T_result_t &F,
+                 const Q_t &Q, const q_t &q, asm_type &A)
+   {
+      const int M = T_result_t::Jt_type::layout_type::dim_1;
+      MFEM_STATIC_ASSERT(asm_type::layout_type::dim_1 == M,
+                         "incompatible dimensions");
+      for (int i = 0; i < M; i++)
+      {
+         Compute(i, k, F, Q, q, i, A);
+      }
+   }
+
+   // Method for partially assembled action.
+   // A    [M x ND*(ND+1)/2]     - partially assembled ND x ND symm. matrices
+   // R                          - in/out data with ND components per point
+   template <int qpts, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void MultAssembled(const int k, const TMatrix<qpts,NA,complex_t> &A,
+                      S_data_t &R)
+   {
+      MFEM_STATIC_ASSERT(qpts == S_data_t::eval_type::qpts,
+                         "incompatible dimensions");
+      for (int i = 0; i < qpts; i++)
+      {
+         Mult(i, A, i, k, R);
+      }
+   }
+};
+
+} // namespace internal
+
+
+// H(curl) mass kernel: (Q u, v) with u, v in H(curl), cf. VectorFEMassIntegrator
+template <int SDim, int Dim, typename complex_t>
+struct THCurlMassKernel
+   : public internal::TPiolaKernel<SDim,Dim,complex_t,
+     internal::CovariantMap,true> { };
+
+// H(div) mass kernel: (Q u, v) with u, v in H(div), cf. VectorFEMassIntegrator
+template <int SDim, int Dim, typename complex_t>
+struct THDivMassKernel
+   : public internal::TPiolaKernel<SDim,Dim,complex_t,
+     internal::ContravariantMap,true> { };
+
+// Curl-curl kernel: (Q curl u, curl v), cf. CurlCurlIntegrator. In 2D the curl
+// is a scalar.
+template <int SDim, int Dim, typename complex_t>
+struct TCurlCurlKernel
+   : public internal::TPiolaKernel<SDim,Dim,complex_t,
+     (Dim == 3) ? internal::ContravariantMap : internal::ScalarMap,false> { };
+
+// Div-div kernel: (Q div u, div v), cf. DivDivIntegrator
+template <int SDim, int Dim, typename complex_t>
+struct TDivDivKernel
+   : public internal::TPiolaKernel<SDim,Dim,complex_t,
+     internal::ScalarMap,false> { };
+
+
+// Linear elasticity kernel, cf. ElasticityIntegrator:
+//    (lambda div(u), div(v)) + (2 mu e(u), e(v)),
+// where e(u) = (grad(u) + grad(u)^t)/2. The coefficient is a TCoefficientPair
+// of the Lame coefficients (lambda, mu). The space must be an H1 vector space
+// with vdim = Dim, e.g. using VectorLayout.
+template <int SDim, int Dim, typename complex_t>
+struct TElasticityKernel
+{
+   typedef complex_t complex_type;
+
+   // needed for the TElementTransformation::Result class
+   static const bool uses_Jacobians = true;
+
+   // needed for the FieldEvaluator::Data class
+   static const bool in_values     = false;
+   static const bool in_gradients  = true;
+   static const bool out_values    = false;
+   static const bool out_gradients = true;
+
+   // Number of stored entries per quadrature point: adj(J) followed by the
+   // scalars w lambda/det(J) and w mu/det(J).
+   static const int NA = Dim*Dim+2;
+
+   // Partially assembled data type for one element with the given number of
+   // quadrature points.
+   template <int qpts>
+   struct p_asm_data { typedef TMatrix<qpts,NA,complex_t> type; };
+
+   // Full element matrix assembly is not supported, use p_asm_data.
+   template <int qpts>
+   struct f_asm_data { typedef TMatrix<qpts,NA,complex_t> type; };
+
+   template <typename IR, typename coeff_t, int NE>
+   struct CoefficientEval
+   {
+      typedef typename IntRulePairCoefficient<IR,coeff_t,NE>::Type Type;
+   };
+
+   // Compute the data at quadrature point i of element k and store it in
+   // A(ia,0), ..., A(ia,NA-1); adj(J)(r,c) is stored at r+Dim*c.
+   template <typename T_result_t, typename Q_t, typename q_t, typename A_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Compute(const int i, const int k, const T_result_t &F,
+                const Q_t &Q, const q_t &q, const int ia, A_t &A)
+   {
+      MFEM_STATIC_ASSERT(SDim == Dim, "SDim != Dim is not supported");
+      typedef typename T_result_t::Jt_type::data_type real_t;
+      TMatrix<Dim,Dim,real_t> adj_J;
+      const real_t det =
+         TAdjDet<real_t>(F.Jt.layout.ind14(i,k).transpose_12(), F.Jt,
+                         adj_J.layout, adj_J);
+      MFEM_FLOPS_ADD(2);
+      for (int s = 0; s < Dim*Dim; s++) { A(ia,s) = adj_J.data[s]; }
+      A(ia,Dim*Dim)   = Q.first.get(q.first,i,k) / det;
+      A(ia,Dim*Dim+1) = Q.second.get(q.second,i,k) / det;
+   }
+
+   // With G = adj(J)^t grad_qpts (Dim x Dim), compute
+   //    grad_qpts = adj(J) [(w lambda/det(J)) tr(G) I +
+   //                        (w mu/det(J)) (G + G^t)]
+   // at quadrature point i of element k.
+   template <typename A_t, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Mult(const int ia, const A_t &A, const int i, const int k, S_data_t &R)
+   {
+      MFEM_STATIC_ASSERT(S_data_t::eval_type::vdim == Dim,
+                         "the vector dimension must be equal to Dim");
+      MFEM_FLOPS_ADD(4*Dim*Dim*Dim+3*Dim*Dim+Dim);
+      complex_t G[Dim][Dim];
+      for (int b = 0; b < Dim; b++)
+      {
+         for (int c = 0; c < Dim; c++)
+         {
+            // adj(J)(a,b) = A(ia,a+Dim*b)
+            G[b][c] = A(ia,Dim*b) * R.grad_qpts(i,0,c,k);
+            for (int a = 1; a < Dim; a++)
+            {
+               G[b][c] += A(ia,a+Dim*b) * R.grad_qpts(i,a,c,k);
+            }
+         }
+      }
+      const complex_t &wl = A(ia,Dim*Dim);
+      const complex_t &wm = A(ia,Dim*Dim+1);
+      complex_t tr = G[0][0];
+      for (int b = 1; b < Dim; b++) { tr += G[b][b]; }
+      const complex_t wl_tr = wl * tr;
+      complex_t S[Dim][Dim];
+      for (int c = 0; c < Dim; c++)
+      {
+         for (int b = 0; b < Dim; b++)
+         {
+            S[b][c] = wm * (G[b][c] + G[c][b]);
+         }
+         S[c][c] += wl_tr;
+      }
+      for (int a = 0; a < Dim; a++)
+      {
+         for (int c = 0; c < Dim; c++)
+         {
+            complex_t y = A(ia,a) * S[0][c];
+            for (int b = 1; b < Dim; b++) { y += A(ia,a+Dim*b) * S[b][c]; }
+            R.grad_qpts(i,a,c,k) = y;
+         }
+      }
+   }
+
+   // Method used for un-assembled (matrix free) action.
+   // Jt        [M x Dim x SDim x NE] - Jacobian transposed, data member in F
+   // Q                               - CoefficientEval<>::Type
+   // q                               - CoefficientEval<>::Type::result_t
+   // grad_qpts [M x Dim x Dim x NE]  - in/out data member in R
+   template <typename T_result_t, typename Q_t, typename q_t,
+             typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void Action(const int k, const T_result_t &F,
+               const Q_t &Q, const q_t &q, S_data_t &R)
+   {
+      const int M = S_data_t::eval_type::qpts;
+      MFEM_STATIC_ASSERT(T_result_t::Jt_type::layout_type::dim_1 == M,
+                         "incompatible dimensions");
+      for (int i = 0; i < M; i++)
+      {
+         TMatrix<1,NA,complex_t> A;
+         Compute(i, k, F, Q, q, 0, A);
+         Mult(0, A, i, k, R);
+      }
+   }
+
+   // Method defining partial assembly.
+   // A    [M x (Dim*Dim+2)]     - partially assembled data, see Compute()
+   template <typename T_result_t, typename Q_t, typename q_t, typename asm_type>
+   static inline MFEM_ALWAYS_INLINE
+   void Assemble(const int k, const T_result_t &F,
+                 const Q_t &Q, const q_t &q, asm_type &A)
+   {
+      const int M = T_result_t::Jt_type::layout_type::dim_1;
+      MFEM_STATIC_ASSERT(asm_type::layout_type::dim_1 == M,
+                         "incompatible dimensions");
+      for (int i = 0; i < M; i++)
+      {
+         Compute(i, k, F, Q, q, i, A);
+      }
+   }
+
+   // Method for partially assembled action.
+   // A         [M x (Dim*Dim+2)]    - partially assembled data
+   // grad_qpts [M x Dim x Dim x NE] - in/out data member in R
+   template <int qpts, typename S_data_t>
+   static inline MFEM_ALWAYS_INLINE
+   void MultAssembled(const int k, const TMatrix<qpts,NA,complex_t> &A,
+                      S_data_t &R)
+   {
+      MFEM_STATIC_ASSERT(qpts == S_data_t::eval_type::qpts,
+                         "incompatible dimensions");
+      for (int i = 0; i < qpts; i++)
+      {
+         Mult(i, A, i, k, R);
+      }
+   }
+};
+
 } // namespace mfem
 
 #endif // MFEM_TEMPLATE_BILININTEG
@@ -241,6 +241,36 @@ public:
 };
 
 
+/// Pair of coefficients, e.g. the Lame coefficients (lambda, mu) of linear
+/// elasticity. The pair is constant if both coefficients are constant.
+template <typename coeff1_t, typename coeff2_t>
+class TCoefficientPair : public TCoefficient
+{
+public:
+   static const bool is_const =
+      coeff1_t::is_const && coeff2_t::is_const;
+   static const bool uses_coordinates =
+      coeff1_t::uses_coordinates || coeff2_t::uses_coordinates;
+   static const bool uses_Jacobians =
+      coeff1_t::uses_Jacobians || coeff2_t::uses_Jacobians;
+   static const bool uses_attributes =
+      coeff1_t::uses_attributes || coeff2_t::uses_attributes;
+   static const bool uses_element_idxs =
+      coeff1_t::uses_element_idxs || coeff2_t::uses_element_idxs;
+
+   typedef coeff1_t first_type;
+   typedef coeff2_t second_type;
+   typedef typename coeff1_t::complex_type complex_type;
+
+   coeff1_t first;
+   coeff2_t second;
+
+   TCoefficientPair(const coeff1_t &c1, const coeff2_t &c2)
+      : first(c1), second(c2) { }
+   // default copy constructor
+};
+
+
 /// Auxiliary class that is used to simplify the evaluation of a coefficient and
 /// scaling it by the weights of a quadrature rule.
 template <typename IR, typename coeff_t, int NE>
@@ -321,6 +351,43 @@ struct IntRuleCoefficient
    typedef Aux<coeff_t::is_const,true> Type;
 };
 
+
+/// Auxiliary class, similar to IntRuleCoefficient, for the evaluation of a
+/// TCoefficientPair. Both coefficients are scaled by the quadrature weights.
+template <typename IR, typename coeff_pair_t, int NE>
+struct IntRulePairCoefficient
+{
+   typedef typename coeff_pair_t::complex_type complex_type;
+   typedef typename IntRuleCoefficient<
+   IR,typename coeff_pair_t::first_type,NE>::Type first_eval_t;
+   typedef typename IntRuleCoefficient<
+   IR,typename coeff_pair_t::second_type,NE>::Type second_eval_t;
+
+   struct Type
+   {
+      struct result_t
+      {
+         typename first_eval_t::result_t  first;
+         typename second_eval_t::result_t second;
+      };
+
+      first_eval_t  first;
+      second_eval_t second;
+
+      inline MFEM_ALWAYS_INLINE
+      Type(const IR &int_rule, const coeff_pair_t &c)
+         : first(int_rule, c.first), second(int_rule, c.second) { }
+
+      template <typename T_result_t>
+      inline MFEM_ALWAYS_INLINE
+      void Eval(const T_result_t &F, result_t &res)
+      {
+         first.Eval(F, res.first);
+         second.Eval(F, res.second);
+      }
+   };
+};
+
 } // namespace mfem
 
 #endif // MFEM_TEMPLATE_COEFFICIENT
@@ -36,12 +36,17 @@ public:
    static const int DOF = FE::dofs;
    static const int NIP = IR::qpts;
    static const int DIM = FE::dim;
+   // Number of components of the basis functions and of their derivatives:
+   // (1, DIM) for scalar FEs, (DIM, curl dim) for H(curl) FEs and (DIM, 1) for
+   // H(div) FEs where the "gradients" are the curls and divergences.
+   static const int RDIM = FE::range_dim;
+   static const int DDIM = FE::deriv_dim;
 
 protected:
-   TMatrix<NIP,DOF,real_t,true> B;
-   TMatrix<DOF,NIP,real_t,true> Bt;
-   TTensor3<NIP,DIM,DOF,real_t,true> G;
-   TTensor3<DOF,NIP,DIM,real_t> Gt;
+   TMatrix<NIP*RDIM,DOF,real_t,true> B;
+   TMatrix<DOF,NIP*RDIM,real_t,true> Bt;
+   TTensor3<NIP,DDIM,DOF,real_t,true> G;
+   TTensor3<DOF,NIP,DDIM,real_t> Gt;
 
 public:
    ShapeEvaluator_base(const FE &fe)
@@ -55,7 +60,7 @@ public:
    // default copy constructor
 
    // Multi-component shape evaluation from DOFs to quadrature points.
-   // dof_layout is (DOF x NumComp) and qpt_layout is (NIP x NumComp).
+   // dof_layout is (DOF x NumComp) and qpt_layout is (NIP x RDIM*NumComp).
    template <typename dof_layout_t, typename dof_data_t,
              typename qpt_layout_t, typename qpt_data_t>
    MFEM_ALWAYS_INLINE
@@ -68,16 +73,18 @@ public:
       MFEM_STATIC_ASSERT(qpt_layout_t::rank  == 2 &&
                          qpt_layout_t::dim_1 == NIP,
                          "invalid qpt_layout_t.");
-      MFEM_STATIC_ASSERT(dof_layout_t::dim_2 == qpt_layout_t::dim_2,
+      MFEM_STATIC_ASSERT(RDIM*dof_layout_t::dim_2 == qpt_layout_t::dim_2,
                          "incompatible dof- and qpt- layouts.");
+      const int NC = dof_layout_t::dim_2;
 
       Mult_AB<false>(B.layout, B,
                      dof_layout, dof_data,
-                     qpt_layout, qpt_data);
+                     qpt_layout.template split_2<RDIM,NC>().merge_12(),
+                     qpt_data);
    }
 
    // Multi-component shape evaluation transpose from quadrature points to DOFs.
-   // qpt_layout is (NIP x NumComp) and dof_layout is (DOF x NumComp).
+   // qpt_layout is (NIP x RDIM*NumComp) and dof_layout is (DOF x NumComp).
    template <bool Add,
              typename qpt_layout_t, typename qpt_data_t,
              typename dof_layout_t, typename dof_data_t>
@@ -91,16 +98,18 @@ public:
       MFEM_STATIC_ASSERT(qpt_layout_t::rank  == 2 &&
                          qpt_layout_t::dim_1 == NIP,
                          "invalid qpt_layout_t.");
-      MFEM_STATIC_ASSERT(dof_layout_t::dim_2 == qpt_layout_t::dim_2,
+      MFEM_STATIC_ASSERT(RDIM*dof_layout_t::dim_2 == qpt_layout_t::dim_2,
                          "incompatible dof- and qpt- layouts.");
+      const int NC = dof_layout_t::dim_2;
 
       Mult_AB<Add>(Bt.layout, Bt,
-                   qpt_layout, qpt_data,
+                   qpt_layout.template split_2<RDIM,NC>().merge_12(),
+                   qpt_data,
                    dof_layout, dof_data);
    }
 
    // Multi-component gradient evaluation from DOFs to quadrature points.
-   // dof_layout is (DOF x NumComp) and grad_layout is (NIP x DIM x NumComp).
+   // dof_layout is (DOF x NumComp) and grad_layout is (NIP x DDIM x NumComp).
    template <typename dof_layout_t, typename dof_data_t,
              typename grad_layout_t, typename grad_data_t>
    MFEM_ALWAYS_INLINE
@@ -114,7 +123,7 @@ public:
                          "invalid dof_layout_t.");
       MFEM_STATIC_ASSERT(grad_layout_t::rank  == 3 &&
                          grad_layout_t::dim_1 == NIP &&
-                         grad_layout_t::dim_2 == DIM,
+                         grad_layout_t::dim_2 == DDIM,
                          "invalid grad_layout_t.");
       MFEM_STATIC_ASSERT(dof_layout_t::dim_2 == grad_layout_t::dim_3,
                          "incompatible dof- and grad- layouts.");
@@ -125,7 +134,7 @@ public:
    }
 
    // Multi-component gradient evaluation transpose from quadrature points to
-   // DOFs. grad_layout is (NIP x DIM x NumComp), dof_layout is (DOF x NumComp).
+   // DOFs. grad_layout is (NIP x DDIM x NumComp), dof_layout is (DOF x NumComp).
    template <bool Add,
              typename grad_layout_t, typename grad_data_t,
              typename dof_layout_t, typename dof_data_t>
@@ -140,7 +149,7 @@ public:
                          "invalid dof_layout_t.");
       MFEM_STATIC_ASSERT(grad_layout_t::rank  == 3 &&
                          grad_layout_t::dim_1 == NIP &&
-                         grad_layout_t::dim_2 == DIM,
+                         grad_layout_t::dim_2 == DDIM,
                          "invalid grad_layout_t.");
       MFEM_STATIC_ASSERT(dof_layout_t::dim_2 == grad_layout_t::dim_3,
                          "incompatible dof- and grad- layouts.");
@@ -174,7 +183,7 @@ public:
    }
 
    // Multi-component assemble of grad-grad element matrices.
-   // qpt_layout is (NIP x DIM x DIM x NumComp), and
+   // qpt_layout is (NIP x DDIM x DDIM x NumComp), and
    // D_layout is (DOF x DOF x NumComp).
    template <typename qpt_layout_t, typename qpt_data_t,
              typename D_layout_t, typename D_data_t>
@@ -185,11 +194,11 @@ public:
                          D_data_t           &D_data) const
    {
       const int NC = qpt_layout_t::dim_4;
-      TTensor4<NIP,DIM,DOF,NC> F;
+      TTensor4<NIP,DDIM,DOF,NC> F;
       for (int k = 0; k < NC; k++)
       {
          // Next loop performs a batch of matrix-matrix products of size
-         // (DIM x DIM) x (DIM x DOF) --> (DIM x DOF)
+         // (DDIM x DDIM) x (DDIM x DOF) --> (DDIM x DOF)
          for (int j = 0; j < NIP; j++)
          {
             Mult_AB<false>(qpt_layout.ind14(j,k), qpt_data,
@@ -197,7 +206,7 @@ public:
                            F.layout.ind14(j,k), F);
          }
       }
-      // (DOF x (NIP x DIM)) x ((NIP x DIM) x DOF x NC) --> (DOF x DOF x NC)
+      // (DOF x (NIP x DDIM)) x ((NIP x DDIM) x DOF x NC) --> (DOF x DOF x NC)
       Mult_2_1<false>(Gt.layout.merge_23(), Gt,
                       F.layout.merge_12(), F,
                       D_layout, D_data);
@@ -354,7 +363,7 @@ public:
    {
       const int NC = dof_layout_t::dim_2;
       // DOF x DOF x NC --> NIP x DOF x NC --> NIP x NIP x NC
-      TTensor3<NIP,DOF,NC> A;
+      TTensor3<NIP,DOF,NC,typename qpt_data_t::data_type> A;
 
       // (1) A_{i,j,k} = \sum_s B_1d_{i,s} dof_data_{s,j,k}
       Mult_2_1<false>(B_1d.layout, Dx ? G_1d : B_1d,
@@ -386,7 +395,7 @@ public:
    {
       const int NC = dof_layout_t::dim_2;
       // NIP x NIP X NC --> NIP x DOF x NC --> DOF x DOF x NC
-      TTensor3<NIP,DOF,NC> A;
+      TTensor3<NIP,DOF,NC,typename qpt_data_t::data_type> A;
 
       // (1) A_{i,j,k} = \sum_s B_1d_{s,j} qpt_data_{i,s,k}
       Mult_1_2<false>(B_1d.layout, Dy ? G_1d : B_1d,
@@ -629,8 +638,8 @@ public:
              const qpt_layout_t &qpt_layout, qpt_data_t &qpt_data) const
    {
       const int NC = dof_layout_t::dim_2;
-      TVector<NIP*DOF*DOF*NC> QDD;
-      TVector<NIP*NIP*DOF*NC> QQD;
+      TVector<NIP*DOF*DOF*NC,typename qpt_data_t::data_type> QDD;
+      TVector<NIP*NIP*DOF*NC,typename qpt_data_t::data_type> QQD;
 
       // QDD_{i,jj,k} = \sum_s B_1d_{i,s} dof_data_{s,jj,k}
       Mult_2_1<false>(B_1d.layout, Dx ? G_1d : B_1d,
@@ -665,8 +674,8 @@ public:
               const dof_layout_t &dof_layout, dof_data_t &dof_data) const
    {
       const int NC = dof_layout_t::dim_2;
-      TVector<NIP*DOF*DOF*NC> QDD;
-      TVector<NIP*NIP*DOF*NC> QQD;
+      TVector<NIP*DOF*DOF*NC,typename qpt_data_t::data_type> QDD;
+      TVector<NIP*NIP*DOF*NC,typename qpt_data_t::data_type> QQD;
 
       // QQD_{ii,j,k} = \sum_s B_1d_{s,j} qpt_data_{ii,s,k}
       Mult_1_2<false>(B_1d.layout, Dz ? G_1d : B_1d,
@@ -996,6 +1005,10 @@ public:
    static const int dim  = FE_type::dim;
    static const int qpts = IR::qpts;
    static const int vdim = VecLayout_t::vec_dim;
+   // Number of components of the FE basis functions and of their derivatives,
+   // see ShapeEvaluator_base.
+   static const int rdim = FE_type::range_dim;
+   static const int ddim = FE_type::deriv_dim;
 
 protected:
 
@@ -1155,7 +1168,7 @@ public:
 #else
       typedef TTensor3<dofs,vdim,NE,complex_t> val_dofs_t;
 #endif
-      TTensor3<qpts,vdim,NE,complex_t>      val_qpts;
+      TTensor3<qpts,rdim*vdim,NE,complex_t> val_qpts;
    };
 
    template <int NE> struct AData<2,NE> // 2 = Gradients
@@ -1166,7 +1179,7 @@ public:
 #else
       typedef TTensor3<dofs,vdim,NE,complex_t> val_dofs_t;
 #endif
-      TTensor4<qpts,dim,vdim,NE,complex_t>      grad_qpts;
+      TTensor4<qpts,ddim,vdim,NE,complex_t>     grad_qpts;
    };
 
    template <int NE> struct AData<3,NE> // 3 = Values+Gradients
@@ -1177,8 +1190,8 @@ public:
 #else
       typedef TTensor3<dofs,vdim,NE,complex_t> val_dofs_t;
 #endif
-      TTensor3<qpts,    vdim,NE,complex_t,true>  val_qpts;
-      TTensor4<qpts,dim,vdim,NE,complex_t>      grad_qpts;
+      TTensor3<qpts,rdim*vdim,NE,complex_t,true> val_qpts;
+      TTensor4<qpts,ddim,vdim,NE,complex_t>     grad_qpts;
    };
 
    // This struct is similar to struct AData, adding separate static data
@@ -1392,7 +1405,7 @@ public:
 
    template <int NE> struct TElementMatrix<2,2,NE> // 2,2 = Gradients,Gradients
    {
-      // qpt_layout_t is (nip x dim x dim), M_layout_t is (dof x dof)
+      // qpt_layout_t is (nip x ddim x ddim), M_layout_t is (dof x dof)
       // NE = 1 is assumed
       template <typename qpt_layout_t, typename qpt_data_t,
                 typename M_layout_t, typename M_data_t>
@@ -1400,7 +1413,7 @@ public:
       void Compute(const qpt_layout_t &a, const qpt_data_t &A,
                    const M_layout_t &m, M_data_t &M, ShapeEval_type &ev)
       {
-         ev.AssembleGradGrad(a.template split_3<dim,1>(), A,
+         ev.AssembleGradGrad(a.template split_3<ddim,1>(), A,
                              m.template split_2<dofs,1>(), M);
       }
    };
@@ -88,6 +88,9 @@ public:
    static const int degree = P;
    static const int dofs   = P+1;
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = true;
    static const int  dofs_1d     = P+1;
 
@@ -152,6 +155,9 @@ public:
    static const int degree = P;
    static const int dofs   = ((P + 1)*(P + 2))/2;
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = false;
 
    // Type for run-time parameter for the constructor
@@ -205,6 +211,9 @@ public:
    static const int degree  = P;
    static const int dofs    = (P+1)*(P+1);
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = true;
    static const int dofs_1d = P+1;
 
@@ -271,6 +280,9 @@ public:
    static const int degree = P;
    static const int dofs   = ((P + 1)*(P + 2)*(P + 3))/6;
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = false;
 
    // Type for run-time parameter for the constructor
@@ -324,6 +336,9 @@ public:
    static const int degree  = P;
    static const int dofs    = (P+1)*(P+1)*(P+1);
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = true;
    static const int dofs_1d = P+1;
 
@@ -395,6 +410,9 @@ public:
    static const int degree = P;
    static const int dofs   = DOFS;
 
+   static const int range_dim = 1;   // scalar basis functions
+   static const int deriv_dim = dim; // the derivatives are gradients
+
    static const bool tensor_prod = TP;
    static const int  dofs_1d     = P+1;
 
@@ -539,6 +557,272 @@ public:
       : base_class(fec) { }
 };
 
+
+// H(curl) and H(div) finite elements
+
+template <typename real_t>
+void CalcVShapeTensor(const FiniteElement &fe, const IntegrationRule &ir,
+                      real_t *B)
+{
+   // - B must be (nip x dim x dof) with column major storage
+   int dim = fe.GetDim();
+   int nip = ir.GetNPoints();
+   int dof = fe.GetDof();
+   DenseMatrix vshape(dof, dim);
+
+   for (int ip = 0; ip < nip; ip++)
+   {
+      fe.CalcVShape(ir.IntPoint(ip), vshape);
+      for (int id = 0; id < dof; id++)
+      {
+         for (int d = 0; d < dim; d++)
+         {
+            B[ip+nip*(d+dim*id)] = vshape(id, d);
+         }
+      }
+   }
+}
+
+template <typename real_t>
+void CalcCurlShapeTensor(const FiniteElement &fe, const IntegrationRule &ir,
+                         real_t *C)
+{
+   // - C must be (nip x cdim x dof) with column major storage, where cdim is
+   //   1 in 2D and 3 in 3D
+   int cdim = (fe.GetDim() == 3) ? 3 : 1;
+   int nip = ir.GetNPoints();
+   int dof = fe.GetDof();
+   DenseMatrix curl_shape(dof, cdim);
+
+   for (int ip = 0; ip < nip; ip++)
+   {
+      fe.CalcCurlShape(ir.IntPoint(ip), curl_shape);
+      for (int id = 0; id < dof; id++)
+      {
+         for (int d = 0; d < cdim; d++)
+         {
+            C[ip+nip*(d+cdim*id)] = curl_shape(id, d);
+         }
+      }
+   }
+}
+
+template <typename real_t>
+void CalcDivShapeMatrix(const FiniteElement &fe, const IntegrationRule &ir,
+                        real_t *D)
+{
+   // - D must be (nip x dof) with column major storage
+   int nip = ir.GetNPoints();
+   int dof = fe.GetDof();
+   Vector div_shape(dof);
+
+   for (int ip = 0; ip < nip; ip++)
+   {
+      fe.CalcDivShape(ir.IntPoint(ip), div_shape);
+      for (int id = 0; id < dof; id++)
+      {
+         D[ip+nip*id] = div_shape(id);
+      }
+   }
+}
+
+// Base class for the H(curl) (Nedelec) and H(div) (Raviart-Thomas) elements.
+// The basis functions are vector-valued: CalcShapes() returns their values on
+// the reference element in B, (nip x dim x dof), and their reference curls or
+// divergences in G, (nip x deriv_dim x dof), i.e. G takes the place of the
+// gradients of the scalar elements. The Piola transformations to the physical
+// elements are applied by the integrator kernels. The tensor-product structure
+// of the basis on quadrilaterals and hexahedra is not used.
+//
+// The FiniteElement is taken from the FiniteElementCollection, so the element
+// uses the same basis types as the FiniteElementSpace it is constructed from.
+template <Geometry::Type Geom, int P, int DEG, int DOFS, int DDIM,
+          typename FEC_type>
+class VectorFiniteElement_base
+{
+public:
+   static const Geometry::Type geom = Geom;
+   static const int dim    = Geometry::Constants<Geom>::Dimension;
+   static const int degree = DEG;
+   static const int dofs   = DOFS;
+
+   static const int range_dim = dim;  // vector basis functions
+   static const int deriv_dim = DDIM; // dimension of the curls/divergences
+
+   static const bool tensor_prod = false;
+
+protected:
+   const FiniteElementCollection *my_fec; // owned, when not given
+   const FiniteElement *my_fe;
+
+   void Init(const FiniteElementCollection &fec)
+   {
+      my_fe = fec.FiniteElementForGeometry(Geom);
+      MFEM_ASSERT(my_fe && my_fe->GetDof() == DOFS,
+                  "incompatible FiniteElement");
+   }
+
+   VectorFiniteElement_base()
+   {
+      my_fec = new FEC_type(P, dim);
+      Init(*my_fec);
+   }
+
+   VectorFiniteElement_base(const FiniteElementCollection &fec)
+   {
+      MFEM_ASSERT(dynamic_cast<const FEC_type *>(&fec),
+                  "invalid FiniteElementCollection");
+      my_fec = NULL;
+      Init(fec);
+   }
+
+   ~VectorFiniteElement_base() { delete my_fec; }
+
+public:
+   template <typename real_t>
+   void CalcShapes(const IntegrationRule &ir, real_t *B, real_t *G) const
+   {
+      if (B) { mfem::CalcVShapeTensor(*my_fe, ir, B); }
+      if (G)
+      {
+         if (my_fe->GetDerivType() == FiniteElement::CURL)
+         {
+            mfem::CalcCurlShapeTensor(*my_fe, ir, G);
+         }
+         else
+         {
+            mfem::CalcDivShapeMatrix(*my_fe, ir, G);
+         }
+      }
+   }
+   const Array<int> *GetDofMap() const { return NULL; }
+};
+
+
+// H(curl) finite elements of order P, cf. ND_FECollection
+
+template <Geometry::Type G, int P>
+class ND_FiniteElement;
+
+
+template <int P>
+class ND_FiniteElement<Geometry::TRIANGLE, P>
+   : public VectorFiniteElement_base<Geometry::TRIANGLE,P,P,P*(P+2),1,
+     ND_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::TRIANGLE,P,P,P*(P+2),1,
+           ND_FECollection> base_class;
+public:
+   ND_FiniteElement() : base_class() { }
+   ND_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class ND_FiniteElement<Geometry::SQUARE, P>
+   : public VectorFiniteElement_base<Geometry::SQUARE,P,P,2*P*(P+1),1,
+     ND_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::SQUARE,P,P,2*P*(P+1),1,
+           ND_FECollection> base_class;
+public:
+   ND_FiniteElement() : base_class() { }
+   ND_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class ND_FiniteElement<Geometry::TETRAHEDRON, P>
+   : public VectorFiniteElement_base<Geometry::TETRAHEDRON,P,P,
+     (P*(P+2)*(P+3))/2,3,ND_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::TETRAHEDRON,P,P,
+           (P*(P+2)*(P+3))/2,3,ND_FECollection> base_class;
+public:
+   ND_FiniteElement() : base_class() { }
+   ND_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class ND_FiniteElement<Geometry::CUBE, P>
+   : public VectorFiniteElement_base<Geometry::CUBE,P,P,3*P*(P+1)*(P+1),3,
+     ND_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::CUBE,P,P,3*P*(P+1)*(P+1),3,
+           ND_FECollection> base_class;
+public:
+   ND_FiniteElement() : base_class() { }
+   ND_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+// H(div) finite elements, cf. RT_FECollection; as in RT_FECollection, the
+// polynomial degree of the elements is P+1.
+
+template <Geometry::Type G, int P>
+class RT_FiniteElement;
+
+
+template <int P>
+class RT_FiniteElement<Geometry::TRIANGLE, P>
+   : public VectorFiniteElement_base<Geometry::TRIANGLE,P,P+1,(P+1)*(P+3),1,
+     RT_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::TRIANGLE,P,P+1,(P+1)*(P+3),1,
+           RT_FECollection> base_class;
+public:
+   RT_FiniteElement() : base_class() { }
+   RT_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class RT_FiniteElement<Geometry::SQUARE, P>
+   : public VectorFiniteElement_base<Geometry::SQUARE,P,P+1,2*(P+1)*(P+2),1,
+     RT_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::SQUARE,P,P+1,2*(P+1)*(P+2),1,
+           RT_FECollection> base_class;
+public:
+   RT_FiniteElement() : base_class() { }
+   RT_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class RT_FiniteElement<Geometry::TETRAHEDRON, P>
+   : public VectorFiniteElement_base<Geometry::TETRAHEDRON,P,P+1,
+     ((P+1)*(P+2)*(P+4))/2,1,RT_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::TETRAHEDRON,P,P+1,
+           ((P+1)*(P+2)*(P+4))/2,1,RT_FECollection> base_class;
+public:
+   RT_FiniteElement() : base_class() { }
+   RT_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
+
+template <int P>
+class RT_FiniteElement<Geometry::CUBE, P>
+   : public VectorFiniteElement_base<Geometry::CUBE,P,P+1,
+     3*(P+1)*(P+1)*(P+2),1,RT_FECollection>
+{
+protected:
+   typedef VectorFiniteElement_base<Geometry::CUBE,P,P+1,
+           3*(P+1)*(P+1)*(P+2),1,RT_FECollection> base_class;
+public:
+   RT_FiniteElement() : base_class() { }
+   RT_FiniteElement(const FiniteElementCollection &fec) : base_class(fec) { }
+};
+
 } // namespace mfem
 
 #endif // MFEM_TEMPLATE_FINITE_ELEMENTS
@@ -470,6 +470,326 @@ public:
    }
 };
 
+
+// Index type for spaces where the element-to-dof Table can contain negative
+// dof indices, -1-dof, marking dofs with a flipped orientation, as in the
+// H(curl) and H(div) spaces. The method map() returns the global dof index and
+// sign() returns the orientation sign of the dof, 1 or -1.
+template <typename FE>
+class SignedElementDofIndexer
+{
+protected:
+   const int *el_dof_list, *loc_dof_list;
+   const double *el_dof_sign, *loc_dof_sign;
+   bool own_list;
+
+public:
+   typedef FE FE_type;
+
+   SignedElementDofIndexer(const FE &fe, const FiniteElementSpace &fes)
+   {
+      MFEM_ASSERT(fe.GetDofMap() == NULL, "local dof maps are not supported");
+      const Table &el_dof = fes.GetElementToDofTable();
+      MFEM_ASSERT(el_dof.Size_of_connections() == el_dof.Size() * FE::dofs,
+                  "the element-to-dof Table is not compatible with this FE!");
+      const int num_dofs = el_dof.Size() * FE::dofs;
+      const int *J = el_dof.GetJ();
+      int *el_dof_list_ = new int[num_dofs];
+      double *el_dof_sign_ = new double[num_dofs];
+      for (int i = 0; i < num_dofs; i++)
+      {
+         const int j = J[i];
+         el_dof_list_[i] = (j >= 0) ? j : -1-j;
+         el_dof_sign_[i] = (j >= 0) ? 1.0 : -1.0;
+      }
+      el_dof_list = loc_dof_list = el_dof_list_; // point to element 0
+      el_dof_sign = loc_dof_sign = el_dof_sign_;
+      own_list = true;
+   }
+
+   // Shallow copy constructor
+   inline MFEM_ALWAYS_INLINE
+   SignedElementDofIndexer(const SignedElementDofIndexer &orig)
+      : el_dof_list(orig.el_dof_list),
+        loc_dof_list(orig.loc_dof_list),
+        el_dof_sign(orig.el_dof_sign),
+        loc_dof_sign(orig.loc_dof_sign),
+        own_list(false)
+   { }
+
+   inline MFEM_ALWAYS_INLINE
+   ~SignedElementDofIndexer()
+   {
+      if (own_list) { delete [] el_dof_list; delete [] el_dof_sign; }
+   }
+
+   inline MFEM_ALWAYS_INLINE
+   void SetElement(int elem_idx)
+   {
+      loc_dof_list = el_dof_list + elem_idx * FE::dofs;
+      loc_dof_sign = el_dof_sign + elem_idx * FE::dofs;
+   }
+
+   inline MFEM_ALWAYS_INLINE
+   int map(int loc_dof_idx, int elem_offset) const
+   {
+      return loc_dof_list[loc_dof_idx + elem_offset * FE::dofs];
+   }
+
+   inline MFEM_ALWAYS_INLINE
+   double sign(int loc_dof_idx, int elem_offset) const
+   {
+      return loc_dof_sign[loc_dof_idx + elem_offset * FE::dofs];
+   }
+};
+
+
+// Template Finite Element Space with oriented dofs, built using a
+// SignedElementDofIndexer. The extract methods multiply the global dof values
+// by the dof signs and the assemble methods multiply the local dof values by
+// the dof signs. Used for the H(curl) and H(div) spaces.
+template <typename FE>
+class TSignedFiniteElementSpace
+{
+public:
+   typedef FE                          FE_type;
+   typedef SignedElementDofIndexer<FE> index_type;
+
+protected:
+   index_type ind;
+
+public:
+   TSignedFiniteElementSpace(const FE &fe, const FiniteElementSpace &fes)
+      : ind(fe, fes) { }
+
+   // default copy constructor
+
+   void SetElement(int el) { ind.SetElement(el); }
+
+   // Multi-element Extract: dof_layout is (DOFS x NumElems).
+   template <AssignOp::Type Op, typename glob_dof_data_t,
+             typename dof_layout_t, typename dof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void Extract(const glob_dof_data_t &glob_dof_data,
+                const dof_layout_t    &dof_layout,
+                dof_data_t            &dof_data) const
+   {
+      const int NE = dof_layout_t::dim_2;
+      MFEM_STATIC_ASSERT(FE::dofs == dof_layout_t::dim_1,
+                         "invalid number of dofs");
+      for (int j = 0; j < NE; j++)
+      {
+         for (int i = 0; i < FE::dofs; i++)
+         {
+            Assign<Op>(dof_data[dof_layout.ind(i,j)],
+                       ind.sign(i,j)*glob_dof_data[ind.map(i,j)]);
+         }
+      }
+   }
+
+   template <typename glob_dof_data_t,
+             typename dof_layout_t, typename dof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void Extract(const glob_dof_data_t &glob_dof_data,
+                const dof_layout_t    &dof_layout,
+                dof_data_t            &dof_data) const
+   {
+      Extract<AssignOp::Set>(glob_dof_data, dof_layout, dof_data);
+   }
+
+   // Multi-element assemble.
+   template <AssignOp::Type Op,
+             typename dof_layout_t, typename dof_data_t,
+             typename glob_dof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void Assemble(const dof_layout_t &dof_layout,
+                 const dof_data_t   &dof_data,
+                 glob_dof_data_t    &glob_dof_data) const
+   {
+      const int NE = dof_layout_t::dim_2;
+      MFEM_STATIC_ASSERT(FE::dofs == dof_layout_t::dim_1,
+                         "invalid number of dofs");
+      for (int j = 0; j < NE; j++)
+      {
+         for (int i = 0; i < FE::dofs; i++)
+         {
+            Assign<Op>(glob_dof_data[ind.map(i,j)],
+                       ind.sign(i,j)*dof_data[dof_layout.ind(i,j)]);
+         }
+      }
+   }
+
+   template <typename dof_layout_t, typename dof_data_t,
+             typename glob_dof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void Assemble(const dof_layout_t &dof_layout,
+                 const dof_data_t   &dof_data,
+                 glob_dof_data_t    &glob_dof_data) const
+   {
+      Assemble<AssignOp::Add>(dof_layout, dof_data, glob_dof_data);
+   }
+
+   // Multi-element VectorExtract: vdof_layout is (DOFS x NumComp x NumElems).
+   template <AssignOp::Type Op,
+             typename vec_layout_t, typename glob_vdof_data_t,
+             typename vdof_layout_t, typename vdof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void VectorExtract(const vec_layout_t     &vl,
+                      const glob_vdof_data_t &glob_vdof_data,
+                      const vdof_layout_t    &vdof_layout,
+                      vdof_data_t            &vdof_data) const
+   {
+      const int NC = vdof_layout_t::dim_2;
+      const int NE = vdof_layout_t::dim_3;
+      MFEM_STATIC_ASSERT(FE::dofs == vdof_layout_t::dim_1,
+                         "invalid number of dofs");
+      MFEM_ASSERT(NC == vl.NumComponents(), "invalid number of components");
+      for (int k = 0; k < NC; k++)
+      {
+         for (int j = 0; j < NE; j++)
+         {
+            for (int i = 0; i < FE::dofs; i++)
+            {
+               Assign<Op>(vdof_data[vdof_layout.ind(i,k,j)],
+                          ind.sign(i,j)*
+                          glob_vdof_data[vl.ind(ind.map(i,j), k)]);
+            }
+         }
+      }
+   }
+
+   template <typename vec_layout_t, typename glob_vdof_data_t,
+             typename vdof_layout_t, typename vdof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void VectorExtract(const vec_layout_t     &vl,
+                      const glob_vdof_data_t &glob_vdof_data,
+                      const vdof_layout_t    &vdof_layout,
+                      vdof_data_t            &vdof_data) const
+   {
+      VectorExtract<AssignOp::Set>(vl, glob_vdof_data, vdof_layout, vdof_data);
+   }
+
+   // Multi-element VectorAssemble: vdof_layout is (DOFS x NumComp x NumElems).
+   template <AssignOp::Type Op,
+             typename vdof_layout_t, typename vdof_data_t,
+             typename vec_layout_t, typename glob_vdof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void VectorAssemble(const vdof_layout_t &vdof_layout,
+                       const vdof_data_t   &vdof_data,
+                       const vec_layout_t  &vl,
+                       glob_vdof_data_t    &glob_vdof_data) const
+   {
+      const int NC = vdof_layout_t::dim_2;
+      const int NE = vdof_layout_t::dim_3;
+      MFEM_STATIC_ASSERT(FE::dofs == vdof_layout_t::dim_1,
+                         "invalid number of dofs");
+      MFEM_ASSERT(NC == vl.NumComponents(), "invalid number of components");
+      for (int k = 0; k < NC; k++)
+      {
+         for (int j = 0; j < NE; j++)
+         {
+            for (int i = 0; i < FE::dofs; i++)
+            {
+               Assign<Op>(glob_vdof_data[vl.ind(ind.map(i,j), k)],
+                          ind.sign(i,j)*vdof_data[vdof_layout.ind(i,k,j)]);
+            }
+         }
+      }
+   }
+
+   template <typename vdof_layout_t, typename vdof_data_t,
+             typename vec_layout_t, typename glob_vdof_data_t>
+   inline MFEM_ALWAYS_INLINE
+   void VectorAssemble(const vdof_layout_t &vdof_layout,
+                       const vdof_data_t   &vdof_data,
+                       const vec_layout_t  &vl,
+                       glob_vdof_data_t    &glob_vdof_data) const
+   {
+      VectorAssemble<AssignOp::Add>(vdof_layout, vdof_data, vl, glob_vdof_data);
+   }
+
+   void Assemble(const TMatrix<FE::dofs,FE::dofs,double> &m,
+                 SparseMatrix &M) const
+   {
+      MFEM_FLOPS_ADD(3*FE::dofs*FE::dofs);
+      for (int i = 0; i < FE::dofs; i++)
+      {
+         M.SetColPtr(ind.map(i,0));
+         for (int j = 0; j < FE::dofs; j++)
+         {
+            M._Add_(ind.map(j,0), ind.sign(i,0)*ind.sign(j,0)*m(i,j));
+         }
+         M.ClearColPtr();
+      }
+   }
+};
+
+// H(curl) Finite Element Space
+
+template <typename FE>
+class ND_FiniteElementSpace : public TSignedFiniteElementSpace<FE>
+{
+public:
+   typedef FE FE_type;
+   typedef TSignedFiniteElementSpace<FE> base_class;
+
+   ND_FiniteElementSpace(const FE &fe, const FiniteElementSpace &fes)
+      : base_class(fe, fes)
+   { }
+
+   // default copy constructor
+
+   static bool Matches(const FiniteElementSpace &fes)
+   {
+      const FiniteElementCollection *fec = fes.FEColl();
+      const ND_FECollection *nd_fec =
+         dynamic_cast<const ND_FECollection *>(fec);
+      if (!nd_fec) { return false; }
+      const FiniteElement *fe = nd_fec->FiniteElementForGeometry(FE_type::geom);
+      if (fe->GetOrder() != FE_type::degree) { return false; }
+      return true;
+   }
+
+   template <typename vec_layout_t>
+   static bool VectorMatches(const FiniteElementSpace &fes)
+   {
+      return Matches(fes) && vec_layout_t::Matches(fes);
+   }
+};
+
+// H(div) Finite Element Space
+
+template <typename FE>
+class RT_FiniteElementSpace : public TSignedFiniteElementSpace<FE>
+{
+public:
+   typedef FE FE_type;
+   typedef TSignedFiniteElementSpace<FE> base_class;
+
+   RT_FiniteElementSpace(const FE &fe, const FiniteElementSpace &fes)
+      : base_class(fe, fes)
+   { }
+
+   // default copy constructor
+
+   static bool Matches(const FiniteElementSpace &fes)
+   {
+      const FiniteElementCollection *fec = fes.FEColl();
+      const RT_FECollection *rt_fec =
+         dynamic_cast<const RT_FECollection *>(fec);
+      if (!rt_fec) { return false; }
+      const FiniteElement *fe = rt_fec->FiniteElementForGeometry(FE_type::geom);
+      if (fe->GetOrder() != FE_type::degree) { return false; }
+      return true;
+   }
+
+   template <typename vec_layout_t>
+   static bool VectorMatches(const FiniteElementSpace &fes)
+   {
+      return Matches(fes) && vec_layout_t::Matches(fes);
+   }
+};
+
 } // namespace mfem
 
 #endif // MFEM_TEMPLATE_FESPACE
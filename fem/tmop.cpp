@@ -802,6 +802,38 @@ void TargetConstructor::ComputeAvgVolume() const
 #endif
 }
 
+void TargetConstructor::ResetTargetCache() const
+{
+   cached_Jtr.Clear();
+   cached_offsets.DeleteAll();
+   cached_ir.DeleteAll();
+}
+
+TargetConstructor *TargetConstructor::Clone() const
+{
+   // Compute the average volume before copying it, so that the copies do not
+   // compute it again.
+   if (target_type == IDEAL_SHAPE_EQUAL_SIZE && nodes && avg_volume == 0.0)
+   {
+      ComputeAvgVolume();
+   }
+
+#ifdef MFEM_USE_MPI
+   TargetConstructor *tc = new TargetConstructor(target_type, comm);
+#else
+   TargetConstructor *tc = new TargetConstructor(target_type);
+#endif
+   tc->nodes = nodes;
+   tc->avg_volume = avg_volume;
+   tc->volume_scale = volume_scale;
+   tc->cache_targets = cache_targets;
+   tc->cached_Jtr.UseExternalData(cached_Jtr.Data(), cached_Jtr.SizeI(),
+                                  cached_Jtr.SizeJ(), cached_Jtr.SizeK());
+   tc->cached_offsets.MakeRef(cached_offsets);
+   tc->cached_ir.MakeRef(cached_ir);
+   return tc;
+}
+
 // virtual method
 void TargetConstructor::ComputeElementTargets(int e_id, const FiniteElement &fe,
                                               const IntegrationRule &ir,
@@ -809,6 +841,16 @@ void TargetConstructor::ComputeElementTargets(int e_id, const FiniteElement &fe,
 {
    MFEM_ASSERT(target_type == IDEAL_SHAPE_UNIT_SIZE || nodes != NULL, "");
 
+   if (UsesTargetCache() && e_id < cached_ir.Size() && cached_ir[e_id] == &ir)
+   {
+      const int offset = cached_offsets[e_id];
+      MFEM_ASSERT(cached_Jtr.SizeI() == Jtr.SizeI() &&
+                  cached_offsets[e_id+1] - offset == Jtr.SizeK(), "");
+      std::memcpy(Jtr.Data(), cached_Jtr.GetData(offset),
+                  sizeof(double) * Jtr.SizeI() * Jtr.SizeJ() * Jtr.SizeK());
+      return;
+   }
+
    const FiniteElement *nfe = (target_type != IDEAL_SHAPE_UNIT_SIZE) ?
                               nodes->FESpace()->GetFE(e_id) : NULL;
    const DenseMatrix &Wideal =
@@ -864,6 +906,19 @@ void TargetConstructor::ComputeElementTargets(int e_id, const FiniteElement &fe,
    }
 }
 
+TMOP_Integrator::~TMOP_Integrator()
+{
+   if (is_clone)
+   {
+      delete metric;
+      delete targetC;
+   }
+   else
+   {
+      delete lim_func;
+   }
+}
+
 void TMOP_Integrator::EnableLimiting(const GridFunction &n0,
                                      const GridFunction &dist, Coefficient &w0,
                                      TMOP_LimiterFunction *lfunc)
@@ -913,11 +968,7 @@ double TMOP_Integrator::GetElementEnergy(const FiniteElement &el,
    Jpt.SetSize(dim);
    PMatI.UseExternalData(elfun.GetData(), dof, dim);
 
-   const IntegrationRule *ir = IntRule;
-   if (!ir)
-   {
-      ir = &(IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3)); // <---
-   }
+   const IntegrationRule *ir = &GetIntegrationRule(el);
 
    energy = 0.0;
    DenseTensor Jtr(dim, dim, ir->GetNPoints());
@@ -1008,11 +1059,7 @@ void TMOP_Integrator::AssembleElementVector(const FiniteElement &el,
    elvect.SetSize(dof*dim);
    PMatO.UseExternalData(elvect.GetData(), dof, dim);
 
-   const IntegrationRule *ir = IntRule;
-   if (!ir)
-   {
-      ir = &(IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3)); // <---
-   }
+   const IntegrationRule *ir = &GetIntegrationRule(el);
 
    elvect = 0.0;
    DenseTensor Jtr(dim, dim, ir->GetNPoints());
@@ -1099,11 +1146,7 @@ void TMOP_Integrator::AssembleElementGrad(const FiniteElement &el,
    PMatI.UseExternalData(elfun.GetData(), dof, dim);
    elmat.SetSize(dof*dim);
 
-   const IntegrationRule *ir = IntRule;
-   if (!ir)
-   {
-      ir = &(IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3)); // <---
-   }
+   const IntegrationRule *ir = &GetIntegrationRule(el);
 
    elmat = 0.0;
    DenseTensor Jtr(dim, dim, ir->GetNPoints());
@@ -1187,6 +1230,29 @@ void TMOP_Integrator::AssembleElementGrad(const FiniteElement &el,
    delete Tpr;
 }
 
+NonlinearFormIntegrator *TMOP_Integrator::Clone() const
+{
+   TMOP_QualityMetric *m = metric->Clone();
+   TargetConstructor *tc = targetC->Clone();
+   if (!m || !tc)
+   {
+      delete m;
+      delete tc;
+      return NULL;
+   }
+   TMOP_Integrator *integ = new TMOP_Integrator(m, tc);
+   integ->is_clone = true;
+   integ->SetIntRule(IntRule);
+   integ->coeff1 = coeff1;
+   integ->metric_normal = metric_normal;
+   integ->nodes0 = nodes0;
+   integ->coeff0 = coeff0;
+   integ->lim_dist = lim_dist;
+   integ->lim_func = lim_func;
+   integ->lim_normal = lim_normal;
+   return integ;
+}
+
 void TMOP_Integrator::EnableNormalization(const GridFunction &x)
 {
    ComputeNormalizationEnergies(x, metric_normal, lim_normal);
@@ -1221,11 +1287,7 @@ void TMOP_Integrator::ComputeNormalizationEnergies(const GridFunction &x,
    Jpr.SetSize(dim);
    Jpt.SetSize(dim);
 
-   const IntegrationRule *ir = IntRule;
-   if (!ir)
-   {
-      ir = &(IntRules.Get(fe->GetGeomType(), 2*fe->GetOrder() + 3)); // <---
-   }
+   const IntegrationRule *ir = &GetIntegrationRule(*fe);
 
    DenseTensor Jtr(dim, dim, ir->GetNPoints());
 
@@ -1256,6 +1318,44 @@ void TMOP_Integrator::ComputeNormalizationEnergies(const GridFunction &x,
    }
 }
 
+void TMOP_Integrator::PrecomputeTargets(const FiniteElementSpace &fes)
+{
+   if (!targetC->UsesTargetCache()) { return; }
+
+   const int NE = fes.GetNE();
+   MFEM_VERIFY(targetC->nodes->FESpace()->GetNE() == NE,
+               "the target nodes and the given space do not match");
+
+   // Get the rules (IntRules.Get() may modify the global rule tables) and the
+   // offsets of the elements in the cache before the threaded loop. The rules
+   // are set after the loop, so ComputeElementTargets() does not read from
+   // the cache while it is being filled.
+   targetC->ResetTargetCache();
+   Array<const IntegrationRule *> irs(NE);
+   Array<int> &offsets = targetC->cached_offsets;
+   offsets.SetSize(NE + 1);
+   offsets[0] = 0;
+   for (int e = 0; e < NE; e++)
+   {
+      irs[e] = &GetIntegrationRule(*fes.GetFE(e));
+      offsets[e+1] = offsets[e] + irs[e]->GetNPoints();
+   }
+   const int dim = fes.GetMesh()->Dimension();
+   targetC->cached_Jtr.SetSize(dim, dim, offsets[NE]);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int e = 0; e < NE; e++)
+   {
+      DenseTensor Jtr;
+      Jtr.UseExternalData(targetC->cached_Jtr.GetData(offsets[e]), dim, dim,
+                          offsets[e+1] - offsets[e]);
+      targetC->ComputeElementTargets(e, *fes.GetFE(e), *irs[e], Jtr);
+   }
+   irs.Copy(targetC->cached_ir);
+}
+
 void InterpolateTMOP_QualityMetric(TMOP_QualityMetric &metric,
                                    const TargetConstructor &tc,
                                    const Mesh &mesh, GridFunction &metric_gf)
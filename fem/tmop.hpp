@@ -43,6 +43,12 @@ public:
        Jpt. */
    void SetTargetJacobian(const DenseMatrix &_Jtr) { Jtr = &_Jtr; }
 
+   /** @brief Return a new metric of the same type and with the same
+       parameters, or NULL if the metric cannot be copied. */
+   /** Used by TMOP_Integrator::Clone(). The default implementation returns
+       NULL. */
+   virtual TMOP_QualityMetric *Clone() const { return NULL; }
+
    /** @brief Evaluate the strain energy density function, W = W(Jpt).
        @param[in] Jpt  Represents the target->physical transformation
                        Jacobian matrix. */
@@ -79,6 +85,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_001; }
+
    // W = |J|^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -92,6 +101,9 @@ public:
 class TMOP_Metric_skew2D : public TMOP_QualityMetric
 {
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_skew2D; }
+
    // W = 0.5 (1 - cos(angle_Jpr - angle_Jtr)).
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -107,6 +119,9 @@ public:
 class TMOP_Metric_skew3D : public TMOP_QualityMetric
 {
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_skew3D; }
+
    // W = 1/6 (3 - sum_i cos(angle_Jpr_i - angle_Jtr_i)), i = 1..3.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -122,6 +137,9 @@ public:
 class TMOP_Metric_aspratio2D : public TMOP_QualityMetric
 {
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_aspratio2D; }
+
    // W = 0.5 (ar_Jpr/ar_Jtr + ar_Jtr/ar_Jpr) - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -137,6 +155,9 @@ public:
 class TMOP_Metric_aspratio3D : public TMOP_QualityMetric
 {
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_aspratio3D; }
+
    // W = 1/3 sum [0.5 (ar_Jpr_i/ar_Jtr_i + ar_Jtr_i/ar_Jpr_i) - 1], i = 1..3.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -155,6 +176,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_002; }
+
    // W = 0.5|J|^2 / det(J) - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -171,6 +195,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_007; }
+
    // W = |J - J^-t|^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -187,6 +214,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_009; }
+
    // W = det(J) * |J - J^-t|^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -206,6 +236,9 @@ protected:
 public:
    TMOP_Metric_022(double &t0): tau0(t0) {}
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_022(tau0); }
+
    // W = 0.5(|J|^2 - 2det(J)) / (det(J) - tau0).
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -222,6 +255,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_050; }
+
    // W = 0.5|J^t J|^2 / det(J)^2 - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -238,6 +274,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_055; }
+
    // W = (det(J) - 1)^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -255,6 +294,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_056; }
+
    // W = 0.5( sqrt(det(J)) - 1 / sqrt(det(J)) )^2
    //   = 0.5( det(J) - 1 )^2 / det(J)
    //   = 0.5( det(J) + 1/det(J) ) - 1.
@@ -274,6 +316,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_058; }
+
    // W = |J^t J|^2 / det(J)^2 - 2|J|^2 / det(J) + 2
    //   = I1b (I1b - 2).
    virtual double EvalW(const DenseMatrix &Jpt) const;
@@ -292,6 +337,9 @@ protected:
    mutable InvariantsEvaluator2D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_077; }
+
    // W = 0.5(det(J) - 1 / det(J))^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -312,6 +360,9 @@ protected:
 public:
    TMOP_Metric_211(double epsilon = 1e-4) : eps(epsilon) { }
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_211(eps); }
+
    // W = (det(J) - 1)^2 - det(J) + sqrt(det(J)^2 + eps).
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -332,6 +383,9 @@ public:
    /// Note that @a t0 is stored by reference
    TMOP_Metric_252(double &t0): tau0(t0) {}
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_252(tau0); }
+
    // W = 0.5(det(J) - 1)^2 / (det(J) - tau0).
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -348,6 +402,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_301; }
+
    // W = |J| |J^-1| / 3 - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -364,6 +421,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_302; }
+
    // W = |J|^2 |J^-1|^2 / 9 - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -380,6 +440,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_303; }
+
    // W = |J|^2 / 3 * det(J)^(2/3) - 1.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -396,6 +459,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_315; }
+
    // W = (det(J) - 1)^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -412,6 +478,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_316; }
+
    // W = 0.5( sqrt(det(J)) - 1 / sqrt(det(J)) )^2
    //   = 0.5( det(J) - 1 )^2 / det(J)
    //   = 0.5( det(J) + 1/det(J) ) - 1.
@@ -430,6 +499,9 @@ protected:
    mutable InvariantsEvaluator3D<double> ie;
 
 public:
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_321; }
+
    // W = |J - J^-t|^2.
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -449,6 +521,9 @@ protected:
 public:
    TMOP_Metric_352(double &t0): tau0(t0) {}
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_352(tau0); }
+
    // W = 0.5(det(J) - 1)^2 / (det(J) - tau0).
    virtual double EvalW(const DenseMatrix &Jpt) const;
 
@@ -550,6 +625,16 @@ protected:
    double volume_scale;
    const TargetType target_type;
 
+   // Cached target Jacobians for the target types that depend on the shape of
+   // the given nodes, see EnableTargetCaching(). The matrices of all elements
+   // are stored contiguously in cached_Jtr: those of element e start at index
+   // cached_offsets[e] and were computed with the rule cached_ir[e]. The cache
+   // is empty until TMOP_Integrator::PrecomputeTargets() fills it.
+   bool cache_targets;
+   mutable DenseTensor cached_Jtr;
+   mutable Array<int> cached_offsets;
+   mutable Array<const IntegrationRule *> cached_ir;
+
 #ifdef MFEM_USE_MPI
    MPI_Comm comm;
    bool Parallel() const { return (comm != MPI_COMM_NULL); }
@@ -561,10 +646,20 @@ protected:
    // computed yet
    void ComputeAvgVolume() const;
 
+   // Returns true if ComputeElementTargets() stores its results in the cache.
+   bool UsesTargetCache() const
+   {
+      return cache_targets && (target_type == IDEAL_SHAPE_GIVEN_SIZE ||
+                               target_type == GIVEN_SHAPE_AND_SIZE);
+   }
+
+   friend class TMOP_Integrator;
+
 public:
    /// Constructor for use in serial
    TargetConstructor(TargetType ttype)
-      : nodes(NULL), avg_volume(), volume_scale(1.0), target_type(ttype)
+      : nodes(NULL), avg_volume(), volume_scale(1.0), target_type(ttype),
+        cache_targets(false)
    {
 #ifdef MFEM_USE_MPI
       comm = MPI_COMM_NULL;
@@ -574,7 +669,7 @@ public:
    /// Constructor for use in parallel
    TargetConstructor(TargetType ttype, MPI_Comm mpicomm)
       : nodes(NULL), avg_volume(), volume_scale(1.0), target_type(ttype),
-        comm(mpicomm) { }
+        cache_targets(false), comm(mpicomm) { }
 #endif
    virtual ~TargetConstructor() { }
 
@@ -582,12 +677,39 @@ public:
 
        This method should be called every time the target nodes are updated
        externally and recomputation of the target average volume is needed. The
-       nodes are used by all target types except IDEAL_SHAPE_UNIT_SIZE. */
-   void SetNodes(const GridFunction &n) { nodes = &n; avg_volume = 0.0; }
+       nodes are used by all target types except IDEAL_SHAPE_UNIT_SIZE. The
+       target cache, if enabled, is reset. */
+   void SetNodes(const GridFunction &n)
+   { nodes = &n; avg_volume = 0.0; ResetTargetCache(); }
 
    /// Used by target type IDEAL_SHAPE_EQUAL_SIZE. The default volume scale is 1.
    void SetVolumeScale(double vol_scale) { volume_scale = vol_scale; }
 
+   /** @brief Enable (or disable) the caching of the target matrices computed
+       by ComputeElementTargets().
+
+       The target matrices do not depend on the current mesh positions, so the
+       repeated energy, residual and gradient evaluations of a Newton solver
+       and its line search can reuse them. Only the target types
+       IDEAL_SHAPE_GIVEN_SIZE and GIVEN_SHAPE_AND_SIZE, which evaluate the
+       given nodes at every quadrature point, use the cache. The cache is
+       filled by TMOP_Integrator::PrecomputeTargets() and stores one dim x dim
+       matrix per quadrature point of every element, in one block. If the
+       target nodes are modified in place, ResetTargetCache() or SetNodes()
+       must be called, followed by PrecomputeTargets(). */
+   void EnableTargetCaching(bool enable = true)
+   { cache_targets = enable; if (!enable) { ResetTargetCache(); } }
+
+   /// Delete all cached target matrices, see EnableTargetCaching().
+   void ResetTargetCache() const;
+
+   /** @brief Return a new TargetConstructor with the same target type, nodes
+       and parameters, or NULL if it cannot be copied. */
+   /** Used by TMOP_Integrator::Clone(). The copy uses the target cache of the
+       original, so it must be deleted before the cache is reset. Derived
+       classes that add data must override this method. */
+   virtual TargetConstructor *Clone() const;
+
    /** @brief Given an element and quadrature rule, computes ref->target
        transformation Jacobians for each quadrature point in the element. */
    virtual void ComputeElementTargets(int e_id, const FiniteElement &fe,
@@ -595,6 +717,7 @@ public:
                                       DenseTensor &Jtr) const;
 };
 
+class FiniteElementSpace;
 class ParGridFunction;
 
 /** @brief A TMOP integrator class based on any given TMOP_QualityMetric and
@@ -627,6 +750,10 @@ protected:
    // Normalization factor for the limiting term.
    double lim_normal;
 
+   // Set in the copies made by Clone(): they own their metric and target
+   // constructor, and share the limiting function of the original.
+   bool is_clone;
+
    //   Jrt: the inverse of the ref->target Jacobian, Jrt = Jtr^{-1}.
    //   Jpr: the ref->physical transformation Jacobian, Jpr = PMatI^t DS.
    //   Jpt: the target->physical transformation Jacobian, Jpt = Jpr Jrt.
@@ -639,6 +766,12 @@ protected:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   const IntegrationRule &GetIntegrationRule(const FiniteElement &el) const
+   {
+      if (IntRule) { return *IntRule; }
+      return IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3); // <---
+   }
+
    void ComputeNormalizationEnergies(const GridFunction &x,
                                      double &metric_energy, double &lim_energy);
 
@@ -649,10 +782,10 @@ public:
       : metric(m), targetC(tc),
         coeff1(NULL), metric_normal(1.0),
         nodes0(NULL), coeff0(NULL),
-        lim_dist(NULL), lim_func(NULL), lim_normal(1.0)
+        lim_dist(NULL), lim_func(NULL), lim_normal(1.0), is_clone(false)
    { }
 
-   ~TMOP_Integrator() { delete lim_func; }
+   ~TMOP_Integrator();
 
    /// Sets a scaling Coefficient for the quality metric term of the integrator.
    /** With this addition, the integrator becomes
@@ -700,12 +833,27 @@ public:
                                     ElementTransformation &T,
                                     const Vector &elfun, DenseMatrix &elmat);
 
+   /** @brief Return a copy of the integrator with its own copies of the metric
+       and the TargetConstructor, or NULL if one of them cannot be copied. */
+   /** The copy shares the Coefficient%s, the limiting nodes and distances and
+       the TMOP_LimiterFunction of the original. */
+   virtual NonlinearFormIntegrator *Clone() const;
+
    /** @brief Computes the normalization factors of the metric and limiting
        integrals using the mesh position given by @a x. */
    void EnableNormalization(const GridFunction &x);
 #ifdef MFEM_USE_MPI
    void ParEnableNormalization(const ParGridFunction &x);
 #endif
+
+   /** @brief Fill the target cache of the TargetConstructor for all elements
+       of @a fes, see TargetConstructor::EnableTargetCaching().
+
+       The element loop is threaded when MFEM is built with OpenMP. Without
+       this call the targets are computed in every evaluation of the energy,
+       residual or gradient. Does nothing if the TargetConstructor does not
+       use the cache. */
+   void PrecomputeTargets(const FiniteElementSpace &fes);
 };
 
 
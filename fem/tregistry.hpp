@@ -0,0 +1,252 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_TEMPLATE_REGISTRY
+#define MFEM_TEMPLATE_REGISTRY
+
+#include "../config/tconfig.hpp"
+#include "../mesh/tmesh.hpp"
+#include "tintrules.hpp"
+#include "tfe.hpp"
+#include "tfespace.hpp"
+#include "tcoefficient.hpp"
+#include "tbilininteg.hpp"
+#include "tbilinearform.hpp"
+#include "bilinearform.hpp"
+#include <map>
+
+namespace mfem
+{
+
+/** @brief Run-time registry of pre-instantiated templated bilinear forms.
+
+    The type of a TBilinearForm fixes the element geometry, the order of the
+    mesh nodes, the order of the solution space and the quadrature rule at
+    compile time. This class maps a run-time description of a form - the
+    kernel and the above parameters, obtained from a FiniteElementSpace - to a
+    function creating the matching partially assembled TBilinearForm.
+
+    The combinations are added with Register(). RegisterDefaults() adds the
+    mass and diffusion kernels on quadrilaterals and hexahedra, with mesh nodes
+    of order 1 and 2, solution orders 1 to 4 and the quadrature order
+    2*order+dim-1; Default() returns a global registry with these combinations.
+    Since the TBilinearForm types are instantiated where Register() is called,
+    this header is not included by mfem-performance.hpp.
+
+    Only scalar H1 spaces with a constant coefficient are supported. The mesh
+    must have nodes in a (vector) H1 space ordered byNODES, see
+    Mesh::SetCurvature(). */
+class TBilinearFormRegistry
+{
+public:
+   /// Kernels supported by the registry
+   enum KernelType { Mass, Diffusion };
+
+   /** @brief Function creating a TBilinearForm with the given constant
+       coefficient on @a fes. Returns NULL if the type of the form does not
+       match @a fes. */
+   typedef Operator *(*CreateFunction)(double coeff,
+                                       const FiniteElementSpace &fes);
+
+protected:
+   struct Key
+   {
+      int kernel, geom, mesh_order, order, ir_order;
+
+      Key(int k, int g, int mo, int o, int iro)
+         : kernel(k), geom(g), mesh_order(mo), order(o), ir_order(iro) { }
+
+      bool operator<(const Key &k) const
+      {
+         if (kernel != k.kernel) { return kernel < k.kernel; }
+         if (geom != k.geom) { return geom < k.geom; }
+         if (mesh_order != k.mesh_order) { return mesh_order < k.mesh_order; }
+         if (order != k.order) { return order < k.order; }
+         return ir_order < k.ir_order;
+      }
+   };
+
+   std::map<Key,CreateFunction> creators;
+
+   // BilinearForm owning the coefficient of its integrator, see
+   // CreateOrFallback().
+   class FallbackForm : public BilinearForm
+   {
+   public:
+      ConstantCoefficient coeff;
+
+      FallbackForm(FiniteElementSpace &fes, double c)
+         : BilinearForm(&fes), coeff(c) { }
+   };
+
+   // On tensor-product geometries the Gauss-Legendre rules of orders 2n-2 and
+   // 2n-1 are the same, use the odd order in the keys.
+   static int KeyOrder(int geom, int ir_order)
+   {
+      const bool tensor = (geom == Geometry::SEGMENT ||
+                           geom == Geometry::SQUARE ||
+                           geom == Geometry::CUBE);
+      return tensor ? 2*(ir_order/2)+1 : ir_order;
+   }
+
+   template <KernelType kernel, bool dummy> struct Kernel;
+
+   template <bool dummy> struct Kernel<Mass,dummy>
+   {
+      template <int SDim, int Dim, typename complex_t>
+      struct type : public TMassKernel<SDim,Dim,complex_t> { };
+   };
+
+   template <bool dummy> struct Kernel<Diffusion,dummy>
+   {
+      template <int SDim, int Dim, typename complex_t>
+      struct type : public TDiffusionKernel<SDim,Dim,complex_t> { };
+   };
+
+   template <KernelType kernel, Geometry::Type geom, int mesh_p, int sol_p,
+             int ir_order>
+   static Operator *CreateForm(double coeff, const FiniteElementSpace &fes)
+   {
+      typedef H1_FiniteElement<geom,mesh_p>            mesh_fe_t;
+      typedef TMesh<H1_FiniteElementSpace<mesh_fe_t> > mesh_t;
+      typedef H1_FiniteElementSpace<H1_FiniteElement<geom,sol_p> > sol_fes_t;
+      typedef TIntegrationRule<geom,ir_order>          int_rule_t;
+      typedef TConstantCoefficient<>                   coeff_t;
+      typedef TIntegrator<coeff_t,Kernel<kernel,true>::template type> integ_t;
+      typedef TBilinearForm<mesh_t,sol_fes_t,int_rule_t,integ_t> form_t;
+
+      if (!mesh_t::Matches(*fes.GetMesh()) || !sol_fes_t::Matches(fes))
+      {
+         return NULL;
+      }
+      form_t *a = new form_t(integ_t(coeff_t(coeff)), fes);
+      a->Assemble(); // partial assembly
+      return a;
+   }
+
+   template <Geometry::Type geom, int mesh_p, int sol_p>
+   void RegisterOrder()
+   {
+      const int ir_order = 2*sol_p + Geometry::Constants<geom>::Dimension - 1;
+      Register<Mass,geom,mesh_p,sol_p,ir_order>();
+      Register<Diffusion,geom,mesh_p,sol_p,ir_order>();
+   }
+
+public:
+   /// Create an empty registry.
+   TBilinearFormRegistry() { }
+
+   /** @brief Add the TBilinearForm type with the given kernel, geometry, mesh
+       nodes order, solution order and quadrature order. */
+   template <KernelType kernel, Geometry::Type geom, int mesh_p, int sol_p,
+             int ir_order>
+   void Register()
+   {
+      const Key key(kernel, geom, mesh_p, sol_p, KeyOrder(geom, ir_order));
+      creators[key] = &CreateForm<kernel,geom,mesh_p,sol_p,ir_order>;
+   }
+
+   /// Add the default combinations, see the class description.
+   void RegisterDefaults()
+   {
+      RegisterOrder<Geometry::SQUARE,1,1>();
+      RegisterOrder<Geometry::SQUARE,1,2>();
+      RegisterOrder<Geometry::SQUARE,1,3>();
+      RegisterOrder<Geometry::SQUARE,1,4>();
+      RegisterOrder<Geometry::SQUARE,2,1>();
+      RegisterOrder<Geometry::SQUARE,2,2>();
+      RegisterOrder<Geometry::SQUARE,2,3>();
+      RegisterOrder<Geometry::SQUARE,2,4>();
+      RegisterOrder<Geometry::CUBE,1,1>();
+      RegisterOrder<Geometry::CUBE,1,2>();
+      RegisterOrder<Geometry::CUBE,1,3>();
+      RegisterOrder<Geometry::CUBE,1,4>();
+      RegisterOrder<Geometry::CUBE,2,1>();
+      RegisterOrder<Geometry::CUBE,2,2>();
+      RegisterOrder<Geometry::CUBE,2,3>();
+      RegisterOrder<Geometry::CUBE,2,4>();
+   }
+
+   /// Return the number of registered combinations.
+   int Size() const { return (int) creators.size(); }
+
+   /** @brief Return the default quadrature order used by Create() for the
+       space @a fes: 2*order+dim-1. */
+   static int DefaultIntRuleOrder(const FiniteElementSpace &fes)
+   {
+      const int order = fes.GetNE() ? fes.GetFE(0)->GetOrder() : 0;
+      return 2*order + fes.GetMesh()->Dimension() - 1;
+   }
+
+   /** @brief Create a partially assembled TBilinearForm for the given kernel
+       with the constant coefficient @a coeff on the space @a fes, using a
+       quadrature rule of order @a ir_order (-1 = DefaultIntRuleOrder()).
+       Returns NULL if there is no matching registered type. */
+   /** The returned operator keeps references to @a fes and its mesh. */
+   Operator *Create(KernelType kernel, double coeff,
+                    const FiniteElementSpace &fes, int ir_order = -1) const
+   {
+      const Mesh &mesh = *fes.GetMesh();
+      if (fes.GetNE() == 0 || fes.GetVDim() != 1 || !mesh.GetNodes())
+      {
+         return NULL;
+      }
+      if (ir_order < 0) { ir_order = DefaultIntRuleOrder(fes); }
+      const int geom = mesh.GetElementBaseGeometry(0);
+      const Key key(kernel, geom, mesh.GetNodalFESpace()->GetOrder(0),
+                    fes.GetOrder(0), KeyOrder(geom, ir_order));
+      std::map<Key,CreateFunction>::const_iterator it =
+         creators.find(key);
+      return (it == creators.end()) ? NULL : it->second(coeff, fes);
+   }
+
+   /** @brief Create a form with Create() and if that is not possible, an
+       assembled BilinearForm with the corresponding standard integrator
+       (MassIntegrator or DiffusionIntegrator). If @a templated is not NULL, it
+       is set to true when the returned operator is a TBilinearForm. */
+   /** In the BilinearForm case, the quadrature rule is the default rule of the
+       integrator when @a ir_order is negative. */
+   Operator *CreateOrFallback(KernelType kernel, double coeff,
+                              FiniteElementSpace &fes, int ir_order = -1,
+                              bool *templated = NULL) const
+   {
+      Operator *op = Create(kernel, coeff, fes, ir_order);
+      if (templated) { *templated = (op != NULL); }
+      if (op) { return op; }
+
+      FallbackForm *a = new FallbackForm(fes, coeff);
+      BilinearFormIntegrator *integ;
+      if (kernel == Mass) { integ = new MassIntegrator(a->coeff); }
+      else { integ = new DiffusionIntegrator(a->coeff); }
+      if (ir_order >= 0 && fes.GetNE() > 0)
+      {
+         integ->SetIntRule(&IntRules.Get(fes.GetFE(0)->GetGeomType(),
+                                         ir_order));
+      }
+      a->AddDomainIntegrator(integ);
+      a->Assemble();
+      a->Finalize();
+      return a;
+   }
+
+   /** @brief Return a global registry with the default combinations, see
+       RegisterDefaults(). */
+   static const TBilinearFormRegistry &Default()
+   {
+      static TBilinearFormRegistry registry;
+      if (registry.Size() == 0) { registry.RegisterDefaults(); }
+      return registry;
+   }
+};
+
+} // namespace mfem
+
+#endif // MFEM_TEMPLATE_REGISTRY
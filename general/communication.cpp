@@ -25,6 +25,7 @@
 #include "text.hpp"
 #include "sort_pairs.hpp"
 #include "globals.hpp"
+#include "profiler.hpp"
 
 #include <iostream>
 #include <map>
@@ -624,6 +625,7 @@ const T *GroupCommunicator::ReduceGroupFromBuffer(const T *buf, T *ldata,
 template <class T>
 void GroupCommunicator::BcastBegin(T *ldata, int layout) const
 {
+   MFEM_PROFILE_REGION("GroupCommunicator::BcastBegin");
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
    if (group_buf_size == 0) { return; }
@@ -761,6 +763,7 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
 template <class T>
 void GroupCommunicator::BcastEnd(T *ldata, int layout) const
 {
+   MFEM_PROFILE_REGION("GroupCommunicator::BcastEnd");
    if (comm_lock == 0) { return; }
    // The above also handles the case (group_buf_size == 0).
    MFEM_VERIFY(comm_lock == 1, "object is NOT locked for Bcast");
@@ -823,6 +826,7 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
 template <class T>
 void GroupCommunicator::ReduceBegin(const T *ldata) const
 {
+   MFEM_PROFILE_REGION("GroupCommunicator::ReduceBegin");
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
    if (group_buf_size == 0) { return; }
@@ -943,6 +947,7 @@ template <class T>
 void GroupCommunicator::ReduceEnd(T *ldata, int layout,
                                   void (*Op)(OpData<T>)) const
 {
+   MFEM_PROFILE_REGION("GroupCommunicator::ReduceEnd");
    if (comm_lock == 0) { return; }
    // The above also handles the case (group_buf_size == 0).
    MFEM_VERIFY(comm_lock == 2, "object is NOT locked for Reduce");
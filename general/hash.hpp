@@ -117,6 +117,10 @@ public:
    void Reparent(int id, int new_p1, int new_p2);
    void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4);
 
+   /** @brief Prepare the hash table for a total of 'size' items, so that
+       adding them does not trigger repeated rehashing. */
+   void Reserve(int size);
+
    /// Return total size of allocated memory (tables plus items), in bytes.
    long MemoryUsage() const;
 
@@ -194,8 +198,10 @@ protected:
    void Unlink(int idx, int id);
 
    /// Check table load factor and resize if necessary
+   static const int fill_factor = 2;
+
    inline void CheckRehash();
-   void DoRehash();
+   void DoRehash(int new_table_size);
 };
 
 
@@ -392,22 +398,31 @@ int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
 template<typename T>
 inline void HashTable<T>::CheckRehash()
 {
-   const int fill_factor = 2;
-
    // is the table overfull?
    if (Base::Size() > (mask+1) * fill_factor)
    {
-      DoRehash();
+      // double the table size
+      DoRehash(2*(mask+1));
+   }
+}
+
+template<typename T>
+void HashTable<T>::Reserve(int size)
+{
+   int new_table_size = mask+1;
+   while (size > new_table_size * fill_factor) { new_table_size *= 2; }
+
+   if (new_table_size > mask+1)
+   {
+      DoRehash(new_table_size);
    }
 }
 
 template<typename T>
-void HashTable<T>::DoRehash()
+void HashTable<T>::DoRehash(int new_table_size)
 {
    delete [] table;
 
-   // double the table size
-   int new_table_size = 2*(mask+1);
    table = new int[new_table_size];
    for (int i = 0; i < new_table_size; i++) { table[i] = -1; }
    mask = new_table_size-1;
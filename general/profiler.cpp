@@ -0,0 +1,400 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "profiler.hpp"
+#include "tic_toc.hpp"
+#include "error.hpp"
+
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace mfem
+{
+
+bool Profiler::enabled = false;
+
+namespace internal
+{
+
+// A node of the recorded call tree.
+struct ProfilerNode
+{
+   std::string name;
+   ProfilerNode *parent;
+   std::vector<ProfilerNode *> children;
+   long calls;
+   mfem::StopWatch sw;
+
+   ProfilerNode(const char *n, ProfilerNode *p)
+      : name(n), parent(p), calls(0) { sw.Clear(); }
+
+   ~ProfilerNode()
+   {
+      for (size_t i = 0; i < children.size(); i++) { delete children[i]; }
+   }
+
+   ProfilerNode *GetChild(const char *n)
+   {
+      for (size_t i = 0; i < children.size(); i++)
+      {
+         if (children[i]->name == n) { return children[i]; }
+      }
+      children.push_back(new ProfilerNode(n, this));
+      return children.back();
+   }
+};
+
+// Statistics of a region, over one or more ranks, used for printing.
+struct ProfilerStats
+{
+   std::string name;
+   double calls; // maximum over the ranks
+   double tmin, tmax, tsum;
+   int nranks;   // number of ranks that called the region
+   std::vector<ProfilerStats *> children;
+
+   ProfilerStats(const std::string &n)
+      : name(n), calls(0.0), tmin(0.0), tmax(0.0), tsum(0.0), nranks(0) { }
+
+   ~ProfilerStats()
+   {
+      for (size_t i = 0; i < children.size(); i++) { delete children[i]; }
+   }
+
+   ProfilerStats *GetChild(const std::string &n)
+   {
+      for (size_t i = 0; i < children.size(); i++)
+      {
+         if (children[i]->name == n) { return children[i]; }
+      }
+      children.push_back(new ProfilerStats(n));
+      return children.back();
+   }
+
+   void Add(double c, double t)
+   {
+      calls = (nranks == 0) ? c : std::max(calls, c);
+      tmin = (nranks == 0) ? t : std::min(tmin, t);
+      tmax = (nranks == 0) ? t : std::max(tmax, t);
+      tsum += t;
+      nranks++;
+   }
+
+   // Regions missing on some of the 'size' ranks have a minimum time of zero.
+   void Finalize(int size)
+   {
+      if (nranks < size) { tmin = 0.0; }
+      for (size_t i = 0; i < children.size(); i++)
+      {
+         children[i]->Finalize(size);
+      }
+   }
+};
+
+static ProfilerNode *root = NULL, *current = NULL;
+
+static void CopyStats(ProfilerNode &node, ProfilerStats &stats)
+{
+   for (size_t i = 0; i < node.children.size(); i++)
+   {
+      ProfilerNode &child = *node.children[i];
+      ProfilerStats *c_stats = stats.GetChild(child.name);
+      c_stats->Add(child.calls, child.sw.RealTime());
+      CopyStats(child, *c_stats);
+   }
+}
+
+static int NameWidth(const ProfilerStats &stats, int depth)
+{
+   int w = 2*depth + stats.name.size();
+   for (size_t i = 0; i < stats.children.size(); i++)
+   {
+      w = std::max(w, NameWidth(*stats.children[i], depth + 1));
+   }
+   return w;
+}
+
+static void PrintTableRows(const ProfilerStats &stats, int depth, int size,
+                           int width, bool par, std::ostream &out)
+{
+   const double ptime = stats.tsum / size;
+   for (size_t i = 0; i < stats.children.size(); i++)
+   {
+      const ProfilerStats &c = *stats.children[i];
+      const double avg = c.tsum / size;
+      out << std::string(2*depth, ' ') << std::left
+          << std::setw(width - 2*depth) << c.name << std::right
+          << std::setw(10) << (long) c.calls;
+      if (par)
+      {
+         out << std::setw(13) << c.tmin << std::setw(13) << c.tmax;
+      }
+      out << std::setw(13) << avg;
+      if (depth > 0 && ptime > 0.0)
+      {
+         out << std::setw(10) << std::setprecision(1) << 100.0*avg/ptime
+             << std::setprecision(6);
+      }
+      out << '\n';
+      PrintTableRows(c, depth + 1, size, width, par, out);
+   }
+}
+
+static void PrintTable(const ProfilerStats &stats, int size, bool par,
+                       std::ostream &out)
+{
+   const int width = std::max(NameWidth(stats, -1), 6) + 2;
+   std::ios::fmtflags old_flags = out.flags();
+   std::streamsize old_prec = out.precision(6);
+   out.setf(std::ios::fixed, std::ios::floatfield);
+
+   out << std::left << std::setw(width) << "Region" << std::right
+       << std::setw(10) << "Calls";
+   if (par)
+   {
+      out << std::setw(13) << "Min (s)" << std::setw(13) << "Max (s)"
+          << std::setw(13) << "Avg (s)";
+   }
+   else
+   {
+      out << std::setw(13) << "Time (s)";
+   }
+   out << std::setw(10) << "% parent" << '\n';
+   out << std::string(width + (par ? 59 : 33), '-') << '\n';
+   PrintTableRows(stats, 0, size, width, par, out);
+   out << std::flush;
+
+   out.flags(old_flags);
+   out.precision(old_prec);
+}
+
+static void PrintJSONString(const std::string &s, std::ostream &out)
+{
+   out << '"';
+   for (size_t i = 0; i < s.size(); i++)
+   {
+      const char c = s[i];
+      if (c == '"' || c == '\\') { out << '\\' << c; }
+      else if ((unsigned char) c < 0x20) { out << ' '; }
+      else { out << c; }
+   }
+   out << '"';
+}
+
+static void PrintJSONChildren(const ProfilerStats &stats, int depth,
+                              int size, bool par, std::ostream &out)
+{
+   const std::string indent(2*depth, ' ');
+   out << '[';
+   for (size_t i = 0; i < stats.children.size(); i++)
+   {
+      const ProfilerStats &c = *stats.children[i];
+      out << (i ? ",\n" : "\n") << indent << "  { \"name\": ";
+      PrintJSONString(c.name, out);
+      out << ", \"calls\": " << (long) c.calls;
+      if (par)
+      {
+         out << ", \"min\": " << c.tmin << ", \"max\": " << c.tmax
+             << ", \"avg\": " << c.tsum / size;
+      }
+      else
+      {
+         out << ", \"time\": " << c.tsum;
+      }
+      out << ", \"children\": ";
+      PrintJSONChildren(c, depth + 1, size, par, out);
+      out << " }";
+   }
+   if (stats.children.size()) { out << '\n' << indent; }
+   out << ']';
+}
+
+static void PrintJSON(const ProfilerStats &stats, int size, bool par,
+                      std::ostream &out)
+{
+   std::streamsize old_prec = out.precision(10);
+   out << "{\n";
+   if (par) { out << "  \"ranks\": " << size << ",\n"; }
+   out << "  \"regions\": ";
+   PrintJSONChildren(stats, 1, size, par, out);
+   out << "\n}" << std::endl;
+   out.precision(old_prec);
+}
+
+#ifdef MFEM_USE_MPI
+template <typename T>
+static T *Ptr(std::vector<T> &v) { return v.empty() ? NULL : &v[0]; }
+
+// Separator of the region names in the paths sent to rank 0.
+static const char path_sep = '\x1f';
+
+static void Serialize(ProfilerNode &node, const std::string &path,
+                      std::vector<char> &names, std::vector<double> &data)
+{
+   for (size_t i = 0; i < node.children.size(); i++)
+   {
+      ProfilerNode &child = *node.children[i];
+      const std::string c_path =
+         path.empty() ? child.name : path + path_sep + child.name;
+      names.insert(names.end(), c_path.begin(), c_path.end());
+      names.push_back('\0');
+      data.push_back(child.calls);
+      data.push_back(child.sw.RealTime());
+      Serialize(child, c_path, names, data);
+   }
+}
+
+// Returns the aggregated statistics on rank 0 and NULL on the other ranks.
+static ProfilerStats *GatherStats(MPI_Comm comm)
+{
+   int rank, size;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &size);
+
+   std::vector<char> names;
+   std::vector<double> data;
+   if (root) { Serialize(*root, std::string(), names, data); }
+
+   int loc_sizes[2] = { (int) names.size(), (int) data.size() };
+   std::vector<int> sizes(rank == 0 ? 2*size : 0);
+   MPI_Gather(loc_sizes, 2, MPI_INT, Ptr(sizes), 2, MPI_INT, 0, comm);
+
+   std::vector<int> n_cnt, n_off, d_cnt, d_off;
+   std::vector<char> all_names;
+   std::vector<double> all_data;
+   if (rank == 0)
+   {
+      n_cnt.resize(size); n_off.resize(size + 1);
+      d_cnt.resize(size); d_off.resize(size + 1);
+      n_off[0] = d_off[0] = 0;
+      for (int p = 0; p < size; p++)
+      {
+         n_cnt[p] = sizes[2*p];
+         d_cnt[p] = sizes[2*p+1];
+         n_off[p+1] = n_off[p] + n_cnt[p];
+         d_off[p+1] = d_off[p] + d_cnt[p];
+      }
+      all_names.resize(n_off[size]);
+      all_data.resize(d_off[size]);
+   }
+   MPI_Gatherv(Ptr(names), loc_sizes[0], MPI_CHAR, Ptr(all_names),
+               Ptr(n_cnt), Ptr(n_off), MPI_CHAR, 0, comm);
+   MPI_Gatherv(Ptr(data), loc_sizes[1], MPI_DOUBLE, Ptr(all_data),
+               Ptr(d_cnt), Ptr(d_off), MPI_DOUBLE, 0, comm);
+   if (rank != 0) { return NULL; }
+
+   ProfilerStats *stats = new ProfilerStats("");
+   for (int p = 0; p < size; p++)
+   {
+      const char *name = Ptr(all_names) + n_off[p];
+      const double *d = Ptr(all_data) + d_off[p];
+      for (int r = 0; r < d_cnt[p]/2; r++)
+      {
+         ProfilerStats *s = stats;
+         const std::string path(name);
+         size_t pos = 0, next;
+         while ((next = path.find(path_sep, pos)) != std::string::npos)
+         {
+            s = s->GetChild(path.substr(pos, next - pos));
+            pos = next + 1;
+         }
+         s = s->GetChild(path.substr(pos));
+         s->Add(d[2*r], d[2*r+1]);
+         name += path.size() + 1;
+      }
+   }
+   stats->Finalize(size);
+   return stats;
+}
+#endif
+
+} // namespace internal
+
+bool Profiler::Begin(const char *name)
+{
+   using namespace internal;
+
+   if (!enabled) { return false; }
+#ifdef MFEM_USE_OPENMP
+   if (omp_in_parallel()) { return false; }
+#endif
+   if (!current) { root = current = new ProfilerNode("", NULL); }
+   current = current->GetChild(name);
+   current->calls++;
+   current->sw.Start();
+   return true;
+}
+
+void Profiler::End()
+{
+   using namespace internal;
+
+   MFEM_VERIFY(current && current != root, "there is no open region");
+   current->sw.Stop();
+   current = current->parent;
+}
+
+void Profiler::Reset()
+{
+   using namespace internal;
+
+   MFEM_VERIFY(current == root, "there are open regions");
+   delete root;
+   root = current = NULL;
+}
+
+void Profiler::Print(std::ostream &out)
+{
+   internal::ProfilerStats stats("");
+   if (internal::root) { internal::CopyStats(*internal::root, stats); }
+   internal::PrintTable(stats, 1, false, out);
+}
+
+void Profiler::PrintJSON(std::ostream &out)
+{
+   internal::ProfilerStats stats("");
+   if (internal::root) { internal::CopyStats(*internal::root, stats); }
+   internal::PrintJSON(stats, 1, false, out);
+}
+
+#ifdef MFEM_USE_MPI
+void Profiler::Print(MPI_Comm comm, std::ostream &out)
+{
+   internal::ProfilerStats *stats = internal::GatherStats(comm);
+   if (stats)
+   {
+      int size;
+      MPI_Comm_size(comm, &size);
+      internal::PrintTable(*stats, size, true, out);
+      delete stats;
+   }
+}
+
+void Profiler::PrintJSON(MPI_Comm comm, std::ostream &out)
+{
+   internal::ProfilerStats *stats = internal::GatherStats(comm);
+   if (stats)
+   {
+      int size;
+      MPI_Comm_size(comm, &size);
+      internal::PrintJSON(*stats, size, true, out);
+      delete stats;
+   }
+}
+#endif
+
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <iostream>
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace mfem
+{
+
+/** @brief Hierarchical profiler of named code regions.
+
+    Regions are opened and closed with Begin() and End(), or with the scoped
+    helper class ProfilerRegion (see also the macro MFEM_PROFILE_REGION).
+    Nested regions form a call tree and for each node of the tree the number of
+    calls and the accumulated wall-clock time are recorded. The same region
+    name called from different parents gives different tree nodes.
+
+    The profiler is disabled by default, in which case opening a region costs
+    a single test of a global flag. It can be enabled and disabled at any time
+    with Enable(). Regions are recorded only outside of OpenMP parallel
+    regions.
+
+    The recorded tree can be printed as a table or in JSON format. In parallel,
+    the versions of Print() and PrintJSON() taking an MPI communicator
+    aggregate the trees of all ranks (the minimum, maximum and average times
+    over the ranks) and print the result on rank 0. */
+class Profiler
+{
+private:
+   static bool enabled;
+
+public:
+   /// Enable or disable the recording of regions.
+   static void Enable(bool enable = true) { enabled = enable; }
+
+   /// Return true if the recording of regions is enabled.
+   static bool IsEnabled() { return enabled; }
+
+   /** @brief Open a region with the given @a name as a child of the currently
+       open region. Returns true if the region was opened, in which case it
+       must be closed with End(). */
+   /** The name is copied when a region is called for the first time from a
+       given parent; string literals are recommended. */
+   static bool Begin(const char *name);
+
+   /// Close the currently open region.
+   static void End();
+
+   /// Delete all recorded data. There must be no open regions.
+   static void Reset();
+
+   /// Print the recorded call tree as a table.
+   static void Print(std::ostream &out = mfem::out);
+
+   /// Print the recorded call tree in JSON format.
+   static void PrintJSON(std::ostream &out = mfem::out);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print the call tree aggregated over all ranks of @a comm as a
+       table, on rank 0. This is a collective operation. */
+   /** Ranks that did not call a region count as ranks with zero time. */
+   static void Print(MPI_Comm comm, std::ostream &out = mfem::out);
+
+   /** @brief Print the call tree aggregated over all ranks of @a comm in JSON
+       format, on rank 0. This is a collective operation. */
+   static void PrintJSON(MPI_Comm comm, std::ostream &out = mfem::out);
+#endif
+};
+
+/** @brief Scoped profiler region: the region is opened in the constructor (if
+    the Profiler is enabled) and closed in the destructor. */
+class ProfilerRegion
+{
+private:
+   bool active;
+
+public:
+   explicit ProfilerRegion(const char *name)
+      : active(Profiler::IsEnabled() && Profiler::Begin(name)) { }
+
+   ~ProfilerRegion() { if (active) { Profiler::End(); } }
+};
+
+}
+
+/// Profile the rest of the enclosing scope as a region with the given name.
+#define MFEM_PROFILE_REGION(name) \
+   mfem::ProfilerRegion mfem_profiler_region_(name)
+
+#endif
@@ -18,6 +18,10 @@
 #include <iostream>
 #include <iomanip>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -415,6 +419,142 @@ Table::~Table ()
    if (J) { delete [] J; }
 }
 
+#ifdef MFEM_USE_OPENMP
+// Tables with fewer connections are transposed and multiplied serially.
+static const int table_omp_min_size = 32768;
+
+// Threaded version of the transpose in Transpose(). Each thread counts the
+// columns in a contiguous block of rows of A; a prefix sum over the columns
+// and the threads gives the offsets where each thread writes its part of the
+// rows of At, so the result is the same as in the serial version. Returns
+// false, without changing At, if the per-thread counts would take more than
+// twice the memory of the connections of A, i.e. 2*nnz integers.
+static bool TransposeThreaded(const int *i_A, const int *j_A, int nrows_A,
+                              int ncols_A, int *i_At, int *j_At)
+{
+   const int nnz_A = i_A[nrows_A];
+   const int max_threads = omp_get_max_threads();
+   if (max_threads == 1 || nnz_A < table_omp_min_size ||
+       (long) max_threads*ncols_A > 2L*nnz_A)
+   {
+      return false;
+   }
+
+   Array<int> counts(max_threads*ncols_A);
+   #pragma omp parallel
+   {
+      const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+      const int beg = (int) ((long) nrows_A*t/nt);
+      const int end = (int) ((long) nrows_A*(t+1)/nt);
+      int *cnt = counts.GetData() + t*ncols_A;
+
+      for (int c = 0; c < ncols_A; c++) { cnt[c] = 0; }
+      for (int j = i_A[beg]; j < i_A[end]; j++) { cnt[j_A[j]]++; }
+      #pragma omp barrier
+
+      // Offsets of the threads within each row of At, and the row sizes
+      #pragma omp for schedule(static)
+      for (int c = 0; c < ncols_A; c++)
+      {
+         int sum = 0;
+         for (int tt = 0; tt < nt; tt++)
+         {
+            int &ct = counts[tt*ncols_A + c];
+            const int tmp = ct;
+            ct = sum;
+            sum += tmp;
+         }
+         i_At[c+1] = sum;
+      }
+
+      #pragma omp single
+      {
+         i_At[0] = 0;
+         for (int c = 0; c < ncols_A; c++) { i_At[c+1] += i_At[c]; }
+      }
+
+      for (int i = beg; i < end; i++)
+      {
+         for (int j = i_A[i]; j < i_A[i+1]; j++)
+         {
+            const int c = j_A[j];
+            j_At[i_At[c] + cnt[c]++] = i;
+         }
+      }
+   }
+   return true;
+}
+
+// Threaded version of Mult(). The rows of C are counted and filled in parallel,
+// with a marker array per thread.
+static void MultThreaded(const Table &A, const Table &B, Table &C)
+{
+   const int *i_A     = A.GetI();
+   const int *j_A     = A.GetJ();
+   const int *i_B     = B.GetI();
+   const int *j_B     = B.GetJ();
+   const int  nrows_A = A.Size();
+   const int  ncols_B = B.Width();
+
+   Array<int> row_size(nrows_A+1);
+   row_size[0] = 0;
+   #pragma omp parallel
+   {
+      Array<int> B_marker(ncols_B);
+      B_marker = -1;
+
+      #pragma omp for schedule(static)
+      for (int i = 0; i < nrows_A; i++)
+      {
+         int counter = 0;
+         for (int j = i_A[i]; j < i_A[i+1]; j++)
+         {
+            const int k = j_A[j];
+            for (int l = i_B[k]; l < i_B[k+1]; l++)
+            {
+               const int m = j_B[l];
+               if (B_marker[m] != i)
+               {
+                  B_marker[m] = i;
+                  counter++;
+               }
+            }
+         }
+         row_size[i+1] = counter;
+      }
+
+      #pragma omp single
+      {
+         row_size.PartialSum();
+         C.SetDims(nrows_A, row_size[nrows_A]);
+         std::copy(row_size.GetData(), row_size.GetData() + nrows_A + 1,
+                   C.GetI());
+      }
+
+      B_marker = -1;
+      int *j_C = C.GetJ();
+      #pragma omp for schedule(static)
+      for (int i = 0; i < nrows_A; i++)
+      {
+         int counter = row_size[i];
+         for (int j = i_A[i]; j < i_A[i+1]; j++)
+         {
+            const int k = j_A[j];
+            for (int l = i_B[k]; l < i_B[k+1]; l++)
+            {
+               const int m = j_B[l];
+               if (B_marker[m] != i)
+               {
+                  B_marker[m] = i;
+                  j_C[counter++] = m;
+               }
+            }
+         }
+      }
+   }
+}
+#endif
+
 void Transpose (const Table &A, Table &At, int _ncols_A)
 {
    const int *i_A     = A.GetI();
@@ -428,6 +568,13 @@ void Transpose (const Table &A, Table &At, int _ncols_A)
    int *i_At = At.GetI();
    int *j_At = At.GetJ();
 
+#ifdef MFEM_USE_OPENMP
+   if (TransposeThreaded(i_A, j_A, nrows_A, ncols_A, i_At, j_At))
+   {
+      return;
+   }
+#endif
+
    for (int i = 0; i <= ncols_A; i++)
    {
       i_At[i] = 0;
@@ -490,6 +637,14 @@ void Mult (const Table &A, const Table &B, Table &C)
    MFEM_VERIFY( ncols_A <= nrows_B, "Table size mismatch: ncols_A = " << ncols_A
                 << ", nrows_B = " << nrows_B);
 
+#ifdef MFEM_USE_OPENMP
+   if (omp_get_max_threads() > 1 && i_A[nrows_A] >= table_omp_min_size)
+   {
+      MultThreaded(A, B, C);
+      return;
+   }
+#endif
+
    Array<int> B_marker (ncols_B);
 
    for (i = 0; i < ncols_B; i++)
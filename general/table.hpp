@@ -170,14 +170,20 @@ template <> inline void Swap<Table>(Table &a, Table &b)
    a.Swap(b);
 }
 
-///  Transpose a Table
+/** @brief Transpose a Table
+
+    With MFEM_USE_OPENMP, large tables are transposed in parallel, with the
+    same result as the serial version. */
 void Transpose (const Table &A, Table &At, int _ncols_A = -1);
 Table * Transpose (const Table &A);
 
 ///  Transpose an Array<int>
 void Transpose(const Array<int> &A, Table &At, int _ncols_A = -1);
 
-///  C = A * B  (as boolean matrices)
+/** @brief C = A * B  (as boolean matrices)
+
+    With MFEM_USE_OPENMP, the rows of C are computed in parallel when A is
+    large; the result is the same as in the serial version. */
 void Mult (const Table &A, const Table &B, Table &C);
 Table * Mult (const Table &A, const Table &B);
 
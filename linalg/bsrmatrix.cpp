@@ -0,0 +1,464 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class BSRMatrix
+
+#include "bsrmatrix.hpp"
+#include <algorithm>
+
+namespace mfem
+{
+
+void BSRMatrix::Init(const Table &graph)
+{
+   I = new int[nbrows+1];
+   std::copy(graph.GetI(), graph.GetI() + nbrows+1, I);
+   J = new int[I[nbrows]];
+   std::copy(graph.GetJ(), graph.GetJ() + I[nbrows], J);
+   for (int i = 0; i < nbrows; i++)
+   {
+      std::sort(J + I[i], J + I[i+1]);
+   }
+   A = new double[I[nbrows]*bsize*bsize];
+}
+
+BSRMatrix::BSRMatrix(const Table &graph, int bs, int nbc)
+   : Operator(graph.Size()*bs, (nbc < 0 ? graph.Size() : nbc)*bs),
+     bsize(bs), nbrows(graph.Size()), nbcols(nbc < 0 ? graph.Size() : nbc)
+{
+   Init(graph);
+   *this = 0.0;
+}
+
+BSRMatrix::BSRMatrix(const SparseMatrix &S, int bs)
+   : Operator(S.Height(), S.Width()),
+     bsize(bs), nbrows(S.Height()/bs), nbcols(S.Width()/bs)
+{
+   MFEM_VERIFY(S.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(S.Height() % bs == 0 && S.Width() % bs == 0,
+               "the matrix size is not a multiple of the block size");
+
+   const int *S_I = S.GetI(), *S_J = S.GetJ();
+   const double *S_A = S.GetData();
+
+   // The block sparsity is the union of the sparsity of the scalar rows
+   Table graph;
+   Array<int> bcol_marker(nbcols);
+   bcol_marker = -1;
+   graph.MakeI(nbrows);
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      for (int i = bi*bs; i < (bi+1)*bs; i++)
+      {
+         for (int j = S_I[i]; j < S_I[i+1]; j++)
+         {
+            const int bj = S_J[j]/bs;
+            if (bcol_marker[bj] != bi)
+            {
+               bcol_marker[bj] = bi;
+               graph.AddAColumnInRow(bi);
+            }
+         }
+      }
+   }
+   graph.MakeJ();
+   bcol_marker = -1;
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      for (int i = bi*bs; i < (bi+1)*bs; i++)
+      {
+         for (int j = S_I[i]; j < S_I[i+1]; j++)
+         {
+            const int bj = S_J[j]/bs;
+            if (bcol_marker[bj] != bi)
+            {
+               bcol_marker[bj] = bi;
+               graph.AddConnection(bi, bj);
+            }
+         }
+      }
+   }
+   graph.ShiftUpI();
+
+   Init(graph);
+   *this = 0.0;
+   for (int i = 0; i < height; i++)
+   {
+      const int bi = i/bs, li = i%bs;
+      for (int j = S_I[i]; j < S_I[i+1]; j++)
+      {
+         const int k = FindBlock(bi, S_J[j]/bs);
+         A[k*bs*bs + li + (S_J[j]%bs)*bs] += S_A[j];
+      }
+   }
+}
+
+int BSRMatrix::FindBlock(int bi, int bj) const
+{
+   const int *beg = J + I[bi], *end = J + I[bi+1];
+   const int *pos = std::lower_bound(beg, end, bj);
+   return (pos != end && *pos == bj) ? int(pos - J) : -1;
+}
+
+BSRMatrix &BSRMatrix::operator=(double a)
+{
+   const int size = I[nbrows]*bsize*bsize;
+   for (int i = 0; i < size; i++)
+   {
+      A[i] = a;
+   }
+   return *this;
+}
+
+void BSRMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                             const DenseMatrix &subm)
+{
+   const int bs2 = bsize*bsize;
+   for (int j = 0; j < cols.Size(); j++)
+   {
+      const int c = (cols[j] >= 0) ? cols[j] : -1-cols[j];
+      const double sc = (cols[j] >= 0) ? 1.0 : -1.0;
+      const int bj = c/bsize, lj = c%bsize;
+      for (int i = 0; i < rows.Size(); i++)
+      {
+         const int r = (rows[i] >= 0) ? rows[i] : -1-rows[i];
+         const double s = (rows[i] >= 0) ? sc : -sc;
+         const int k = FindBlock(r/bsize, bj);
+         MFEM_VERIFY(k >= 0, "entry (" << r << "," << c << ") is not in the "
+                     "sparsity pattern");
+         A[k*bs2 + r%bsize + lj*bsize] += s*subm(i,j);
+      }
+   }
+}
+
+// y_i += a sum_k A_k x_{J[k]}, with compile-time block size B, or the run-time
+// block size bs_ if B = 0.
+template <int B>
+static void BSRAddMult(const int bs_, const int nbrows, const int *I,
+                       const int *J, const double *A, const double *xp,
+                       double *yp, const double a)
+{
+   const int bs = B ? B : bs_;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      // With a compile-time block size, accumulate the block row locally
+      double y_loc[B ? B : 1];
+      double *yb = B ? y_loc : yp + bi*bs;
+      const double s = B ? 1.0 : a;
+      for (int i = 0; B && i < bs; i++) { yb[i] = 0.0; }
+      for (int k = I[bi]; k < I[bi+1]; k++)
+      {
+         const double *Ak = A + k*bs*bs;
+         const double *xb = xp + J[k]*bs;
+         for (int j = 0; j < bs; j++)
+         {
+            const double xj = s*xb[j];
+            for (int i = 0; i < bs; i++)
+            {
+               yb[i] += Ak[i + j*bs]*xj;
+            }
+         }
+      }
+      for (int i = 0; B && i < bs; i++) { yp[bi*bs + i] += a*yb[i]; }
+   }
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "invalid input vector size");
+   MFEM_ASSERT(height == y.Size(), "invalid output vector size");
+
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+   switch (bsize)
+   {
+      case 1: BSRAddMult<1>(bsize, nbrows, I, J, A, xp, yp, a); break;
+      case 2: BSRAddMult<2>(bsize, nbrows, I, J, A, xp, yp, a); break;
+      case 3: BSRAddMult<3>(bsize, nbrows, I, J, A, xp, yp, a); break;
+      default: BSRAddMult<0>(bsize, nbrows, I, J, A, xp, yp, a); break;
+   }
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(height == x.Size(), "invalid input vector size");
+
+   y.SetSize(width);
+   y = 0.0;
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      const double *xb = xp + bi*bsize;
+      for (int k = I[bi]; k < I[bi+1]; k++)
+      {
+         const double *Ak = A + k*bsize*bsize;
+         double *yb = yp + J[k]*bsize;
+         for (int j = 0; j < bsize; j++)
+         {
+            double d = 0.0;
+            for (int i = 0; i < bsize; i++)
+            {
+               d += Ak[i + j*bsize]*xb[i];
+            }
+            yb[j] += d;
+         }
+      }
+   }
+}
+
+void BSRMatrix::EliminateRowsCols(const Array<int> &rc, const Vector &sol,
+                                  Vector &rhs)
+{
+   Array<bool> marker(height);
+   marker = false;
+   for (int i = 0; i < rc.Size(); i++)
+   {
+      marker[rc[i]] = true;
+   }
+
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      for (int k = I[bi]; k < I[bi+1]; k++)
+      {
+         double *Ak = A + k*bsize*bsize;
+         for (int lj = 0; lj < bsize; lj++)
+         {
+            const int c = J[k]*bsize + lj;
+            for (int li = 0; li < bsize; li++)
+            {
+               const int r = bi*bsize + li;
+               double &a_rc = Ak[li + lj*bsize];
+               if (marker[c] && !marker[r]) { rhs(r) -= a_rc*sol(c); }
+               if (marker[r] || marker[c]) { a_rc = (r == c) ? 1.0 : 0.0; }
+            }
+         }
+      }
+   }
+   for (int i = 0; i < rc.Size(); i++)
+   {
+      rhs(rc[i]) = sol(rc[i]);
+   }
+}
+
+void BSRMatrix::GetBlockDiagInverse(DenseTensor &Dinv) const
+{
+   MFEM_VERIFY(nbrows == nbcols, "the matrix must be square");
+
+   Dinv.SetSize(bsize, bsize, nbrows);
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      const int k = FindBlock(bi, bi);
+      MFEM_VERIFY(k >= 0, "missing diagonal block " << bi);
+      DenseMatrix D(Dinv.GetData(bi), bsize, bsize);
+      std::copy(GetBlock(k), GetBlock(k) + bsize*bsize, D.Data());
+      D.Invert();
+   }
+}
+
+void BSRMatrix::BlockJacobi(const Vector &b, const Vector &x0, Vector &x1,
+                            const DenseTensor &Dinv, double sc) const
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      Vector r(bsize);
+
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int bi = 0; bi < nbrows; bi++)
+      {
+         for (int i = 0; i < bsize; i++) { r(i) = b(bi*bsize + i); }
+         for (int k = I[bi]; k < I[bi+1]; k++)
+         {
+            const double *Ak = GetBlock(k);
+            const double *xb = x0.GetData() + J[k]*bsize;
+            for (int j = 0; j < bsize; j++)
+            {
+               for (int i = 0; i < bsize; i++)
+               {
+                  r(i) -= Ak[i + j*bsize]*xb[j];
+               }
+            }
+         }
+         const double *Di = Dinv.GetData(bi);
+         for (int i = 0; i < bsize; i++)
+         {
+            double d = 0.0;
+            for (int j = 0; j < bsize; j++)
+            {
+               d += Di[i + j*bsize]*r(j);
+            }
+            x1(bi*bsize + i) = x0(bi*bsize + i) + sc*d;
+         }
+      }
+   }
+}
+
+// One block Gauss-Seidel update of block row bi; r is a work array of size bs.
+static inline void BSRGaussSeidelRow(int bi, int bs, const int *I,
+                                     const int *J, const double *A,
+                                     const double *Di, const double *bp,
+                                     double *xp, double *r)
+{
+   for (int i = 0; i < bs; i++) { r[i] = bp[bi*bs + i]; }
+   for (int k = I[bi]; k < I[bi+1]; k++)
+   {
+      if (J[k] == bi) { continue; }
+      const double *Ak = A + k*bs*bs;
+      const double *xb = xp + J[k]*bs;
+      for (int j = 0; j < bs; j++)
+      {
+         for (int i = 0; i < bs; i++)
+         {
+            r[i] -= Ak[i + j*bs]*xb[j];
+         }
+      }
+   }
+   for (int i = 0; i < bs; i++)
+   {
+      double d = 0.0;
+      for (int j = 0; j < bs; j++)
+      {
+         d += Di[i + j*bs]*r[j];
+      }
+      xp[bi*bs + i] = d;
+   }
+}
+
+void BSRMatrix::BlockGaussSeidelForw(const Vector &b, Vector &x,
+                                     const DenseTensor &Dinv) const
+{
+   Vector r(bsize);
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      BSRGaussSeidelRow(bi, bsize, I, J, A, Dinv.GetData(bi), b.GetData(),
+                        x.GetData(), r.GetData());
+   }
+}
+
+void BSRMatrix::BlockGaussSeidelBack(const Vector &b, Vector &x,
+                                     const DenseTensor &Dinv) const
+{
+   Vector r(bsize);
+   for (int bi = nbrows-1; bi >= 0; bi--)
+   {
+      BSRGaussSeidelRow(bi, bsize, I, J, A, Dinv.GetData(bi), b.GetData(),
+                        x.GetData(), r.GetData());
+   }
+}
+
+SparseMatrix *BSRMatrix::ToSparseMatrix() const
+{
+   const int nnz = I[nbrows]*bsize*bsize;
+   int *S_I = new int[height+1];
+   int *S_J = new int[nnz];
+   double *S_A = new double[nnz];
+   S_I[0] = 0;
+   for (int i = 0; i < height; i++)
+   {
+      const int bi = i/bsize, li = i%bsize;
+      int pos = S_I[i];
+      for (int k = I[bi]; k < I[bi+1]; k++)
+      {
+         const double *Ak = GetBlock(k);
+         for (int lj = 0; lj < bsize; lj++)
+         {
+            S_J[pos] = J[k]*bsize + lj;
+            S_A[pos] = Ak[li + lj*bsize];
+            pos++;
+         }
+      }
+      S_I[i+1] = pos;
+   }
+   return new SparseMatrix(S_I, S_J, S_A, height, width);
+}
+
+#ifdef MFEM_USE_MPI
+HypreParMatrix *BSRMatrix::ToHypreParMatrix(MPI_Comm comm, HYPRE_Int glob_size,
+                                            HYPRE_Int *row_starts) const
+{
+   MFEM_VERIFY(height == width, "the matrix is not square");
+   SparseMatrix *S = ToSparseMatrix();
+   HypreParMatrix *H = new HypreParMatrix(comm, glob_size, row_starts, S);
+
+   // H does not own the arrays of S it uses: transfer their ownership to H
+#ifndef HYPRE_BIGINT
+   S->LoseData();
+#else
+   // H uses its own copies of the I and J arrays
+   S->SetDataOwner(false);
+#endif
+   delete S;
+   H->SetOwnerFlags(3, H->OwnsOffd(), H->OwnsColMap());
+
+   return H;
+}
+#endif
+
+BSRMatrix::~BSRMatrix()
+{
+   delete [] A;
+   delete [] J;
+   delete [] I;
+}
+
+
+void BSRSmoother::SetOperator(const Operator &a)
+{
+   oper = dynamic_cast<const BSRMatrix*>(&a);
+   MFEM_VERIFY(oper, "not a BSRMatrix!");
+   height = oper->Height();
+   width = oper->Width();
+   oper->GetBlockDiagInverse(Dinv);
+}
+
+void BSRSmoother::Mult(const Vector &x, Vector &y) const
+{
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   if (type == 3)
+   {
+      z.SetSize(width);
+      for (int i = 0; i < iterations; i++)
+      {
+         z = y;
+         oper->BlockJacobi(x, z, y, Dinv, scale);
+      }
+      return;
+   }
+   for (int i = 0; i < iterations; i++)
+   {
+      if (type != 2)
+      {
+         oper->BlockGaussSeidelForw(x, y, Dinv);
+      }
+      if (type != 1)
+      {
+         oper->BlockGaussSeidelBack(x, y, Dinv);
+      }
+   }
+}
+
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_BSRMATRIX
+#define MFEM_BSRMATRIX
+
+#include "../config/config.hpp"
+#include "../general/table.hpp"
+#include "sparsemat.hpp"
+#include "densemat.hpp"
+
+#ifdef MFEM_USE_MPI
+#include "hypre.hpp"
+#endif
+
+namespace mfem
+{
+
+/** @brief Sparse matrix in block CSR (BSR) format with square dense blocks.
+
+    The matrix is made of bsize x bsize blocks; the block sparsity is stored in
+    CSR format (I and J arrays with block indices) and the blocks are stored
+    contiguously, each one in column-major order. The scalar row (column) index
+    i corresponds to the block row (column) i/bsize and the entry i%bsize inside
+    the block, which matches the numbering of the vdofs of a FiniteElementSpace
+    with vdim = bsize and Ordering::byVDIM. For such spaces, e.g. in elasticity,
+    the BSR format stores one column index per block instead of one per entry,
+    and the products work with dense blocks.
+
+    A BSRMatrix can be assembled directly with BilinearForm::AssembleBSR() or
+    converted from a finalized SparseMatrix. */
+class BSRMatrix : public Operator
+{
+protected:
+   int bsize, nbrows, nbcols;
+   int *I, *J;
+   double *A;
+
+   // Return the index of the block (bi,bj), or -1 if it is not stored.
+   int FindBlock(int bi, int bj) const;
+
+   void Init(const Table &graph);
+
+public:
+   /** Create a BSRMatrix with block size @a bs and zero entries, with the block
+       sparsity given by @a graph, which maps block rows to block columns. The
+       number of block columns is @a nbc; if negative, it is set to the number
+       of block rows. */
+   BSRMatrix(const Table &graph, int bs, int nbc = -1);
+
+   /** Convert the finalized SparseMatrix @a S to BSR format with block size
+       @a bs. The blocks are stored with all their entries, i.e. the entries of
+       @a S are padded with zeros to full blocks. */
+   BSRMatrix(const SparseMatrix &S, int bs);
+
+   int GetBlockSize() const { return bsize; }
+   int NumBlockRows() const { return nbrows; }
+   int NumBlockCols() const { return nbcols; }
+   /// Return the number of stored blocks.
+   int NumBlocks() const { return I[nbrows]; }
+
+   const int *GetI() const { return I; }
+   const int *GetJ() const { return J; }
+   double *GetData() { return A; }
+   const double *GetData() const { return A; }
+
+   /// Return the data of block number @a k, stored in column-major order.
+   double *GetBlock(int k) { return A + k*bsize*bsize; }
+   const double *GetBlock(int k) const { return A + k*bsize*bsize; }
+
+   /// Set all entries to @a a.
+   BSRMatrix &operator=(double a);
+
+   /** Add the dense matrix @a subm to the entries with the scalar indices
+       @a rows and @a cols. Negative indices i represent the entry -1-i with the
+       sign flipped, as returned by FiniteElementSpace::GetElementVDofs(). The
+       entries must be in the blocks of the sparsity pattern. */
+   void AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                     const DenseMatrix &subm);
+
+   /// Matrix vector multiplication, y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = At x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** Eliminate the rows and columns with the scalar indices @a rc: the values
+       @a sol of the eliminated unknowns are moved to the right-hand side
+       @a rhs and the eliminated rows and columns are set to the identity. */
+   void EliminateRowsCols(const Array<int> &rc, const Vector &sol, Vector &rhs);
+
+   /// Compute the inverses of the diagonal blocks, e.g. for BSRSmoother.
+   void GetBlockDiagInverse(DenseTensor &Dinv) const;
+
+   /** One block Jacobi iteration, x1 = x0 + sc D^{-1} (b - A x0), where
+       @a Dinv contains the inverses of the diagonal blocks. */
+   void BlockJacobi(const Vector &b, const Vector &x0, Vector &x1,
+                    const DenseTensor &Dinv, double sc = 1.0) const;
+
+   /// Block Gauss-Seidel forward and backward iterations over a vector x.
+   void BlockGaussSeidelForw(const Vector &b, Vector &x,
+                             const DenseTensor &Dinv) const;
+   void BlockGaussSeidelBack(const Vector &b, Vector &x,
+                             const DenseTensor &Dinv) const;
+
+   /// Return the matrix in CSR format, as a new SparseMatrix.
+   SparseMatrix *ToSparseMatrix() const;
+
+#ifdef MFEM_USE_MPI
+   /** Return the matrix as a new block-diagonal square HypreParMatrix, e.g. as
+       the local part of a parallel matrix assembled on each processor. The
+       BSRMatrix must be square: it becomes the diagonal block of the local
+       rows, the off-diagonal (off-processor) part is empty. See HypreParMatrix
+       for the description of @a glob_size and @a row_starts, which are not
+       copied. The returned matrix owns its CSR arrays. */
+   HypreParMatrix *ToHypreParMatrix(MPI_Comm comm, HYPRE_Int glob_size,
+                                    HYPRE_Int *row_starts) const;
+#endif
+
+   virtual ~BSRMatrix();
+};
+
+/// Block Jacobi or block Gauss-Seidel smoother for a BSRMatrix
+class BSRSmoother : public Solver
+{
+protected:
+   const BSRMatrix *oper;
+   int type; // 0, 1, 2, 3 - symmetric GS, forward GS, backward GS, Jacobi
+   double scale;
+   int iterations;
+   DenseTensor Dinv;
+
+   mutable Vector z;
+
+public:
+   /// Create BSRSmoother, with the scaling @a s used in the Jacobi type.
+   BSRSmoother(int t = 0, double s = 1.0, int it = 1)
+      : oper(NULL), type(t), scale(s), iterations(it) { }
+
+   /// Create BSRSmoother, with the scaling @a s used in the Jacobi type.
+   BSRSmoother(const BSRMatrix &a, int t = 0, double s = 1.0, int it = 1)
+      : type(t), scale(s), iterations(it) { SetOperator(a); }
+
+   virtual void SetOperator(const Operator &a);
+
+   /// Apply the smoother.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+}
+
+#endif
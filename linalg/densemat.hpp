@@ -730,6 +730,9 @@ public:
 
    double *GetData(int k) { return tdata+k*Mk.Height()*Mk.Width(); }
 
+   const double *GetData(int k) const
+   { return tdata+k*Mk.Height()*Mk.Width(); }
+
    double *Data() { return tdata; }
 
    /** Matrix-vector product from unassembled element matrices, assuming both
@@ -22,6 +22,7 @@
 #include "blockvector.hpp"
 #include "blockmatrix.hpp"
 #include "blockoperator.hpp"
+#include "bsrmatrix.hpp"
 #include "sparsesmoothers.hpp"
 #include "densemat.hpp"
 #include "ode.hpp"
@@ -0,0 +1,338 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_TEMPLATE_SIMD
+#define MFEM_TEMPLATE_SIMD
+
+#include "../config/tconfig.hpp"
+
+#if defined(__SSE2__) || defined(__AVX__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Short-vector (SIMD) value types used by the templated kernels for element
+// vectorization, i.e. processing several elements at once, one element per
+// SIMD lane.
+
+namespace mfem
+{
+
+// Generic version: the operations are loops over the S lanes which the
+// compiler is expected to vectorize. Explicit x86 versions are defined below,
+// depending on the instruction sets enabled at compile time.
+template <typename scalar_t, int S>
+struct AutoSIMD
+{
+   typedef scalar_t scalar_type;
+   static const int size = S;
+
+   scalar_t vec[S];
+
+   inline MFEM_ALWAYS_INLINE scalar_t &operator[](int i) { return vec[i]; }
+   inline MFEM_ALWAYS_INLINE const scalar_t &operator[](int i) const
+   { return vec[i]; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const scalar_t &e)
+   {
+      for (int i = 0; i < S; i++) { vec[i] = e; }
+      return *this;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const AutoSIMD &v)
+   {
+      for (int i = 0; i < S; i++) { vec[i] += v[i]; }
+      return *this;
+   }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const scalar_t &e)
+   {
+      for (int i = 0; i < S; i++) { vec[i] += e; }
+      return *this;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const AutoSIMD &v)
+   {
+      for (int i = 0; i < S; i++) { vec[i] -= v[i]; }
+      return *this;
+   }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const scalar_t &e)
+   {
+      for (int i = 0; i < S; i++) { vec[i] -= e; }
+      return *this;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const AutoSIMD &v)
+   {
+      for (int i = 0; i < S; i++) { vec[i] *= v[i]; }
+      return *this;
+   }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const scalar_t &e)
+   {
+      for (int i = 0; i < S; i++) { vec[i] *= e; }
+      return *this;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const AutoSIMD &v)
+   {
+      for (int i = 0; i < S; i++) { vec[i] /= v[i]; }
+      return *this;
+   }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const scalar_t &e)
+   {
+      for (int i = 0; i < S; i++) { vec[i] /= e; }
+      return *this;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-() const
+   {
+      AutoSIMD r;
+      for (int i = 0; i < S; i++) { r[i] = -vec[i]; }
+      return r;
+   }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r += v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const scalar_t &e) const
+   { AutoSIMD r(*this); return (r += e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r -= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const scalar_t &e) const
+   { AutoSIMD r(*this); return (r -= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r *= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const scalar_t &e) const
+   { AutoSIMD r(*this); return (r *= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r /= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const scalar_t &e) const
+   { AutoSIMD r(*this); return (r /= e); }
+};
+
+#ifdef __SSE2__
+template <>
+struct AutoSIMD<double,2>
+{
+   typedef double scalar_type;
+   static const int size = 2;
+
+   union
+   {
+      double vec[2];
+      __m128d m;
+   };
+
+   inline MFEM_ALWAYS_INLINE double &operator[](int i) { return vec[i]; }
+   inline MFEM_ALWAYS_INLINE const double &operator[](int i) const
+   { return vec[i]; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
+   { m = _mm_set1_pd(e); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const AutoSIMD &v)
+   { m = _mm_add_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const double &e)
+   { m = _mm_add_pd(m, _mm_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const AutoSIMD &v)
+   { m = _mm_sub_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const double &e)
+   { m = _mm_sub_pd(m, _mm_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const AutoSIMD &v)
+   { m = _mm_mul_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const double &e)
+   { m = _mm_mul_pd(m, _mm_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const AutoSIMD &v)
+   { m = _mm_div_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const double &e)
+   { m = _mm_div_pd(m, _mm_set1_pd(e)); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-() const
+   { AutoSIMD r; r.m = _mm_sub_pd(_mm_setzero_pd(), m); return r; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r += v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const double &e) const
+   { AutoSIMD r(*this); return (r += e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r -= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const double &e) const
+   { AutoSIMD r(*this); return (r -= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r *= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const double &e) const
+   { AutoSIMD r(*this); return (r *= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r /= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const double &e) const
+   { AutoSIMD r(*this); return (r /= e); }
+};
+#endif // __SSE2__
+
+#ifdef __AVX__
+template <>
+struct AutoSIMD<double,4>
+{
+   typedef double scalar_type;
+   static const int size = 4;
+
+   union
+   {
+      double vec[4];
+      __m256d m;
+   };
+
+   inline MFEM_ALWAYS_INLINE double &operator[](int i) { return vec[i]; }
+   inline MFEM_ALWAYS_INLINE const double &operator[](int i) const
+   { return vec[i]; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
+   { m = _mm256_set1_pd(e); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const AutoSIMD &v)
+   { m = _mm256_add_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const double &e)
+   { m = _mm256_add_pd(m, _mm256_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const AutoSIMD &v)
+   { m = _mm256_sub_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const double &e)
+   { m = _mm256_sub_pd(m, _mm256_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const AutoSIMD &v)
+   { m = _mm256_mul_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const double &e)
+   { m = _mm256_mul_pd(m, _mm256_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const AutoSIMD &v)
+   { m = _mm256_div_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const double &e)
+   { m = _mm256_div_pd(m, _mm256_set1_pd(e)); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-() const
+   { AutoSIMD r; r.m = _mm256_sub_pd(_mm256_setzero_pd(), m); return r; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r += v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const double &e) const
+   { AutoSIMD r(*this); return (r += e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r -= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const double &e) const
+   { AutoSIMD r(*this); return (r -= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r *= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const double &e) const
+   { AutoSIMD r(*this); return (r *= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r /= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const double &e) const
+   { AutoSIMD r(*this); return (r /= e); }
+};
+#endif // __AVX__
+
+#ifdef __AVX512F__
+template <>
+struct AutoSIMD<double,8>
+{
+   typedef double scalar_type;
+   static const int size = 8;
+
+   union
+   {
+      double vec[8];
+      __m512d m;
+   };
+
+   inline MFEM_ALWAYS_INLINE double &operator[](int i) { return vec[i]; }
+   inline MFEM_ALWAYS_INLINE const double &operator[](int i) const
+   { return vec[i]; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
+   { m = _mm512_set1_pd(e); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const AutoSIMD &v)
+   { m = _mm512_add_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator+=(const double &e)
+   { m = _mm512_add_pd(m, _mm512_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const AutoSIMD &v)
+   { m = _mm512_sub_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator-=(const double &e)
+   { m = _mm512_sub_pd(m, _mm512_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const AutoSIMD &v)
+   { m = _mm512_mul_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator*=(const double &e)
+   { m = _mm512_mul_pd(m, _mm512_set1_pd(e)); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const AutoSIMD &v)
+   { m = _mm512_div_pd(m, v.m); return *this; }
+   inline MFEM_ALWAYS_INLINE AutoSIMD &operator/=(const double &e)
+   { m = _mm512_div_pd(m, _mm512_set1_pd(e)); return *this; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-() const
+   { AutoSIMD r; r.m = _mm512_sub_pd(_mm512_setzero_pd(), m); return r; }
+
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r += v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator+(const double &e) const
+   { AutoSIMD r(*this); return (r += e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r -= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator-(const double &e) const
+   { AutoSIMD r(*this); return (r -= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r *= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator*(const double &e) const
+   { AutoSIMD r(*this); return (r *= e); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const AutoSIMD &v) const
+   { AutoSIMD r(*this); return (r /= v); }
+   inline MFEM_ALWAYS_INLINE AutoSIMD operator/(const double &e) const
+   { AutoSIMD r(*this); return (r /= e); }
+};
+#endif // __AVX512F__
+
+// Operations with a scalar left operand.
+
+template <typename scalar_t, int S>
+inline MFEM_ALWAYS_INLINE
+AutoSIMD<scalar_t,S> operator+(const scalar_t &e, const AutoSIMD<scalar_t,S> &v)
+{
+   return v + e;
+}
+
+template <typename scalar_t, int S>
+inline MFEM_ALWAYS_INLINE
+AutoSIMD<scalar_t,S> operator-(const scalar_t &e, const AutoSIMD<scalar_t,S> &v)
+{
+   AutoSIMD<scalar_t,S> r;
+   r = e;
+   return (r -= v);
+}
+
+template <typename scalar_t, int S>
+inline MFEM_ALWAYS_INLINE
+AutoSIMD<scalar_t,S> operator*(const scalar_t &e, const AutoSIMD<scalar_t,S> &v)
+{
+   return v * e;
+}
+
+template <typename scalar_t, int S>
+inline MFEM_ALWAYS_INLINE
+AutoSIMD<scalar_t,S> operator/(const scalar_t &e, const AutoSIMD<scalar_t,S> &v)
+{
+   AutoSIMD<scalar_t,S> r;
+   r = e;
+   return (r /= v);
+}
+
+/// The AutoSIMD type with the native SIMD width (MFEM_SIMD_SIZE bytes).
+template <typename scalar_t>
+struct NativeSIMD
+{
+   typedef AutoSIMD<scalar_t,MFEM_SIMD_SIZE/sizeof(scalar_t)> type;
+};
+
+} // namespace mfem
+
+#endif // MFEM_TEMPLATE_SIMD
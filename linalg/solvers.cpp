@@ -11,6 +11,7 @@
 
 #include "linalg.hpp"
 #include "../general/globals.hpp"
+#include "../general/profiler.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -294,6 +295,7 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("CGSolver::Mult");
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -1248,8 +1250,8 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
    MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
 
-   int it;
-   double norm0, norm, norm_goal;
+   int it, lag = 0;
+   double norm0, norm, norm_prev, norm_goal;
    const bool have_b = (b.Size() == Height());
 
    if (!iterative_mode)
@@ -1263,7 +1265,7 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
       r -= b;
    }
 
-   norm0 = norm = Norm(r);
+   norm0 = norm_prev = norm = Norm(r);
    norm_goal = std::max(rel_tol*norm, abs_tol);
 
    prec->iterative_mode = false;
@@ -1295,7 +1297,14 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
          break;
       }
 
-      prec->SetOperator(oper->GetGradient(x));
+      // With gradient lagging, DF(x_i) is replaced by the last computed
+      // gradient until it gets too old or stops reducing the residual.
+      if (lag == 0 || lag >= grad_max_lag || norm > grad_lag_rtol*norm_prev)
+      {
+         prec->SetOperator(oper->GetGradient(x));
+         lag = 0;
+      }
+      lag++;
 
       prec->Mult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
 
@@ -1312,6 +1321,7 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
       {
          r -= b;
       }
+      norm_prev = norm;
       norm = Norm(r);
    }
 
@@ -261,11 +261,15 @@ class NewtonSolver : public IterativeSolver
 protected:
    mutable Vector r, c;
 
+   int grad_max_lag;     ///< See SetGradientLagging().
+   double grad_lag_rtol; ///< See SetGradientLagging().
+
 public:
-   NewtonSolver() { }
+   NewtonSolver() : grad_max_lag(1), grad_lag_rtol(1.0) { }
 
 #ifdef MFEM_USE_MPI
-   NewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+   NewtonSolver(MPI_Comm _comm)
+      : IterativeSolver(_comm), grad_max_lag(1), grad_lag_rtol(1.0) { }
 #endif
    virtual void SetOperator(const Operator &op);
 
@@ -273,6 +277,19 @@ public:
    /** This method is equivalent to calling SetPreconditioner(). */
    virtual void SetSolver(Solver &solver) { prec = &solver; }
 
+   /** @brief Reuse the gradient, and the setup of the linear solver, for up to
+       @a max_lag consecutive iterations (modified Newton method). */
+   /** The gradient is also recomputed whenever an iteration with a lagged
+       gradient does not reduce the residual norm by at least the factor
+       @a rtol, i.e. when ||r_{i+1}|| > rtol ||r_i||. The default, @a max_lag =
+       1, corresponds to the standard Newton method. */
+   void SetGradientLagging(int max_lag, double rtol = 0.5)
+   {
+      MFEM_VERIFY(max_lag >= 1, "invalid max_lag = " << max_lag);
+      grad_max_lag = max_lag;
+      grad_lag_rtol = rtol;
+   }
+
    /// Solve the nonlinear system with right-hand side @a b.
    /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
    virtual void Mult(const Vector &b, Vector &x) const;
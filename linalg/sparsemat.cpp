@@ -2778,6 +2778,352 @@ int SparseMatrix::ActualWidth()
    return awidth;
 }
 
+FloatSparseMatrix::FloatSparseMatrix(const SparseMatrix &S, bool share_graph)
+   : Operator(S.Height(), S.Width())
+{
+   MFEM_VERIFY(S.Finalized(), "the matrix must be finalized");
+
+   const int nnz = S.NumNonZeroElems();
+   ownGraph = !share_graph;
+   if (share_graph)
+   {
+      I = S.GetI();
+      J = S.GetJ();
+   }
+   else
+   {
+      I = new int[height+1];
+      J = new int[nnz];
+      std::copy(S.GetI(), S.GetI() + height+1, I);
+      std::copy(S.GetJ(), S.GetJ() + nnz, J);
+   }
+   A = new float[nnz];
+   const double *S_data = S.GetData();
+   for (int j = 0; j < nnz; j++)
+   {
+      A[j] = (float)S_data[j];
+   }
+}
+
+void FloatSparseMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void FloatSparseMatrix::AddMult(const Vector &x, Vector &y,
+                                const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "invalid input vector size");
+   MFEM_ASSERT(height == y.Size(), "invalid output vector size");
+
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < height; i++)
+   {
+      double d = 0.0;
+      for (int j = I[i], end = I[i+1]; j < end; j++)
+      {
+         d += A[j] * xp[J[j]];
+      }
+      yp[i] += a * d;
+   }
+}
+
+void FloatSparseMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(height == x.Size(), "invalid input vector size");
+
+   y.SetSize(width);
+   y = 0.0;
+   double *yp = y.GetData();
+   for (int i = 0; i < height; i++)
+   {
+      const double xi = x(i);
+      for (int j = I[i], end = I[i+1]; j < end; j++)
+      {
+         yp[J[j]] += A[j] * xi;
+      }
+   }
+}
+
+void FloatSparseMatrix::GetDiag(Vector &d) const
+{
+   MFEM_VERIFY(height == width, "Matrix must be square, not "
+               << height << " x " << width);
+
+   d.SetSize(height);
+   for (int i = 0; i < height; i++)
+   {
+      d(i) = 0.0;
+      for (int j = I[i], end = I[i+1]; j < end; j++)
+      {
+         if (J[j] == i) { d(i) = A[j]; break; }
+      }
+   }
+}
+
+void FloatSparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
+{
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+   for (int i = 0; i < height; i++)
+   {
+      int d = -1;
+      double sum = 0.0;
+      for (int j = I[i], end = I[i+1]; j < end; j++)
+      {
+         if (J[j] == i) { d = j; }
+         else { sum += A[j] * yp[J[j]]; }
+      }
+      if (d >= 0 && A[d] != 0.0)
+      {
+         yp[i] = (xp[i] - sum) / A[d];
+      }
+      else if (xp[i] == sum)
+      {
+         yp[i] = sum;
+      }
+      else
+      {
+         MFEM_ABORT("zero diagonal in row " << i);
+      }
+   }
+}
+
+void FloatSparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
+{
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+   for (int i = height-1; i >= 0; i--)
+   {
+      int d = -1;
+      double sum = 0.0;
+      for (int j = I[i+1]-1, beg = I[i]; j >= beg; j--)
+      {
+         if (J[j] == i) { d = j; }
+         else { sum += A[j] * yp[J[j]]; }
+      }
+      if (d >= 0 && A[d] != 0.0)
+      {
+         yp[i] = (xp[i] - sum) / A[d];
+      }
+      else if (xp[i] == sum)
+      {
+         yp[i] = sum;
+      }
+      else
+      {
+         MFEM_ABORT("zero diagonal in row " << i);
+      }
+   }
+}
+
+void FloatSparseMatrix::Jacobi(const Vector &b, const Vector &x0, Vector &x1,
+                               double sc) const
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < height; i++)
+   {
+      int d = -1;
+      double sum = b(i);
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         if (J[j] == i) { d = j; }
+         else { sum -= A[j] * x0(J[j]); }
+      }
+      MFEM_VERIFY(d >= 0 && A[d] != 0.0, "zero diagonal in row " << i);
+      x1(i) = sc * (sum / A[d]) + (1.0 - sc) * x0(i);
+   }
+}
+
+void FloatSparseMatrix::Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
+                                double sc) const
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < height; i++)
+   {
+      double resi = b(i), norm = 0.0;
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         resi -= A[j] * x0(J[j]);
+         norm += fabs(A[j]);
+      }
+      MFEM_VERIFY(norm > 0.0, "L1 norm of row " << i << " is zero.");
+      x1(i) = x0(i) + sc * resi / norm;
+   }
+}
+
+FloatSparseMatrix::~FloatSparseMatrix()
+{
+   if (ownGraph)
+   {
+      delete [] I;
+      delete [] J;
+   }
+   delete [] A;
+}
+
+// Escape word of the CompressedSparseMatrix column index encoding
+static const unsigned short CSM_ESCAPE = 0xFFFF;
+
+// Decode the first column index of a row from the stream 'jc'.
+static inline int CSMFirstColumn(const unsigned short *&jc)
+{
+   const int col = jc[0] | (int(jc[1]) << 16);
+   jc += 2;
+   return col;
+}
+
+// Decode the next column index from the stream 'jc', given the previous column
+// 'col' in the row.
+static inline int CSMNextColumn(const unsigned short *&jc, int col)
+{
+   const unsigned short w = *(jc++);
+   return (w != CSM_ESCAPE) ? col + w : CSMFirstColumn(jc);
+}
+
+CompressedSparseMatrix::CompressedSparseMatrix(const SparseMatrix &S)
+   : Operator(S.Height(), S.Width())
+{
+   MFEM_VERIFY(S.Finalized(), "the matrix must be finalized");
+
+   const int *S_I = S.GetI(), *S_J = S.GetJ();
+   const double *S_A = S.GetData();
+   const int nnz = S_I[height];
+   I = new int[height+1];
+   Jc_offsets = new int[height+1];
+   A = new double[nnz];
+   std::copy(S_I, S_I + height+1, I);
+
+   // Sort the rows and encode their column indices
+   Array<Pair<int,double> > row;
+   Array<unsigned short> stream(nnz + height);
+   stream.SetSize(0);
+   for (int i = 0; i < height; i++)
+   {
+      Jc_offsets[i] = stream.Size();
+      const int beg = S_I[i], end = S_I[i+1];
+      row.SetSize(end - beg);
+      for (int j = beg; j < end; j++)
+      {
+         row[j-beg].one = S_J[j];
+         row[j-beg].two = S_A[j];
+      }
+      SortPairs<int,double>(row.GetData(), row.Size());
+      for (int j = 0; j < row.Size(); j++)
+      {
+         const int col = row[j].one;
+         A[beg+j] = row[j].two;
+         const int delta = (j == 0) ? -1 : col - row[j-1].one;
+         if (0 <= delta && delta < CSM_ESCAPE)
+         {
+            stream.Append((unsigned short)delta);
+         }
+         else
+         {
+            if (j > 0) { stream.Append(CSM_ESCAPE); }
+            stream.Append((unsigned short)(col & 0xFFFF));
+            stream.Append((unsigned short)((unsigned)col >> 16));
+         }
+      }
+   }
+   Jc_offsets[height] = stream.Size();
+   Jc = new unsigned short[stream.Size()];
+   std::copy(stream.GetData(), stream.GetData() + stream.Size(), Jc);
+}
+
+void CompressedSparseMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void CompressedSparseMatrix::AddMult(const Vector &x, Vector &y,
+                                     const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "invalid input vector size");
+   MFEM_ASSERT(height == y.Size(), "invalid output vector size");
+
+   const double *xp = x.GetData();
+   double *yp = y.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < height; i++)
+   {
+      const int beg = I[i], end = I[i+1];
+      if (beg == end) { continue; }
+      const unsigned short *jc = Jc + Jc_offsets[i];
+      int col = CSMFirstColumn(jc);
+      double d = A[beg] * xp[col];
+      for (int j = beg+1; j < end; j++)
+      {
+         col = CSMNextColumn(jc, col);
+         d += A[j] * xp[col];
+      }
+      yp[i] += a * d;
+   }
+}
+
+void CompressedSparseMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(height == x.Size(), "invalid input vector size");
+
+   y.SetSize(width);
+   y = 0.0;
+   double *yp = y.GetData();
+   for (int i = 0; i < height; i++)
+   {
+      const int beg = I[i], end = I[i+1];
+      if (beg == end) { continue; }
+      const unsigned short *jc = Jc + Jc_offsets[i];
+      const double xi = x(i);
+      int col = CSMFirstColumn(jc);
+      yp[col] += A[beg] * xi;
+      for (int j = beg+1; j < end; j++)
+      {
+         col = CSMNextColumn(jc, col);
+         yp[col] += A[j] * xi;
+      }
+   }
+}
+
+SparseMatrix *CompressedSparseMatrix::ToSparseMatrix() const
+{
+   const int nnz = I[height];
+   int *S_I = new int[height+1];
+   int *S_J = new int[nnz];
+   double *S_A = new double[nnz];
+   std::copy(I, I + height+1, S_I);
+   std::copy(A, A + nnz, S_A);
+   for (int i = 0; i < height; i++)
+   {
+      const unsigned short *jc = Jc + Jc_offsets[i];
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         S_J[j] = (j == I[i]) ? CSMFirstColumn(jc) :
+                  CSMNextColumn(jc, S_J[j-1]);
+      }
+   }
+   return new SparseMatrix(S_I, S_J, S_A, height, width);
+}
+
+CompressedSparseMatrix::~CompressedSparseMatrix()
+{
+   delete [] A;
+   delete [] Jc;
+   delete [] Jc_offsets;
+   delete [] I;
+}
+
 void SparseMatrixFunction (SparseMatrix & S, double (*f)(double))
 {
    int n = S.NumNonZeroElems();
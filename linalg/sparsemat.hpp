@@ -442,6 +442,110 @@ public:
    Type GetType() const { return MFEM_SPARSEMAT; }
 };
 
+/** @brief Finalized sparse matrix in CSR format with the entries stored in
+    single precision.
+
+    The graph (I and J arrays) is the same as the one of the SparseMatrix the
+    object is constructed from, while the entries are rounded to float. This
+    halves the memory traffic of the entries in Mult() and in the smoothers
+    FloatGSSmoother and FloatDSmoother, whose arithmetic is still performed in
+    double precision. The intended use is in preconditioners for an outer double
+    precision solver with the original SparseMatrix, e.g. FGMRESSolver or
+    SLISolver (iterative refinement), which recover the full accuracy. */
+class FloatSparseMatrix : public Operator
+{
+protected:
+   int *I, *J;
+   float *A;
+   bool ownGraph;
+
+public:
+   /** Create a single precision copy of the finalized matrix @a S. If
+       @a share_graph is true, the I and J arrays of @a S are used directly, so
+       @a S must not be destroyed or modified before this object. */
+   explicit FloatSparseMatrix(const SparseMatrix &S, bool share_graph = false);
+
+   /// Return the number of stored entries.
+   int NumNonZeroElems() const { return I[height]; }
+
+   const int *GetI() const { return I; }
+   const int *GetJ() const { return J; }
+   const float *GetData() const { return A; }
+
+   /// Matrix vector multiplication, y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = At x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Returns the diagonal of the matrix.
+   void GetDiag(Vector &d) const;
+
+   /// Gauss-Seidel forward and backward iterations over a vector x.
+   void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
+   void Gauss_Seidel_back(const Vector &x, Vector &y) const;
+
+   /// One scaled Jacobi iteration, see SparseMatrix::Jacobi().
+   void Jacobi(const Vector &b, const Vector &x0, Vector &x1, double sc) const;
+
+   /// One scaled l1-Jacobi iteration, see SparseMatrix::Jacobi2().
+   void Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
+                double sc = 1.0) const;
+
+   virtual ~FloatSparseMatrix();
+};
+
+/** @brief Finalized sparse matrix in CSR format with compressed column
+    indices.
+
+    The column indices in each row are sorted and delta-encoded in a stream of
+    16-bit words: the first column of a row takes two words and every next
+    column takes one word with the difference to the previous column. Larger
+    differences are escaped with the word 0xFFFF followed by the two words of
+    the column. For finite element matrices with a reasonable dof ordering,
+    nearly all differences fit in 16 bits, so the indices take about half of the
+    memory (and bandwidth) of the J array of a SparseMatrix. The Mult() and
+    MultTranspose() methods decode the indices on the fly. */
+class CompressedSparseMatrix : public Operator
+{
+protected:
+   int *I;                // Offsets of the rows in A
+   int *Jc_offsets;       // Offsets of the rows in Jc
+   unsigned short *Jc;    // The encoded column indices
+   double *A;
+
+public:
+   /// Create a compressed copy of the finalized matrix @a S.
+   explicit CompressedSparseMatrix(const SparseMatrix &S);
+
+   /// Return the number of stored entries.
+   int NumNonZeroElems() const { return I[height]; }
+
+   /// Return the memory (in bytes) used by the row offsets and the indices.
+   long IndexMemoryUsage() const
+   {
+      return (long)sizeof(int)*2*(height+1) +
+             (long)sizeof(unsigned short)*Jc_offsets[height];
+   }
+
+   /// Matrix vector multiplication, y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = At x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Return the uncompressed matrix as a new SparseMatrix.
+   SparseMatrix *ToSparseMatrix() const;
+
+   virtual ~CompressedSparseMatrix();
+};
+
 /// Applies f() to each element of the matrix (after it is finalized).
 void SparseMatrixFunction(SparseMatrix &S, double (*f)(double));
 
@@ -108,4 +108,75 @@ void DSmoother::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void FloatSparseSmoother::SetOperator(const Operator &a)
+{
+   delete own_oper;
+   own_oper = NULL;
+   oper = dynamic_cast<const FloatSparseMatrix*>(&a);
+   if (oper == NULL)
+   {
+      const SparseMatrix *S = dynamic_cast<const SparseMatrix*>(&a);
+      MFEM_VERIFY(S, "not a FloatSparseMatrix or a SparseMatrix!");
+      oper = own_oper = new FloatSparseMatrix(*S);
+   }
+   height = oper->Height();
+   width = oper->Width();
+}
+
+void FloatGSSmoother::Mult(const Vector &x, Vector &y) const
+{
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   for (int i = 0; i < iterations; i++)
+   {
+      if (type != 2)
+      {
+         oper->Gauss_Seidel_forw(x, y);
+      }
+      if (type != 1)
+      {
+         oper->Gauss_Seidel_back(x, y);
+      }
+   }
+}
+
+void FloatDSmoother::Mult(const Vector &x, Vector &y) const
+{
+   z.SetSize(width);
+
+   Vector *r = &y, *p = &z;
+
+   if (iterations % 2 == 0)
+   {
+      Swap<Vector*>(r, p);
+   }
+
+   if (!iterative_mode)
+   {
+      *p = 0.0;
+   }
+   else if (iterations % 2)
+   {
+      *p = y;
+   }
+   for (int i = 0; i < iterations; i++)
+   {
+      if (type == 0)
+      {
+         oper->Jacobi(x, *p, *r, scale);
+      }
+      else if (type == 1)
+      {
+         oper->Jacobi2(x, *p, *r, scale);
+      }
+      else
+      {
+         MFEM_ABORT("wrong type");
+      }
+      Swap<Vector*>(r, p);
+   }
+}
+
 }
@@ -73,6 +73,65 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 };
 
+/** Base class for smoothers of a FloatSparseMatrix. The operator can also be
+    a finalized SparseMatrix, in which case a FloatSparseMatrix copy of it is
+    created and owned by the smoother. */
+class FloatSparseSmoother : public Solver
+{
+protected:
+   const FloatSparseMatrix *oper;
+   FloatSparseMatrix *own_oper;
+
+public:
+   FloatSparseSmoother() : oper(NULL), own_oper(NULL) { }
+
+   virtual void SetOperator(const Operator &a);
+
+   virtual ~FloatSparseSmoother() { delete own_oper; }
+};
+
+/// Gauss-Seidel smoother with the matrix entries stored in single precision
+class FloatGSSmoother : public FloatSparseSmoother
+{
+protected:
+   int type; // 0, 1, 2 - symmetric, forward, backward
+   int iterations;
+
+public:
+   /// Create FloatGSSmoother.
+   FloatGSSmoother(int t = 0, int it = 1) { type = t; iterations = it; }
+
+   /// Create FloatGSSmoother.
+   FloatGSSmoother(const Operator &a, int t = 0, int it = 1)
+   { type = t; iterations = it; SetOperator(a); }
+
+   /// Matrix vector multiplication with GS Smoother.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+/// Jacobi-type smoother with the matrix entries stored in single precision
+class FloatDSmoother : public FloatSparseSmoother
+{
+protected:
+   int type; // 0, 1 - scaled Jacobi, scaled l1-Jacobi
+   double scale;
+   int iterations;
+
+   mutable Vector z;
+
+public:
+   /// Create Jacobi smoother.
+   FloatDSmoother(int t = 0, double s = 1., int it = 1)
+   { type = t; scale = s; iterations = it; }
+
+   /// Create Jacobi smoother.
+   FloatDSmoother(const Operator &a, int t = 0, double s = 1., int it = 1)
+   { type = t; scale = s; iterations = it; SetOperator(a); }
+
+   /// Matrix vector multiplication with Jacobi smoother.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
 }
 
 #endif
@@ -15,6 +15,7 @@
 #include "../fem/fem.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
+#include "../general/profiler.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -24,6 +25,7 @@
 #include <cstring>
 #include <ctime>
 #include <functional>
+#include <algorithm>
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -1329,6 +1331,138 @@ void Mesh::GetGeckoElementReordering(Array<int> &ordering)
 #endif
 
 
+// Comparison of two points, given by their indices in the array 'pts', along
+// the coordinate 'coord' in increasing (up = true) or decreasing order.
+class SFCCompare
+{
+private:
+   const double *pts;
+   int sdim, coord;
+   bool up;
+
+public:
+   SFCCompare(const double *p, int sd, int c, bool u)
+      : pts(p), sdim(sd), coord(c), up(u) { }
+
+   bool operator()(int a, int b) const
+   {
+      const double pa = pts[a*sdim + coord], pb = pts[b*sdim + coord];
+      return up ? (pa < pb) : (pa > pb);
+   }
+};
+
+// Split the range [beg,end) at its median point along 'coord'.
+static int *SFCSplit(int *beg, int *end, const double *pts, int sdim,
+                     int coord, bool up)
+{
+   if (beg >= end) { return beg; }
+   int *mid = beg + (end - beg)/2;
+   std::nth_element(beg, mid, end, SFCCompare(pts, sdim, coord, up));
+   return mid;
+}
+
+// Recursive median-based Hilbert sort of the points [beg,end) in 2D, where the
+// first split is along the coordinate x in the direction upx.
+static void HilbertSort2D(int *beg, int *end, const double *pts, int x,
+                          bool upx, bool upy)
+{
+   if (end - beg <= 1) { return; }
+   const int y = (x + 1) % 2;
+   int *m0 = beg, *m4 = end;
+   int *m2 = SFCSplit(m0, m4, pts, 2, x, upx);
+   int *m1 = SFCSplit(m0, m2, pts, 2, y, upy);
+   int *m3 = SFCSplit(m2, m4, pts, 2, y, !upy);
+   HilbertSort2D(m0, m1, pts, y, upy, upx);
+   HilbertSort2D(m1, m2, pts, x, upx, upy);
+   HilbertSort2D(m2, m3, pts, x, upx, upy);
+   HilbertSort2D(m3, m4, pts, y, !upy, !upx);
+}
+
+// Recursive median-based Hilbert sort of the points [beg,end) in 3D.
+static void HilbertSort3D(int *beg, int *end, const double *pts, int x,
+                          bool upx, bool upy, bool upz)
+{
+   if (end - beg <= 1) { return; }
+   const int y = (x + 1) % 3, z = (x + 2) % 3;
+   int *m0 = beg, *m8 = end;
+   int *m4 = SFCSplit(m0, m8, pts, 3, x, upx);
+   int *m2 = SFCSplit(m0, m4, pts, 3, y, upy);
+   int *m1 = SFCSplit(m0, m2, pts, 3, z, upz);
+   int *m3 = SFCSplit(m2, m4, pts, 3, z, !upz);
+   int *m6 = SFCSplit(m4, m8, pts, 3, y, !upy);
+   int *m5 = SFCSplit(m4, m6, pts, 3, z, upz);
+   int *m7 = SFCSplit(m6, m8, pts, 3, z, !upz);
+   HilbertSort3D(m0, m1, pts, z, upz, upx, upy);
+   HilbertSort3D(m1, m2, pts, y, upy, upz, upx);
+   HilbertSort3D(m2, m3, pts, y, upy, upz, upx);
+   HilbertSort3D(m3, m4, pts, x, upx, !upy, !upz);
+   HilbertSort3D(m4, m5, pts, x, upx, !upy, !upz);
+   HilbertSort3D(m5, m6, pts, y, !upy, upz, !upx);
+   HilbertSort3D(m6, m7, pts, y, !upy, upz, !upx);
+   HilbertSort3D(m7, m8, pts, z, !upz, !upx, upy);
+}
+
+// Recursive median-based Morton (Z-order) sort of the points [beg,end): split
+// along x, then along the next coordinate in each half, and so on.
+static void MortonSort(int *beg, int *end, const double *pts, int sdim, int x)
+{
+   if (end - beg <= 1) { return; }
+   int *mid = SFCSplit(beg, end, pts, sdim, x, true);
+   MortonSort(beg, mid, pts, sdim, (x + 1) % sdim);
+   MortonSort(mid, end, pts, sdim, (x + 1) % sdim);
+}
+
+void Mesh::GetSFCElementOrdering(Array<int> &ordering, bool hilbert) const
+{
+   const int NE = GetNE(), sdim = spaceDim;
+
+   // The element centers are approximated by the average of their vertices,
+   // which is enough for the ordering and much cheaper than the mapping of
+   // the reference center with the element transformation.
+   Array<double> pts(NE*sdim);
+   Array<int> v;
+   for (int i = 0; i < NE; i++)
+   {
+      elements[i]->GetVertices(v);
+      for (int d = 0; d < sdim; d++)
+      {
+         double c = 0.0;
+         for (int j = 0; j < v.Size(); j++)
+         {
+            c += vertices[v[j]](d);
+         }
+         pts[i*sdim + d] = c/v.Size();
+      }
+   }
+
+   Array<int> sorted(NE);
+   for (int i = 0; i < NE; i++) { sorted[i] = i; }
+   int *beg = sorted.GetData(), *end = beg + NE;
+   if (sdim == 1)
+   {
+      std::sort(beg, end, SFCCompare(pts.GetData(), 1, 0, true));
+   }
+   else if (!hilbert)
+   {
+      MortonSort(beg, end, pts.GetData(), sdim, 0);
+   }
+   else if (sdim == 2)
+   {
+      HilbertSort2D(beg, end, pts.GetData(), 0, true, true);
+   }
+   else
+   {
+      HilbertSort3D(beg, end, pts.GetData(), 0, true, true, true);
+   }
+
+   ordering.SetSize(NE);
+   for (int k = 0; k < NE; k++)
+   {
+      ordering[sorted[k]] = k;
+   }
+}
+
+
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
    if (NURBSext)
@@ -3993,6 +4127,321 @@ void Mesh::GetEdgeVertices(int i, Array<int> &vert) const
    edge_vertex->GetRow(i, vert);
 }
 
+#ifdef MFEM_USE_OPENMP
+// Sort-based table of the mesh edges or faces, given by tuples of N = 2 or 3
+// vertex indices. The occurrences of the tuples, e.g. the edges of all
+// elements, are added in the order of the element loop and the entities are
+// numbered in the order of their first occurrence, which is the numbering
+// given by DSTable and STable3D. Instead of the linked lists of these classes,
+// the occurrences are bucketed by their smallest vertex with a counting sort,
+// in two passes like the construction of a Table:
+//
+//    tbl.Count(...) for all occurrences, tbl.MakeRows(),
+//    tbl.Add(..., k) for all occurrences k = 0, 1, ..., tbl.Finalize(number),
+//
+// and the (short) rows are sorted independently, in parallel. This table is
+// used only with OpenMP: serially, DSTable and STable3D are faster and store
+// less data (N int's per occurrence here vs. one node per entity there).
+template <int N> class VertexTupleTable
+{
+private:
+   struct Entry
+   {
+      int v[N-1], idx; // the other vertices, occurrence/entity number
+
+      bool SameTuple(const Entry &e) const
+      {
+         for (int i = 0; i < N-1; i++) { if (v[i] != e.v[i]) { return false; } }
+         return true;
+      }
+      bool operator<(const Entry &e) const
+      {
+         for (int i = 0; i < N-1; i++)
+         {
+            if (v[i] != e.v[i]) { return (v[i] < e.v[i]); }
+         }
+         return (idx < e.idx);
+      }
+   };
+
+   int nv, num_entities;
+   Array<int> I;
+   Array<Entry> entries;
+
+   static void Sort3(int &a, int &b, int &c)
+   {
+      if (a > b) { std::swap(a, b); }
+      if (b > c) { std::swap(b, c); }
+      if (a > b) { std::swap(a, b); }
+   }
+   static int Min(int a, int b) { return std::min(a, b); }
+   static int Min(int a, int b, int c) { return std::min(std::min(a, b), c); }
+
+   void AddSorted(int a, int b, int c, int k)
+   {
+      Entry &e = entries[I[a]++];
+      e.v[0] = b;
+      if (N == 3) { e.v[N-2] = c; }
+      e.idx = k;
+   }
+
+   int Find(int a, int b, int c) const
+   {
+      if (a < 0 || a >= nv) { return -1; }
+      Entry key;
+      key.v[0] = b;
+      if (N == 3) { key.v[N-2] = c; }
+      key.idx = -1;
+      const Entry *beg = entries.GetData() + I[a];
+      const Entry *end = entries.GetData() + I[a+1];
+      const Entry *pos = std::lower_bound(beg, end, key);
+      return (pos != end && pos->SameTuple(key)) ? pos->idx : -1;
+   }
+
+public:
+   VertexTupleTable(int nverts) : nv(nverts), num_entities(0), I(nverts+1)
+   { I = 0; }
+
+   /// Count an occurrence of an edge.
+   void Count(int a, int b) { I[Min(a, b)+1]++; }
+   /// Count an occurrence of a triangular face.
+   void Count(int a, int b, int c) { I[Min(a, b, c)+1]++; }
+   /** Count an occurrence of a quadrilateral face, which is identified by its
+       3 smallest vertices, as in STable3D. */
+   void Count(int a, int b, int c, int d) { I[Min(Min(a, b), c, d)+1]++; }
+
+   /// Allocate the entries, after all occurrences are counted.
+   void MakeRows()
+   {
+      I.PartialSum();
+      entries.SetSize(I[nv]);
+   }
+
+   /** Add the occurrence number @a k of an edge or a face. The occurrences
+       must be added in the order k = 0, 1, ... */
+   void Add(int a, int b, int k)
+   {
+      if (a > b) { std::swap(a, b); }
+      AddSorted(a, b, 0, k);
+   }
+   void Add(int a, int b, int c, int k)
+   {
+      Sort3(a, b, c);
+      AddSorted(a, b, c, k);
+   }
+   void Add(int a, int b, int c, int d, int k)
+   {
+      // Sort the 4 vertices and skip the largest one
+      Sort3(a, b, c);
+      Sort3(a, b, d);
+      AddSorted(a, std::min(b, c), std::max(b, c) > d ? d : std::max(b, c),
+                k);
+   }
+
+   /** Number the entities and return in @a number (an array of the size of
+       the number of occurrences) the entity number of each occurrence. */
+   void Finalize(int *number);
+
+   /// Return the number of occurrences, before Finalize().
+   int NumberOfOccurrences() const { return entries.Size(); }
+   int NumberOfEntities() const { return num_entities; }
+
+   /// Return the number of an entity, or -1 if it is not in the table.
+   int operator()(int a, int b) const
+   { return (a <= b) ? Find(a, b, 0) : Find(b, a, 0); }
+   int operator()(int a, int b, int c) const
+   {
+      Sort3(a, b, c);
+      return Find(a, b, c);
+   }
+   int operator()(int a, int b, int c, int d) const
+   {
+      Sort3(a, b, c);
+      Sort3(a, b, d);
+      return Find(a, std::min(b, c), std::max(b, c) > d ? d : std::max(b, c));
+   }
+
+   /// Return the vertices of the edges, sorted, as rows of @a edge_vertex.
+   void GetEdgeVertices(Table &edge_vertex) const;
+};
+
+template <int N>
+void VertexTupleTable<N>::Finalize(int *number)
+{
+   // Restore the row offsets, shifted by Add()
+   for (int r = nv; r > 0; r--) { I[r] = I[r-1]; }
+   I[0] = 0;
+
+   // Sort the rows and mark the first occurrence ('leader') of each entity in
+   // 'number'. The unique entries are moved to the front of their rows and
+   // their count is kept in 'row_size'.
+   Array<int> row_size(nv);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int r = 0; r < nv; r++)
+   {
+      Entry *row = entries.GetData() + I[r];
+      const int size = I[r+1] - I[r];
+      if (size > 16)
+      {
+         std::sort(row, row + size);
+      }
+      else
+      {
+         // The entries were added in increasing 'idx', so a stable insertion
+         // sort by the tuple is enough
+         for (int j = 1; j < size; j++)
+         {
+            const Entry e = row[j];
+            int i = j;
+            for ( ; i > 0 && e < row[i-1]; i--) { row[i] = row[i-1]; }
+            row[i] = e;
+         }
+      }
+      int cnt = 0;
+      for (int j = 0; j < size; j++)
+      {
+         if (cnt == 0 || !row[j].SameTuple(row[cnt-1]))
+         {
+            row[cnt++] = row[j];
+         }
+         number[row[j].idx] = row[cnt-1].idx;
+      }
+      row_size[r] = cnt;
+   }
+
+   // Number the entities in the order of their first occurrence; the leader
+   // of an occurrence precedes it, so it is already numbered
+   const int n = I[nv];
+   num_entities = 0;
+   for (int k = 0; k < n; k++)
+   {
+      number[k] = (number[k] == k) ? num_entities++ : number[number[k]];
+   }
+
+   // Keep one entry per entity, with its number
+   int cnt = 0;
+   for (int r = 0; r < nv; r++)
+   {
+      const int beg = I[r];
+      I[r] = cnt;
+      for (int j = 0; j < row_size[r]; j++)
+      {
+         Entry &e = entries[cnt++];
+         e = entries[beg + j];
+         e.idx = number[e.idx];
+      }
+   }
+   I[nv] = cnt;
+   entries.SetSize(cnt);
+}
+
+template <int N>
+void VertexTupleTable<N>::GetEdgeVertices(Table &edge_vertex) const
+{
+   MFEM_ASSERT(N == 2, "the table does not contain edges");
+   int *ev_I = new int[num_entities+1], *ev_J = new int[2*num_entities];
+   for (int i = 0; i <= num_entities; i++) { ev_I[i] = 2*i; }
+   for (int r = 0; r < nv; r++)
+   {
+      for (int j = I[r]; j < I[r+1]; j++)
+      {
+         ev_J[2*entries[j].idx] = r;
+         ev_J[2*entries[j].idx+1] = entries[j].v[0];
+      }
+   }
+   edge_vertex.SetIJ(ev_I, ev_J, num_entities);
+}
+
+// Count (pass 0) or add (pass 1) the edges of the first 'ne' elements of 'elems'
+// to 'edges'. The occurrences are numbered starting with 'k'.
+static void AddElementEdges(int pass, const Array<Element *> &elems, int ne,
+                            VertexTupleTable<2> &edges, int k)
+{
+   for (int i = 0; i < ne; i++)
+   {
+      const int *v = elems[i]->GetVertices();
+      const int nedges = elems[i]->GetNEdges();
+      for (int j = 0; j < nedges; j++)
+      {
+         const int *e = elems[i]->GetEdgeVertices(j);
+         if (pass == 0) { edges.Count(v[e[0]], v[e[1]]); }
+         else { edges.Add(v[e[0]], v[e[1]], k++); }
+      }
+   }
+}
+
+// Count (pass 0) or add (pass 1) the faces of the first 'ne' elements of
+// 'elems' to 'faces', in the same order as GetElementToFaceTable().
+static void AddElementFaces(int pass, const Array<Element *> &elems, int ne,
+                            VertexTupleTable<3> &faces)
+{
+   typedef Geometry::Constants<Geometry::TETRAHEDRON> tet_t;
+   typedef Geometry::Constants<Geometry::PRISM>       pri_t;
+   typedef Geometry::Constants<Geometry::CUBE>        hex_t;
+
+   int k = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      const int *v = elems[i]->GetVertices();
+      switch (elems[i]->GetType())
+      {
+         case Element::TETRAHEDRON:
+         {
+            for (int j = 0; j < 4; j++)
+            {
+               const int *fv = tet_t::FaceVert[j];
+               if (pass == 0) { faces.Count(v[fv[0]], v[fv[1]], v[fv[2]]); }
+               else { faces.Add(v[fv[0]], v[fv[1]], v[fv[2]], k++); }
+            }
+            break;
+         }
+         case Element::WEDGE:
+         {
+            for (int j = 0; j < 2; j++)
+            {
+               const int *fv = pri_t::FaceVert[j];
+               if (pass == 0) { faces.Count(v[fv[0]], v[fv[1]], v[fv[2]]); }
+               else { faces.Add(v[fv[0]], v[fv[1]], v[fv[2]], k++); }
+            }
+            for (int j = 2; j < 5; j++)
+            {
+               const int *fv = pri_t::FaceVert[j];
+               if (pass == 0)
+               {
+                  faces.Count(v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]]);
+               }
+               else
+               {
+                  faces.Add(v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]], k++);
+               }
+            }
+            break;
+         }
+         case Element::HEXAHEDRON:
+         {
+            for (int j = 0; j < 6; j++)
+            {
+               const int *fv = hex_t::FaceVert[j];
+               if (pass == 0)
+               {
+                  faces.Count(v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]]);
+               }
+               else
+               {
+                  faces.Add(v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]], k++);
+               }
+            }
+            break;
+         }
+         default:
+            MFEM_ABORT("Unexpected type of Element.");
+      }
+   }
+}
+#endif // MFEM_USE_OPENMP
+
 Table *Mesh::GetFaceEdgeTable() const
 {
    if (face_edge)
@@ -4028,6 +4477,18 @@ Table *Mesh::GetEdgeVertexTable() const
       return edge_vertex;
    }
 
+#ifdef MFEM_USE_OPENMP
+   VertexTupleTable<2> edges(NumOfVertices);
+   AddElementEdges(0, elements, NumOfElements, edges, 0);
+   edges.MakeRows();
+   AddElementEdges(1, elements, NumOfElements, edges, 0);
+   Array<int> edge_number(edges.NumberOfOccurrences());
+   edges.Finalize(edge_number.GetData());
+   edge_number.DeleteAll();
+
+   edge_vertex = new Table;
+   edges.GetEdgeVertices(*edge_vertex);
+#else
    DSTable v_to_v(NumOfVertices);
    GetVertexToVertexTable(v_to_v);
 
@@ -4043,6 +4504,7 @@ Table *Mesh::GetEdgeVertexTable() const
       }
    }
    edge_vertex->Finalize();
+#endif
 
    return edge_vertex;
 }
@@ -4313,8 +4775,94 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
    }
 }
 
+#ifdef MFEM_USE_OPENMP
+int Mesh::BuildElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
+{
+   int i, NumberOfEdges;
+
+   // The existing edges keep their numbers, see GetVertexToVertexTable()
+   const int nev = edge_vertex ? edge_vertex->Size() : 0;
+   VertexTupleTable<2> edges(NumOfVertices);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (i = 0; i < nev; i++)
+      {
+         const int *v = edge_vertex->GetRow(i);
+         if (pass == 0) { edges.Count(v[0], v[1]); }
+         else { edges.Add(v[0], v[1], i); }
+      }
+      AddElementEdges(pass, elements, NumOfElements, edges, nev);
+      if (pass == 0) { edges.MakeRows(); }
+   }
+
+   // Fill the element to edge table
+   int *I = new int[NumOfElements+1];
+   I[0] = 0;
+   for (i = 0; i < NumOfElements; i++)
+   {
+      I[i+1] = I[i] + elements[i]->GetNEdges();
+   }
+   int *J = new int[nev + I[NumOfElements]];
+   edges.Finalize(J);
+   NumberOfEdges = edges.NumberOfEntities();
+   if (nev > 0)
+   {
+      int *J_el = new int[I[NumOfElements]];
+      std::copy(J + nev, J + nev + I[NumOfElements], J_el);
+      delete [] J;
+      J = J_el;
+   }
+   e_to_f.SetIJ(I, J, NumOfElements);
+
+   if (Dim == 2)
+   {
+      // Initialize the indices for the boundary elements.
+      be_to_f.SetSize(NumOfBdrElements);
+      for (i = 0; i < NumOfBdrElements; i++)
+      {
+         const int *v = boundary[i]->GetVertices();
+         be_to_f[i] = edges(v[0], v[1]);
+      }
+   }
+   else if (Dim == 3)
+   {
+      if (bel_to_edge == NULL)
+      {
+         bel_to_edge = new Table;
+      }
+      bel_to_edge->MakeI(NumOfBdrElements);
+      for (i = 0; i < NumOfBdrElements; i++)
+      {
+         bel_to_edge->AddColumnsInRow(i, boundary[i]->GetNEdges());
+      }
+      bel_to_edge->MakeJ();
+      for (i = 0; i < NumOfBdrElements; i++)
+      {
+         const int *v = boundary[i]->GetVertices();
+         const int ne = boundary[i]->GetNEdges();
+         for (int j = 0; j < ne; j++)
+         {
+            const int *e = boundary[i]->GetEdgeVertices(j);
+            bel_to_edge->AddConnection(i, edges(v[e[0]], v[e[1]]));
+         }
+      }
+      bel_to_edge->ShiftUpI();
+   }
+   else
+   {
+      mfem_error("1D GetElementToEdgeTable is not yet implemented.");
+   }
+
+   // Return the number of edges
+   return NumberOfEdges;
+}
+#endif // MFEM_USE_OPENMP
+
 int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
 {
+#ifdef MFEM_USE_OPENMP
+   return BuildElementToEdgeTable(e_to_f, be_to_f);
+#else
    int i, NumberOfEdges;
 
    DSTable v_to_v(NumOfVertices);
@@ -4350,6 +4898,7 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
 
    // Return the number of edges
    return NumberOfEdges;
+#endif
 }
 
 const Table & Mesh::ElementToElementTable()
@@ -4627,7 +5176,8 @@ void Mesh::GenerateNCFaceInfo()
       NCFaceInfo &master_nc = nc_faces_info[master_fi.NCFace];
 
       slave_fi.NCFace = nc_faces_info.Size();
-      nc_faces_info.Append(NCFaceInfo(true, slave.master, &slave.point_matrix));
+      nc_faces_info.Append(NCFaceInfo(true, slave.master,
+                                       list.point_matrices[slave.matrix]));
 
       slave_fi.Elem2No = master_fi.Elem1No;
       slave_fi.Elem2Inf = 64 * master_nc.MasterFace; // get lf no. stored above
@@ -4684,6 +5234,55 @@ STable3D *Mesh::GetFacesTable()
    return faces_tbl;
 }
 
+#ifdef MFEM_USE_OPENMP
+void Mesh::BuildElementToFaceTable()
+{
+   int i, *v;
+
+   // The faces are numbered in the same order as with STable3D in
+   // GetElementToFaceTable()
+   VertexTupleTable<3> faces_tbl(NumOfVertices);
+   AddElementFaces(0, elements, NumOfElements, faces_tbl);
+   faces_tbl.MakeRows();
+   AddElementFaces(1, elements, NumOfElements, faces_tbl);
+
+   int *I = new int[NumOfElements+1];
+   I[0] = 0;
+   for (i = 0; i < NumOfElements; i++)
+   {
+      I[i+1] = I[i] + Geometry::NumFaces[elements[i]->GetGeometryType()];
+   }
+   int *J = new int[I[NumOfElements]];
+   faces_tbl.Finalize(J);
+   el_to_face = new Table;
+   el_to_face->SetIJ(I, J, NumOfElements);
+   NumOfFaces = faces_tbl.NumberOfEntities();
+
+   be_to_face.SetSize(NumOfBdrElements);
+   for (i = 0; i < NumOfBdrElements; i++)
+   {
+      v = boundary[i]->GetVertices();
+      switch (GetBdrElementType(i))
+      {
+         case Element::TRIANGLE:
+         {
+            be_to_face[i] = faces_tbl(v[0], v[1], v[2]);
+            break;
+         }
+         case Element::QUADRILATERAL:
+         {
+            be_to_face[i] = faces_tbl(v[0], v[1], v[2], v[3]);
+            break;
+         }
+         default:
+            MFEM_ABORT("Unexpected type of boundary Element.");
+      }
+      MFEM_VERIFY(be_to_face[i] >= 0, "boundary element " << i
+                  << " is not a face of the mesh");
+   }
+}
+#endif // MFEM_USE_OPENMP
+
 STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
 {
    int i, *v;
@@ -4692,7 +5291,15 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    if (el_to_face != NULL)
    {
       delete el_to_face;
+      el_to_face = NULL;
+   }
+#ifdef MFEM_USE_OPENMP
+   if (!ret_ftbl)
+   {
+      BuildElementToFaceTable();
+      return NULL;
    }
+#endif
    el_to_face = new Table(NumOfElements, 6);  // must be 6 for hexahedra
    faces_tbl = new STable3D(NumOfVertices);
    for (i = 0; i < NumOfElements; i++)
@@ -5741,6 +6348,24 @@ void Mesh::UpdateNodes()
    }
 }
 
+// Return in 'owner' the last row of 'el_to_ent' that contains each of the
+// 'num_ent' entities. In the threaded uniform refinement, the new vertex of an
+// edge or a face is computed only by its owner, i.e. with the same vertex order
+// as in the serial element loop, where the last element wins.
+static void GetLastOwners(const Table &el_to_ent, int num_ent,
+                          Array<int> &owner)
+{
+   const int *I = el_to_ent.GetI(), *J = el_to_ent.GetJ();
+   owner.SetSize(num_ent);
+   for (int i = 0; i < el_to_ent.Size(); i++)
+   {
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         owner[J[j]] = i;
+      }
+   }
+}
+
 void Mesh::UniformRefinement2D()
 {
    DeleteLazyTables();
@@ -5751,21 +6376,28 @@ void Mesh::UniformRefinement2D()
       NumOfEdges = GetElementToEdgeTable(*el_to_edge, be_to_edge);
    }
 
-   int quad_counter = 0;
+   // Offsets of the new vertices at the centers of the quadrilaterals
+   Array<int> quad_offset(NumOfElements+1);
+   quad_offset[0] = 0;
    for (int i = 0; i < NumOfElements; i++)
    {
-      if (elements[i]->GetType() == Element::QUADRILATERAL)
-      {
-         quad_counter++;
-      }
+      quad_offset[i+1] = quad_offset[i] +
+                         (elements[i]->GetType() == Element::QUADRILATERAL);
    }
+   const int quad_counter = quad_offset[NumOfElements];
+
+   // The midpoint of each edge is computed by the last element containing it
+   Array<int> edge_owner;
+   GetLastOwners(*el_to_edge, NumOfEdges, edge_owner);
 
    const int oedge = NumOfVertices;
    const int oelem = oedge + NumOfEdges;
 
    vertices.SetSize(oelem + quad_counter);
    elements.SetSize(4 * NumOfElements);
-   quad_counter = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < NumOfElements; i++)
    {
       const Element::Type el_type = elements[i]->GetType();
@@ -5779,6 +6411,7 @@ void Mesh::UniformRefinement2D()
       {
          for (int ei = 0; ei < 3; ei++)
          {
+            if (edge_owner[e[ei]] != i) { continue; }
             for (int k = 0; k < 2; k++)
             {
                vv[k] = v[tri_t::Edges[ei][k]];
@@ -5795,12 +6428,12 @@ void Mesh::UniformRefinement2D()
       }
       else if (el_type == Element::QUADRILATERAL)
       {
-         const int qe = quad_counter;
-         quad_counter++;
+         const int qe = quad_offset[i];
          AverageVertices(v, 4, oelem+qe);
 
          for (int ei = 0; ei < 4; ei++)
          {
+            if (edge_owner[e[ei]] != i) { continue; }
             for (int k = 0; k < 2; k++)
             {
                vv[k] = v[quad_t::Edges[ei][k]];
@@ -5826,6 +6459,9 @@ void Mesh::UniformRefinement2D()
    }
 
    boundary.SetSize(2 * NumOfBdrElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < NumOfBdrElements; i++)
    {
       const int attr = boundary[i]->GetAttribute();
@@ -5859,6 +6495,9 @@ void Mesh::UniformRefinement2D()
    UseExternalData(quad_children, 2, 4, 4);
    CoarseFineTr.embeddings.SetSize(elements.Size());
 
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < elements.Size(); i++)
    {
       Embedding &emb = CoarseFineTr.embeddings[i];
@@ -5930,16 +6569,23 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
       }
    }
 
-   int hex_counter = 0;
-   if (HasGeometry(Geometry::CUBE))
+   // Offsets of the new vertices at the centers of the hexahedra
+   Array<int> hex_offset(NumOfElements+1);
+   hex_offset[0] = 0;
+   for (int i = 0; i < NumOfElements; i++)
    {
-      for (int i = 0; i < elements.Size(); i++)
-      {
-         if (elements[i]->GetType() == Element::HEXAHEDRON)
-         {
-            hex_counter++;
-         }
-      }
+      hex_offset[i+1] = hex_offset[i] +
+                        (elements[i]->GetType() == Element::HEXAHEDRON);
+   }
+   const int hex_counter = hex_offset[NumOfElements];
+
+   // The midpoint of each edge and quadrilateral face is computed by the last
+   // element containing it
+   Array<int> edge_owner, face_owner;
+   GetLastOwners(*el_to_edge, NumOfEdges, edge_owner);
+   if (NumOfQuadFaces > 0)
+   {
+      GetLastOwners(*el_to_face, faces.Size(), face_owner);
    }
 
    // Map from edge-index to vertex-index, needed for ReorientTetMesh() for
@@ -5998,13 +6644,28 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
    vertices.SetSize(oelem + hex_counter);
    elements.SetSize(8 * NumOfElements);
    CoarseFineTr.embeddings.SetSize(elements.Size());
-   hex_counter = 0;
+#ifdef MFEM_USE_MEMALLOC
+   // TetMemory is not thread-safe, so the new tetrahedra are allocated here
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      if (elements[i]->GetType() == Element::TETRAHEDRON)
+      {
+         for (int k = 0; k < 7; k++)
+         {
+            elements[NumOfElements + 7 * i + k] = TetMemory.Alloc();
+         }
+      }
+   }
+#endif
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < NumOfElements; i++)
    {
       const Element::Type el_type = elements[i]->GetType();
       const int attr = elements[i]->GetAttribute();
       int *v = elements[i]->GetVertices();
-      const int *e = el_to_edge->GetRow(i);
+      const int *el_e = el_to_edge->GetRow(i), *e = el_e;
       const int j = NumOfElements + 7 * i;
       int vv[4], ev[12];
 
@@ -6021,6 +6682,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
          {
             for (int ei = 0; ei < 6; ei++)
             {
+               if (edge_owner[el_e[ei]] != i) { continue; }
                for (int k = 0; k < 2; k++)
                {
                   vv[k] = v[tet_t::Edges[ei][k]];
@@ -6036,9 +6698,10 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
             // 0: (v0,v1)-(v2,v3), 1: (v0,v2)-(v1,v3), 2: (v0,v3)-(v1,v2)
             // 0:      e0-e5,      1:      e1-e4,      2:      e2-e3
             int rt;
-            ElementTransformation *T = GetElementTransformation(i);
-            T->SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
-            const DenseMatrix &J = T->Jacobian();
+            IsoparametricTransformation T;
+            GetElementTransformation(i, &T);
+            T.SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
+            const DenseMatrix &J = T.Jacobian();
             if (rt_algo == 0)
             {
                // smallest octahedron diagonal
@@ -6165,15 +6828,15 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
             }
 #else
             Tetrahedron *tet;
-            elements[j+0] = tet = TetMemory.Alloc();
+            tet = (Tetrahedron *) elements[j+0];
             tet->Init(oedge+e[0], v[1], oedge+e[3], oedge+e[4], attr);
-            elements[j+1] = tet = TetMemory.Alloc();
+            tet = (Tetrahedron *) elements[j+1];
             tet->Init(oedge+e[1], oedge+e[3], v[2], oedge+e[5], attr);
-            elements[j+2] = tet = TetMemory.Alloc();
+            tet = (Tetrahedron *) elements[j+2];
             tet->Init(oedge+e[2], oedge+e[4], oedge+e[5], v[3], attr);
             for (int k = 0; k < 4; k++)
             {
-               elements[j+k+3] = tet = TetMemory.Alloc();
+               tet = (Tetrahedron *) elements[j+k+3];
                tet->Init(oedge+e[mv[k][0]], oedge+e[mv[k][1]],
                          oedge+e[mv[k][2]], oedge+e[mv[k][3]], attr);
             }
@@ -6205,6 +6868,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
 
             for (int fi = 2; fi < 5; fi++)
             {
+               if (face_owner[f[fi]] != i) { continue; }
                for (int k = 0; k < 4; k++)
                {
                   vv[k] = v[pri_t::FaceVert[fi][k]];
@@ -6214,6 +6878,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
 
             for (int ei = 0; ei < 9; ei++)
             {
+               if (edge_owner[el_e[ei]] != i) { continue; }
                for (int k = 0; k < 2; k++)
                {
                   vv[k] = v[pri_t::Edges[ei][k]];
@@ -6258,8 +6923,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
          case Element::HEXAHEDRON:
          {
             const int *f = el_to_face->GetRow(i);
-            const int he = hex_counter;
-            hex_counter++;
+            const int he = hex_offset[i];
 
             const int *qf;
             int qf_data[6];
@@ -6277,6 +6941,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
 
             for (int fi = 0; fi < 6; fi++)
             {
+               if (face_owner[f[fi]] != i) { continue; }
                for (int k = 0; k < 4; k++)
                {
                   vv[k] = v[hex_t::FaceVert[fi][k]];
@@ -6286,6 +6951,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
 
             for (int ei = 0; ei < 12; ei++)
             {
+               if (edge_owner[el_e[ei]] != i) { continue; }
                for (int k = 0; k < 2; k++)
                {
                   vv[k] = v[hex_t::Edges[ei][k]];
@@ -6332,6 +6998,9 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
    }
 
    boundary.SetSize(4 * NumOfBdrElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < NumOfBdrElements; i++)
    {
       const Element::Type bdr_el_type = boundary[i]->GetType();
@@ -6435,6 +7104,9 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p)
    CoarseFineTr.point_matrices[Geometry::CUBE].
    UseExternalData(hex_children, 3, 8, 8);
 
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i = 0; i < elements.Size(); i++)
    {
       // Tetrahedron elements are handled above:
@@ -7012,6 +7684,7 @@ void Mesh::UniformRefinement(int ref_algo)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   MFEM_PROFILE_REGION("Mesh::GeneralRefinement");
    if (ncmesh)
    {
       nonconforming = 1;
@@ -245,6 +245,11 @@ protected:
 
    STable3D *GetFacesTable();
    STable3D *GetElementToFaceTable(int ret_ftbl = 0);
+#ifdef MFEM_USE_OPENMP
+   /** Sort-based construction of #el_to_face, #be_to_face and #NumOfFaces,
+       used by GetElementToFaceTable() when the faces table is not returned. */
+   void BuildElementToFaceTable();
+#endif
 
    /** Red refinement. Element with index i is refined. The default
        red refinement for now is Uniform. */
@@ -362,6 +367,10 @@ protected:
        T(i, 0) gives the index of edge in element i that connects vertex 0
        to vertex 1, etc. Returns the number of the edges. */
    int GetElementToEdgeTable(Table &, Array<int> &);
+#ifdef MFEM_USE_OPENMP
+   /// Sort-based version of GetElementToEdgeTable(), with threaded sorting.
+   int BuildElementToEdgeTable(Table &, Array<int> &);
+#endif
 
    /// Used in GenerateFaces()
    void AddPointFaceElement(int lf, int gf, int el);
@@ -437,6 +446,9 @@ protected:
    void GetElementData(const Array<Element*> &elem_array, int geom,
                        Array<int> &elem_vtx, Array<int> &attr) const;
 
+   // used in GetHilbertElementOrdering() and GetMortonElementOrdering()
+   void GetSFCElementOrdering(Array<int> &ordering, bool hilbert) const;
+
 public:
 
    Mesh() { SetEmpty(); }
@@ -559,6 +571,19 @@ public:
    void GetGeckoElementReordering(Array<int> &ordering);
 #endif
 
+   /** Compute an element ordering that follows a Hilbert space-filling curve
+       through the element centers, so that elements which are close in space
+       are also close in memory. The curve is built by recursive median splits
+       of the centers, so it adapts to graded meshes, and no external library
+       is needed. The result can be passed to ReorderElements(). */
+   void GetHilbertElementOrdering(Array<int> &ordering) const
+   { GetSFCElementOrdering(ordering, true); }
+
+   /** Similar to GetHilbertElementOrdering(), using a Morton (Z-order) curve,
+       which is cheaper to compute, but has jumps between its sub-domains. */
+   void GetMortonElementOrdering(Array<int> &ordering) const
+   { GetSFCElementOrdering(ordering, false); }
+
    /** Rebuilds the mesh with a different order of elements.  The ordering
        vector maps the old element number to the new element number.  This also
        reorders the vertices and nodes edges and faces along with the elements.  */
@@ -12,9 +12,18 @@
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
 #include "../general/text.hpp"
+#include "../general/sort_pairs.hpp"
 
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
@@ -27,6 +36,602 @@ namespace mfem
 
 bool Mesh::remove_unused_vertices = true;
 
+// The large sections of the mesh files (elements, vertices) are read into
+// memory in large blocks and parsed from there, in parallel when MFEM is built
+// with OpenMP. The text is split at line boundaries, assuming that each
+// element or vertex is on a line of its own, as written by Mesh::Print() and
+// Gmsh. Other layouts are still accepted, but they are read serially, token
+// by token.
+
+#ifdef MFEM_USE_OPENMP
+// Sections with fewer lines, and Gmsh binary blocks with fewer records, are
+// parsed serially.
+static const int read_omp_min_lines = 16384;
+#endif
+
+static inline bool IsBlank(char c)
+{
+   return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+static inline bool IsDigit(char c) { return (c >= '0' && c <= '9'); }
+
+// Skip the blanks, but not the end of the line.
+static inline void SkipBlanks(const char *&p)
+{
+   while (IsBlank(*p)) { p++; }
+}
+
+// Skip the white space, including the ends of lines.
+static inline void SkipSpace(const char *&p, const char *end)
+{
+   while (p < end && (IsBlank(*p) || *p == '\n')) { p++; }
+}
+
+// Move to the beginning of the next line.
+static inline void SkipLine(const char *&p, const char *end)
+{
+   while (p < end && *p != '\n') { p++; }
+   if (p < end) { p++; }
+}
+
+// A number must be followed by a blank, the end of the line or of the text.
+static inline bool IsDelimiter(char c)
+{
+   return (IsBlank(c) || c == '\n' || c == '\0');
+}
+
+// Parse an integer on the current line, advancing 'p' past it.
+static inline bool ParseInt(const char *&p, int &value)
+{
+   SkipBlanks(p);
+   const char *q = p;
+   const bool neg = (*q == '-');
+   if (*q == '-' || *q == '+') { q++; }
+   if (!IsDigit(*q)) { return false; }
+   int v = 0;
+   for ( ; IsDigit(*q); q++)
+   {
+      const int d = *q - '0';
+      if (v > (std::numeric_limits<int>::max() - d)/10) { return false; }
+      v = 10*v + d;
+   }
+   if (!IsDelimiter(*q)) { return false; }
+   value = neg ? -v : v;
+   p = q;
+   return true;
+}
+
+// Parse a double on the current line, advancing 'p' past it. Numbers with at
+// most 15 significant digits and a decimal exponent of at most 22 in absolute
+// value are converted with one exactly rounded multiplication or division of
+// two exact doubles, all others with strtod(), so the result is correctly
+// rounded and the same as with istream's operator>>.
+static inline bool ParseDouble(const char *&p, double &value)
+{
+   static const double pow10[23] =
+   {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+   };
+
+   SkipBlanks(p);
+   if (*p == '\n' || *p == '\0') { return false; }
+
+   const char *q = p;
+   const bool neg = (*q == '-');
+   if (*q == '-' || *q == '+') { q++; }
+   double m = 0.0;
+   int num_digits = 0, sig_digits = 0, exp10 = 0;
+   for ( ; IsDigit(*q); q++, num_digits++)
+   {
+      if (sig_digits || *q != '0') { sig_digits++; }
+      m = 10.0*m + (*q - '0');
+   }
+   if (*q == '.')
+   {
+      for (q++; IsDigit(*q); q++, num_digits++, exp10--)
+      {
+         if (sig_digits || *q != '0') { sig_digits++; }
+         m = 10.0*m + (*q - '0');
+      }
+   }
+   if (num_digits && (*q == 'e' || *q == 'E'))
+   {
+      q++;
+      const bool neg_exp = (*q == '-');
+      if (*q == '-' || *q == '+') { q++; }
+      int e = 0;
+      for (int i = 0; IsDigit(*q); q++, i++)
+      {
+         if (i < 4) { e = 10*e + (*q - '0'); }
+         else { num_digits = 0; } // too large, use strtod()
+      }
+      exp10 += neg_exp ? -e : e;
+   }
+   if (num_digits && sig_digits <= 15 && exp10 >= -22 && exp10 <= 22 &&
+       IsDelimiter(*q))
+   {
+      m = (exp10 < 0) ? m/pow10[-exp10] : m*pow10[exp10];
+      value = neg ? -m : m;
+      p = q;
+      return true;
+   }
+
+   char *end;
+   value = strtod(p, &end);
+   if (end == p || !IsDelimiter(*end)) { return false; }
+   p = end;
+   return true;
+}
+
+// Read the rest of the stream, in blocks of 1 MB, into 'text', followed by
+// a '\0'.
+static void ReadToEnd(std::istream &input, std::vector<char> &text)
+{
+   const size_t block_size = 1 << 20;
+   size_t size = 0;
+   text.clear();
+   while (input)
+   {
+      text.resize(size + block_size);
+      input.read(&text[size], block_size);
+      size += input.gcount();
+   }
+   text.resize(size);
+   text.push_back('\0');
+}
+
+// Read the next 'n' non-blank lines of the stream into 'text', followed by a
+// '\0'.
+static void ReadLines(std::istream &input, int n, std::vector<char> &text)
+{
+   string line;
+   text.clear();
+   for (int i = 0; i < n && getline(input, line); )
+   {
+      const char *p = line.c_str();
+      SkipBlanks(p);
+      if (*p != '\0') { i++; }
+      text.insert(text.end(), line.begin(), line.end());
+      text.push_back('\n');
+   }
+   text.push_back('\0');
+}
+
+// Count the non-blank lines of the text [begin, end).
+static int CountLines(const char *begin, const char *end)
+{
+   int count = 0;
+   bool blank = true;
+   for (const char *p = begin; p < end; p++)
+   {
+      if (*p == '\n')
+      {
+         count += !blank;
+         blank = true;
+      }
+      else if (blank && !IsBlank(*p))
+      {
+         blank = false;
+      }
+   }
+   return count + !blank;
+}
+
+/** Parse the text [begin, end), which should consist of 'n' non-blank lines,
+    calling parser(p, j) with 'p' at the first number of the line j. The parser
+    reads the data of the line, advancing 'p', and returns false if the data is
+    invalid. With OpenMP, the text is split at line boundaries into one chunk
+    per thread. Returns the index of the first line that could not be parsed
+    or has extra data, or -1 if all lines are valid. */
+template <typename LineParser>
+static int ParseLines(const char *begin, const char *end, int n,
+                      const LineParser &parser)
+{
+   int num_chunks = 1;
+#ifdef MFEM_USE_OPENMP
+   if (n >= read_omp_min_lines) { num_chunks = omp_get_max_threads(); }
+#endif
+
+   Array<const char*> chunk;
+   chunk.Append(begin);
+   for (int c = 1; c < num_chunks; c++)
+   {
+      const char *p = begin + (end - begin)*c/num_chunks;
+      if (p < chunk.Last()) { continue; }
+      SkipLine(p, end);
+      if (p > chunk.Last() && p < end) { chunk.Append(p); }
+   }
+   chunk.Append(end);
+   num_chunks = chunk.Size() - 1;
+
+   // The index of the first line of each chunk
+   Array<int> first_line(num_chunks + 1), bad_line(num_chunks);
+   first_line[0] = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      first_line[c+1] = CountLines(chunk[c], chunk[c+1]);
+   }
+   first_line.PartialSum();
+   if (first_line.Last() != n) { return std::min(first_line.Last(), n); }
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      bad_line[c] = -1;
+      const char *p = chunk[c];
+      for (int j = first_line[c]; j < first_line[c+1]; j++)
+      {
+         SkipSpace(p, chunk[c+1]);
+         if (!parser(p, j)) { bad_line[c] = j; break; }
+         SkipBlanks(p);
+         if (*p != '\n' && *p != '\0' && p < chunk[c+1])
+         {
+            bad_line[c] = j;
+            break;
+         }
+      }
+   }
+   for (int c = 0; c < num_chunks; c++)
+   {
+      if (bad_line[c] >= 0) { return bad_line[c]; }
+   }
+   return -1;
+}
+
+/** Parse the 'n' items of the text [begin, end) in order, calling parser(p, j)
+    as in ParseLines(), but ignoring the line breaks. This is the fallback for
+    the files that do not have one item per line. Returns the index of the
+    first item that could not be parsed, or -1 if all items are valid. */
+template <typename LineParser>
+static int ParseTokens(const char *begin, const char *end, int n,
+                       const LineParser &parser)
+{
+   // the parsers stop at the end of a line, so join all lines into one
+   std::vector<char> text(begin, end);
+   std::replace(text.begin(), text.end(), '\n', ' ');
+   text.push_back('\0');
+   const char *p = &text[0];
+   for (int j = 0; j < n; j++)
+   {
+      if (!parser(p, j)) { return j; }
+   }
+   return -1;
+}
+
+// Reads an element line of the MFEM mesh format: attribute, geometry and the
+// vertices, into a row of 'data'.
+struct MFEMElementLine
+{
+   static const int stride = 2 + 8; // the cube has the most vertices
+   int *data;
+
+   bool operator()(const char *&p, int j) const
+   {
+      int *row = data + j*stride;
+      if (!ParseInt(p, row[0]) || !ParseInt(p, row[1])) { return false; }
+      const int geom = row[1];
+      if (geom < 0 || geom >= Geometry::NumGeom)
+      {
+         // NewElement() reports the invalid geometry
+         while (*p != '\n' && *p != '\0') { p++; }
+         return true;
+      }
+      for (int i = 0; i < Geometry::NumVerts[geom]; i++)
+      {
+         if (!ParseInt(p, row[2+i])) { return false; }
+      }
+      return true;
+   }
+};
+
+// Reads a vertex line of the MFEM mesh format.
+struct MFEMVertexLine
+{
+   Vertex *vertices;
+   int space_dim;
+
+   bool operator()(const char *&p, int j) const
+   {
+      for (int i = 0; i < space_dim; i++)
+      {
+         if (!ParseDouble(p, vertices[j](i))) { return false; }
+      }
+      return true;
+   }
+};
+
+// Reads a node line of the Gmsh format: the vertex id and three coordinates.
+struct GmshNodeLine
+{
+   int *ids;
+   Vertex *vertices;
+
+   bool operator()(const char *&p, int j) const
+   {
+      return (ParseInt(p, ids[j]) && ParseDouble(p, vertices[j](0)) &&
+              ParseDouble(p, vertices[j](1)) && ParseDouble(p, vertices[j](2)));
+   }
+};
+
+// The map from the Gmsh vertex ids to the vertex indices: an array indexed by
+// the ids when they are not much sparser than the vertices, sorted (id, index)
+// pairs otherwise.
+class GmshVertexMap
+{
+   int min_id;
+   Array<int> index;
+   Array<Pair<int, int> > pairs;
+
+public:
+   /// Build the map, return false if the ids are not unique.
+   bool Init(const Array<int> &ids)
+   {
+      min_id = ids.Size() ? ids.Min() : 0;
+      const long range = ids.Size() ? (long) ids.Max() - min_id + 1 : 0;
+      index.SetSize(0);
+      pairs.SetSize(0);
+      if (range <= 4L*ids.Size() + 1024)
+      {
+         index.SetSize(range);
+         index = -1;
+         for (int i = 0; i < ids.Size(); i++)
+         {
+            int &idx = index[ids[i] - min_id];
+            if (idx >= 0) { return false; }
+            idx = i;
+         }
+      }
+      else
+      {
+         pairs.SetSize(ids.Size());
+         for (int i = 0; i < ids.Size(); i++)
+         {
+            pairs[i] = Pair<int, int>(ids[i], i);
+         }
+         SortPairs<int, int>(pairs, pairs.Size());
+         for (int i = 1; i < pairs.Size(); i++)
+         {
+            if (pairs[i].one == pairs[i-1].one) { return false; }
+         }
+      }
+      return true;
+   }
+
+   /// Return the index of the vertex with the given id, or -1.
+   int operator()(int id) const
+   {
+      if (pairs.Size() == 0)
+      {
+         const long i = (long) id - min_id;
+         return (i >= 0 && i < index.Size()) ? index[(int) i] : -1;
+      }
+      int lo = 0, hi = pairs.Size();
+      while (lo < hi)
+      {
+         const int mid = (lo + hi)/2;
+         if (pairs[mid].one < id) { lo = mid + 1; }
+         else { hi = mid; }
+      }
+      return (lo < pairs.Size() && pairs[lo].one == id) ? pairs[lo].two : -1;
+   }
+};
+
+// The number of nodes of the Gmsh element types, the type is the index of the
+// array + 1.
+static const int gmsh_num_nodes[] =
+{
+   2, // 2-node line.
+   3, // 3-node triangle.
+   4, // 4-node quadrangle.
+   4, // 4-node tetrahedron.
+   8, // 8-node hexahedron.
+   6, // 6-node prism.
+   5, // 5-node pyramid.
+   3, /* 3-node second order line (2 nodes associated with the vertices and 1
+         with the edge). */
+   6, /* 6-node second order triangle (3 nodes associated with the vertices and
+         3 with the edges). */
+   9, /* 9-node second order quadrangle (4 nodes associated with the vertices,
+         4 with the edges and 1 with the face). */
+   10,/* 10-node second order tetrahedron (4 nodes associated with the vertices
+         and 6 with the edges). */
+   27,/* 27-node second order hexahedron (8 nodes associated with the vertices,
+         12 with the edges, 6 with the faces and 1 with the volume). */
+   18,/* 18-node second order prism (6 nodes associated with the vertices, 9
+         with the edges and 3 with the quadrangular faces). */
+   14,/* 14-node second order pyramid (5 nodes associated with the vertices, 8
+         with the edges and 1 with the quadrangular face). */
+   1, // 1-node point.
+   8, /* 8-node second order quadrangle (4 nodes associated with the vertices
+         and 4 with the edges). */
+   20,/* 20-node second order hexahedron (8 nodes associated with the vertices
+         and 12 with the edges). */
+   15,/* 15-node second order prism (6 nodes associated with the vertices and 9
+         with the edges). */
+   13,/* 13-node second order pyramid (5 nodes associated with the vertices and
+         8 with the edges). */
+   9, /* 9-node third order incomplete triangle (3 nodes associated with the
+         vertices, 6 with the edges) */
+   10,/* 10-node third order triangle (3 nodes associated with the vertices, 6
+         with the edges, 1 with the face) */
+   12,/* 12-node fourth order incomplete triangle (3 nodes associated with the
+         vertices, 9 with the edges) */
+   15,/* 15-node fourth order triangle (3 nodes associated with the vertices, 9
+         with the edges, 3 with the face) */
+   15,/* 15-node fifth order incomplete triangle (3 nodes associated with the
+         vertices, 12 with the edges) */
+   21,/* 21-node fifth order complete triangle (3 nodes associated with the
+         vertices, 12 with the edges, 6 with the face) */
+   4, /* 4-node third order edge (2 nodes associated with the vertices, 2
+         internal to the edge) */
+   5, /* 5-node fourth order edge (2 nodes associated with the vertices, 3
+         internal to the edge) */
+   6, /* 6-node fifth order edge (2 nodes associated with the vertices, 4
+         internal to the edge) */
+   20 /* 20-node third order tetrahedron (4 nodes associated with the vertices,
+         12 with the edges, 4 with the faces) */
+};
+
+static const int gmsh_max_nodes = 27;
+
+// Return the number of nodes of a Gmsh element type, or 0 for an unknown type.
+static inline int GmshNumNodes(int type)
+{
+   const int num_types = sizeof(gmsh_num_nodes)/sizeof(gmsh_num_nodes[0]);
+   return (type >= 1 && type <= num_types) ? gmsh_num_nodes[type-1] : 0;
+}
+
+// The result of reading a Gmsh element.
+enum GmshElementStatus
+{
+   GMSH_ELEMENT_OK, GMSH_UNSUPPORTED_TYPE, GMSH_NO_VERTEX, GMSH_BAD_ATTRIBUTE
+};
+
+// Create the element of the given Gmsh type and physical domain (attribute),
+// with the given node ids; 'el' is NULL if the type is not supported.
+static GmshElementStatus NewGmshElement(int type, int phys_domain,
+                                        const int *node_ids,
+                                        const GmshVertexMap &vertices_map,
+                                        Element *&el)
+{
+   el = NULL;
+   const int num_nodes = GmshNumNodes(type);
+   if (num_nodes == 0) { return GMSH_UNSUPPORTED_TYPE; }
+
+   int v[gmsh_max_nodes];
+   for (int i = 0; i < num_nodes; i++)
+   {
+      v[i] = vertices_map(node_ids[i]);
+      if (v[i] < 0) { return GMSH_NO_VERTEX; }
+   }
+   // non-positive attributes are not allowed in MFEM
+   if (phys_domain <= 0) { return GMSH_BAD_ATTRIBUTE; }
+
+   switch (type)
+   {
+      case 1: el = new Segment(v, phys_domain); break; // 2-node line
+      case 2: el = new Triangle(v, phys_domain); break; // 3-node triangle
+      case 3: el = new Quadrilateral(v, phys_domain); break; // 4-node quadrangle
+      case 4: el = new Tetrahedron(v, phys_domain); break; // 4-node tetrahedron
+      case 5: el = new Hexahedron(v, phys_domain); break; // 8-node hexahedron
+      case 15: el = new Point(v, phys_domain); break; // 1-node point
+      default: return GMSH_UNSUPPORTED_TYPE; // any other element
+   }
+   return GMSH_ELEMENT_OK;
+}
+
+// Reads an element line of the Gmsh ASCII format: the serial number, the type,
+// the number of tags, the tags and the nodes. The first tag is the physical
+// domain, which becomes the attribute; the elementary domain and the
+// partitions in the other tags are skipped.
+struct GmshElementLine
+{
+   const GmshVertexMap *vertices_map;
+   Element **elements;
+   char *status;
+
+   bool operator()(const char *&p, int j) const
+   {
+      int serial_number, type, n_tags, tag, phys_domain = 1;
+      int node_ids[gmsh_max_nodes];
+      if (!ParseInt(p, serial_number) || !ParseInt(p, type) ||
+          !ParseInt(p, n_tags) || n_tags < 0)
+      {
+         return false;
+      }
+      for (int i = 0; i < n_tags; i++)
+      {
+         if (!ParseInt(p, tag)) { return false; }
+         if (i == 0) { phys_domain = tag; }
+      }
+      const int num_nodes = GmshNumNodes(type);
+      if (num_nodes == 0)
+      {
+         // unknown type, skip the nodes
+         while (*p != '\n' && *p != '\0') { p++; }
+      }
+      for (int i = 0; i < num_nodes; i++)
+      {
+         if (!ParseInt(p, node_ids[i])) { return false; }
+      }
+      status[j] = NewGmshElement(type, phys_domain, node_ids, *vertices_map,
+                                 elements[j]);
+      return true;
+   }
+};
+
+// Read an int or a double from possibly unaligned binary data.
+template <typename T>
+static inline T ReadBinary(const char *p)
+{
+   T value;
+   memcpy(&value, p, sizeof(T));
+   return value;
+}
+
+/* Read the 'n' elements of a section of an MFEM mesh file, one per line.
+   Returns false, with the stream rewound to the start of the section, if the
+   stream is not seekable or the lines do not have one element each; the
+   section is then read with Mesh::ReadElement(). */
+static bool ReadMFEMElements(std::istream &input, int n, Mesh &mesh,
+                             Array<Element*> &elems)
+{
+   elems.SetSize(n);
+   const std::streampos start = input.tellg();
+   if (start == std::streampos(-1)) { return false; }
+
+   std::vector<char> text;
+   ReadLines(input, n, text);
+
+   Array<int> data(n*MFEMElementLine::stride);
+   MFEMElementLine parser = { data.GetData() };
+   if (ParseLines(&text[0], &text[0] + text.size() - 1, n, parser) >= 0)
+   {
+      input.clear();
+      input.seekg(start);
+      return false;
+   }
+
+   for (int j = 0; j < n; j++)
+   {
+      const int *row = data.GetData() + j*MFEMElementLine::stride;
+      Element *el = mesh.NewElement(row[1]);
+      MFEM_VERIFY(el, "Unsupported element type: " << row[1]);
+      el->SetVertices(row + 2);
+      el->SetAttribute(row[0]);
+      elems[j] = el;
+   }
+   return true;
+}
+
+// Read the vertices of an MFEM mesh file, one per line, see ReadMFEMElements().
+static bool ReadMFEMVertices(std::istream &input, int space_dim,
+                             Array<Vertex> &vertices)
+{
+   const std::streampos start = input.tellg();
+   if (start == std::streampos(-1)) { return false; }
+
+   std::vector<char> text;
+   ReadLines(input, vertices.Size(), text);
+   MFEMVertexLine parser = { vertices.GetData(), space_dim };
+   if (ParseLines(&text[0], &text[0] + text.size() - 1, vertices.Size(),
+                  parser) >= 0)
+   {
+      input.clear();
+      input.seekg(start);
+      return false;
+   }
+   return true;
+}
+
+
 void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
 {
    // Read MFEM mesh v1.0 format
@@ -44,10 +649,12 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
 
    MFEM_VERIFY(ident == "elements", "invalid mesh file");
    input >> NumOfElements;
-   elements.SetSize(NumOfElements);
-   for (int j = 0; j < NumOfElements; j++)
+   if (!ReadMFEMElements(input, NumOfElements, *this, elements))
    {
-      elements[j] = ReadElement(input);
+      for (int j = 0; j < NumOfElements; j++)
+      {
+         elements[j] = ReadElement(input);
+      }
    }
 
    skip_comment_lines(input, '#');
@@ -55,10 +662,12 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
 
    MFEM_VERIFY(ident == "boundary", "invalid mesh file");
    input >> NumOfBdrElements;
-   boundary.SetSize(NumOfBdrElements);
-   for (int j = 0; j < NumOfBdrElements; j++)
+   if (!ReadMFEMElements(input, NumOfBdrElements, *this, boundary))
    {
-      boundary[j] = ReadElement(input);
+      for (int j = 0; j < NumOfBdrElements; j++)
+      {
+         boundary[j] = ReadElement(input);
+      }
    }
 
    skip_comment_lines(input, '#');
@@ -90,11 +699,14 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    {
       // read the vertices
       spaceDim = atoi(ident.c_str());
-      for (int j = 0; j < NumOfVertices; j++)
+      if (!ReadMFEMVertices(input, spaceDim, vertices))
       {
-         for (int i = 0; i < spaceDim; i++)
+         for (int j = 0; j < NumOfVertices; j++)
          {
-            input >> vertices[j](i);
+            for (int i = 0; i < spaceDim; i++)
+            {
+               input >> vertices[j](i);
+            }
          }
       }
 
@@ -912,41 +1524,74 @@ void Mesh::ReadGmshMesh(std::istream &input)
       }
    }
 
+   // Read the rest of the file into memory, the sections are parsed from there
+   std::vector<char> text;
+   ReadToEnd(input, text);
+   const char *p = &text[0], *end = &text[0] + text.size() - 1;
+
    // A map between a serial number of the vertex and its number in the file
    // (there may be gaps in the numbering, and also Gmsh enumerates vertices
    // starting from 1, not 0)
-   map<int, int> vertices_map;
-   // Read the lines of the mesh file. If we face specific keyword, we'll treat
+   GmshVertexMap vertices_map;
+   // Read the words of the mesh file. If we face specific keyword, we'll treat
    // the section.
-   while (input >> buff)
+   for (SkipSpace(p, end); p < end; SkipSpace(p, end))
    {
+      const char *word = p;
+      while (p < end && !IsDelimiter(*p)) { p++; }
+      if (p == word) { p++; continue; } // a '\0' between the sections
+      buff.assign(word, p);
+
       if (buff == "$Nodes") // reading mesh vertices
       {
-         input >> NumOfVertices;
-         getline(input, buff);
+         SkipSpace(p, end);
+         if (!ParseInt(p, NumOfVertices) || NumOfVertices < 0)
+         {
+            MFEM_ABORT("Gmsh file : invalid number of vertices");
+         }
+         SkipLine(p, end);
          vertices.SetSize(NumOfVertices);
-         int serial_number;
-         const int gmsh_dim = 3; // Gmsh always outputs 3 coordinates
-         double coord[gmsh_dim];
-         for (int ver = 0; ver < NumOfVertices; ++ver)
+         Array<int> serial_numbers(NumOfVertices);
+         if (binary)
          {
-            if (binary)
+            // the serial number and 3 coordinates (Gmsh always outputs 3)
+            const int gmsh_dim = 3;
+            const size_t node_size = sizeof(int) + gmsh_dim*sizeof(double);
+            if ((size_t) (end - p) < NumOfVertices*node_size)
             {
-               input.read(reinterpret_cast<char*>(&serial_number), sizeof(int));
-               input.read(reinterpret_cast<char*>(coord), gmsh_dim*sizeof(double));
+               MFEM_ABORT("Gmsh file : unexpected end of file");
             }
-            else // ASCII
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel for schedule(static) \
+            if (NumOfVertices >= read_omp_min_lines)
+#endif
+            for (int ver = 0; ver < NumOfVertices; ++ver)
             {
-               input >> serial_number;
+               const char *node = p + ver*node_size;
+               serial_numbers[ver] = ReadBinary<int>(node);
                for (int ci = 0; ci < gmsh_dim; ++ci)
                {
-                  input >> coord[ci];
+                  vertices[ver](ci) =
+                     ReadBinary<double>(node + sizeof(int) + ci*sizeof(double));
                }
             }
-            vertices[ver] = Vertex(coord, gmsh_dim);
-            vertices_map[serial_number] = ver;
+            p += NumOfVertices*node_size;
+         }
+         else // ASCII
+         {
+            const char *section_end = strstr(p, "$EndNodes");
+            if (!section_end) { section_end = end; }
+            GmshNodeLine parser = { serial_numbers.GetData(),
+                                    vertices.GetData()
+                                  };
+            if (ParseLines(p, section_end, NumOfVertices, parser) >= 0 &&
+                ParseTokens(p, section_end, NumOfVertices, parser) >= 0)
+            {
+               MFEM_ABORT("Gmsh file : invalid $Nodes section");
+            }
+            p = section_end;
          }
-         if (static_cast<int>(vertices_map.size()) != NumOfVertices)
+         if (!vertices_map.Init(serial_numbers))
          {
             MFEM_ABORT("Gmsh file : vertices indices are not unique");
          }
@@ -954,269 +1599,160 @@ void Mesh::ReadGmshMesh(std::istream &input)
       else if (buff == "$Elements") // reading mesh elements
       {
          int num_of_all_elements;
-         input >> num_of_all_elements;
-         // = NumOfElements + NumOfBdrElements + (maybe, PhysicalPoints)
-         getline(input, buff);
-
-         int serial_number; // serial number of an element
-         int type_of_element; // ID describing a type of a mesh element
-         int n_tags; // number of different tags describing an element
-         int phys_domain; // element's attribute
-         int elem_domain; // another element's attribute (rarely used)
-         int n_partitions; // number of partitions where an element takes place
-
-         // number of nodes for each type of Gmsh elements, type is the index of
-         // the array + 1
-         int nodes_of_gmsh_element[] =
+         SkipSpace(p, end);
+         if (!ParseInt(p, num_of_all_elements) || num_of_all_elements < 0)
          {
-            2, // 2-node line.
-            3, // 3-node triangle.
-            4, // 4-node quadrangle.
-            4, // 4-node tetrahedron.
-            8, // 8-node hexahedron.
-            6, // 6-node prism.
-            5, // 5-node pyramid.
-            3, /* 3-node second order line (2 nodes associated with the vertices
-                    and 1 with the edge). */
-            6, /* 6-node second order triangle (3 nodes associated with the
-                    vertices and 3 with the edges). */
-            9, /* 9-node second order quadrangle (4 nodes associated with the
-                    vertices, 4 with the edges and 1 with the face). */
-            10,/* 10-node second order tetrahedron (4 nodes associated with the
-                     vertices and 6 with the edges). */
-            27,/* 27-node second order hexahedron (8 nodes associated with the
-                     vertices, 12 with the edges, 6 with the faces and 1 with
-                     the volume). */
-            18,/* 18-node second order prism (6 nodes associated with the
-                     vertices, 9 with the edges and 3 with the quadrangular
-                     faces). */
-            14,/* 14-node second order pyramid (5 nodes associated with the
-                     vertices, 8 with the edges and 1 with the quadrangular
-                     face). */
-            1, // 1-node point.
-            8, /* 8-node second order quadrangle (4 nodes associated with the
-                    vertices and 4 with the edges). */
-            20,/* 20-node second order hexahedron (8 nodes associated with the
-                     vertices and 12 with the edges). */
-            15,/* 15-node second order prism (6 nodes associated with the
-                     vertices and 9 with the edges). */
-            13,/* 13-node second order pyramid (5 nodes associated with the
-                     vertices and 8 with the edges). */
-            9, /* 9-node third order incomplete triangle (3 nodes associated
-                    with the vertices, 6 with the edges) */
-            10,/* 10-node third order triangle (3 nodes associated with the
-                     vertices, 6 with the edges, 1 with the face) */
-            12,/* 12-node fourth order incomplete triangle (3 nodes associated
-                     with the vertices, 9 with the edges) */
-            15,/* 15-node fourth order triangle (3 nodes associated with the
-                     vertices, 9 with the edges, 3 with the face) */
-            15,/* 15-node fifth order incomplete triangle (3 nodes associated
-                     with the vertices, 12 with the edges) */
-            21,/* 21-node fifth order complete triangle (3 nodes associated with
-                     the vertices, 12 with the edges, 6 with the face) */
-            4, /* 4-node third order edge (2 nodes associated with the vertices,
-                    2 internal to the edge) */
-            5, /* 5-node fourth order edge (2 nodes associated with the
-                    vertices, 3 internal to the edge) */
-            6, /* 6-node fifth order edge (2 nodes associated with the vertices,
-                    4 internal to the edge) */
-            20 /* 20-node third order tetrahedron (4 nodes associated with the
-                     vertices, 12 with the edges, 4 with the faces) */
-         };
+            MFEM_ABORT("Gmsh file : invalid number of elements");
+         }
+         // = NumOfElements + NumOfBdrElements + (maybe, PhysicalPoints)
+         SkipLine(p, end);
 
-         vector<Element*> elements_0D, elements_1D, elements_2D, elements_3D;
-         elements_0D.reserve(num_of_all_elements);
-         elements_1D.reserve(num_of_all_elements);
-         elements_2D.reserve(num_of_all_elements);
-         elements_3D.reserve(num_of_all_elements);
+         // All elements in the order of the file, NULL for the unsupported
+         // ones, and the result of reading each of them
+         Array<Element*> all_elements(num_of_all_elements);
+         Array<char> status(num_of_all_elements);
 
          if (binary)
          {
-            int n_elem_part = 0; // partial sum of elements that are read
+            // The elements are in blocks with a header of 3 numbers: type of
+            // the elements, number of elements of this type, and number of
+            // tags. Each element has a serial number, the tags and the nodes.
             const int header_size = 3;
-            // header consists of 3 numbers: type of the element, number of
-            // elements of this type, and number of tags
-            int header[header_size];
-            int n_elem_one_type; // number of elements of a specific type
-
-            while (n_elem_part < num_of_all_elements)
+            Array<int> block_type, block_tags, block_first(1);
+            Array<const char*> block_data;
+            block_first[0] = 0; // partial sum of elements in the blocks
+            while (block_first.Last() < num_of_all_elements)
             {
-               input.read(reinterpret_cast<char*>(header),
-                          header_size*sizeof(int));
-               type_of_element = header[0];
-               n_elem_one_type = header[1];
-               n_tags          = header[2];
+               if ((size_t) (end - p) < header_size*sizeof(int))
+               {
+                  MFEM_ABORT("Gmsh file : unexpected end of file");
+               }
+               const int type_of_element = ReadBinary<int>(p);
+               const int n_elem_one_type = ReadBinary<int>(p + sizeof(int));
+               const int n_tags = ReadBinary<int>(p + 2*sizeof(int));
+               p += header_size*sizeof(int);
 
-               n_elem_part += n_elem_one_type;
+               const int n_elem_nodes = GmshNumNodes(type_of_element);
+               if (n_elem_nodes == 0)
+               {
+                  MFEM_ABORT("Gmsh file : unknown element type "
+                             << type_of_element);
+               }
+               if (n_elem_one_type < 0 || n_tags < 0 || n_elem_one_type >
+                   num_of_all_elements - block_first.Last())
+               {
+                  MFEM_ABORT("Gmsh file : invalid $Elements section");
+               }
+               const size_t elem_size = (1 + n_tags + n_elem_nodes)*sizeof(int);
+               if ((size_t) (end - p) < n_elem_one_type*elem_size)
+               {
+                  MFEM_ABORT("Gmsh file : unexpected end of file");
+               }
+               block_type.Append(type_of_element);
+               block_tags.Append(n_tags);
+               block_data.Append(p);
+               block_first.Append(block_first.Last() + n_elem_one_type);
+               p += n_elem_one_type*elem_size;
+            }
 
-               const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> data(1+n_tags+n_elem_nodes);
-               for (int el = 0; el < n_elem_one_type; ++el)
+            // Create the elements, each thread a contiguous range of them
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel if (num_of_all_elements >= read_omp_min_lines)
+#endif
+            {
+               int el_begin = 0, el_end = num_of_all_elements;
+#ifdef MFEM_USE_OPENMP
+               const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+               el_begin = (int) ((long) num_of_all_elements*t/nt);
+               el_end = (int) ((long) num_of_all_elements*(t+1)/nt);
+#endif
+               int b = std::upper_bound(block_first.GetData(),
+                                        block_first.GetData() +
+                                        block_first.Size(), el_begin)
+                       - block_first.GetData() - 1;
+               for (int el = el_begin; el < el_end; ++el)
                {
-                  input.read(reinterpret_cast<char*>(&data[0]),
-                             data.size()*sizeof(int));
-                  int dd = 0; // index for data array
-                  serial_number = data[dd++];
+                  while (el >= block_first[b+1]) { b++; }
+                  const int type_of_element = block_type[b];
+                  const int n_tags = block_tags[b];
+                  const int n_elem_nodes = GmshNumNodes(type_of_element);
+                  const char *data = block_data[b] + (el - block_first[b])*
+                                     (1 + n_tags + n_elem_nodes)*sizeof(int);
                   // physical domain - the most important value (to distinguish
-                  // materials with different properties)
-                  phys_domain = (n_tags > 0) ? data[dd++] : 1;
-                  // elementary domain - to distinguish different geometrical
-                  // domains (typically, it's used rarely)
-                  elem_domain = (n_tags > 1) ? data[dd++] : 0;
-                  // the number of tags is bigger than 2 if there are some
-                  // partitions (domain decompositions)
-                  n_partitions = (n_tags > 2) ? data[dd++] : 0;
-                  // we currently just skip the partitions if they exist, and go
-                  // directly to vertices describing the mesh element
-                  vector<int> vert_indices(n_elem_nodes);
+                  // materials with different properties); the elementary
+                  // domain and the partitions in the other tags are skipped
+                  const int phys_domain =
+                     (n_tags > 0) ? ReadBinary<int>(data + sizeof(int)) : 1;
+                  int node_ids[gmsh_max_nodes];
                   for (int vi = 0; vi < n_elem_nodes; ++vi)
                   {
-                     map<int, int>::const_iterator it =
-                        vertices_map.find(data[1+n_tags+vi]);
-                     if (it == vertices_map.end())
-                     {
-                        MFEM_ABORT("Gmsh file : vertex index doesn't exist");
-                     }
-                     vert_indices[vi] = it->second;
-                  }
-
-                  // non-positive attributes are not allowed in MFEM
-                  if (phys_domain <= 0)
-                  {
-                     MFEM_ABORT("Non-positive element attribute in Gmsh mesh!");
+                     node_ids[vi] =
+                        ReadBinary<int>(data + (1 + n_tags + vi)*sizeof(int));
                   }
-
-                  // initialize the mesh element
-                  switch (type_of_element)
-                  {
-                     case 1: // 2-node line
-                     {
-                        elements_1D.push_back(
-                           new Segment(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 2: // 3-node triangle
-                     {
-                        elements_2D.push_back(
-                           new Triangle(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 3: // 4-node quadrangle
-                     {
-                        elements_2D.push_back(
-                           new Quadrilateral(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 4: // 4-node tetrahedron
-                     {
-                        elements_3D.push_back(
-                           new Tetrahedron(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 5: // 8-node hexahedron
-                     {
-                        elements_3D.push_back(
-                           new Hexahedron(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 15: // 1-node point
-                     {
-                        elements_0D.push_back(
-                           new Point(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     default: // any other element
-                        MFEM_WARNING("Unsupported Gmsh element type.");
-                        break;
-
-                  } // switch (type_of_element)
-               } // el (elements of one type)
-            } // all elements
+                  status[el] = NewGmshElement(type_of_element, phys_domain,
+                                              node_ids, vertices_map,
+                                              all_elements[el]);
+               }
+            }
          } // if binary
          else // ASCII
          {
-            for (int el = 0; el < num_of_all_elements; ++el)
+            const char *section_end = strstr(p, "$EndElements");
+            if (!section_end) { section_end = end; }
+            GmshElementLine parser = { &vertices_map, all_elements.GetData(),
+                                       status.GetData()
+                                     };
+            all_elements = NULL;
+            if (ParseLines(p, section_end, num_of_all_elements, parser) >= 0)
             {
-               input >> serial_number >> type_of_element >> n_tags;
-               vector<int> data(n_tags);
-               for (int i = 0; i < n_tags; ++i) { input >> data[i]; }
-               // physical domain - the most important value (to distinguish
-               // materials with different properties)
-               phys_domain = (n_tags > 0) ? data[0] : 1;
-               // elementary domain - to distinguish different geometrical
-               // domains (typically, it's used rarely)
-               elem_domain = (n_tags > 1) ? data[1] : 0;
-               // the number of tags is bigger than 2 if there are some
-               // partitions (domain decompositions)
-               n_partitions = (n_tags > 2) ? data[2] : 0;
-               // we currently just skip the partitions if they exist, and go
-               // directly to vertices describing the mesh element
-               const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> vert_indices(n_elem_nodes);
-               int index;
-               for (int vi = 0; vi < n_elem_nodes; ++vi)
+               // not one element per line, start over reading the tokens
+               for (int el = 0; el < num_of_all_elements; ++el)
                {
-                  input >> index;
-                  map<int, int>::const_iterator it = vertices_map.find(index);
-                  if (it == vertices_map.end())
-                  {
-                     MFEM_ABORT("Gmsh file : vertex index doesn't exist");
-                  }
-                  vert_indices[vi] = it->second;
+                  delete all_elements[el];
                }
-
-               // non-positive attributes are not allowed in MFEM
-               if (phys_domain <= 0)
+               all_elements = NULL;
+               if (ParseTokens(p, section_end, num_of_all_elements,
+                               parser) >= 0)
                {
-                  MFEM_ABORT("Non-positive element attribute in Gmsh mesh!");
+                  MFEM_ABORT("Gmsh file : invalid $Elements section");
                }
+            }
+            p = section_end;
+         } // if ASCII
 
-               // initialize the mesh element
-               switch (type_of_element)
+         // Sort the elements by dimension, keeping the order of the file
+         vector<Element*> elements_0D, elements_1D, elements_2D, elements_3D;
+         vector<Element*> *elements_dim[4] =
+         { &elements_0D, &elements_1D, &elements_2D, &elements_3D };
+         int num_unsupported = 0;
+         for (int el = 0; el < num_of_all_elements; ++el)
+         {
+            if (status[el] == GMSH_NO_VERTEX || status[el] == GMSH_BAD_ATTRIBUTE)
+            {
+               for (int i = 0; i < num_of_all_elements; ++i)
                {
-                  case 1: // 2-node line
-                  {
-                     elements_1D.push_back(
-                        new Segment(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 2: // 3-node triangle
-                  {
-                     elements_2D.push_back(
-                        new Triangle(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 3: // 4-node quadrangle
-                  {
-                     elements_2D.push_back(
-                        new Quadrilateral(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 4: // 4-node tetrahedron
-                  {
-                     elements_3D.push_back(
-                        new Tetrahedron(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 5: // 8-node hexahedron
-                  {
-                     elements_3D.push_back(
-                        new Hexahedron(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 15: // 1-node point
-                  {
-                     elements_0D.push_back(
-                        new Point(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  default: // any other element
-                     MFEM_WARNING("Unsupported Gmsh element type.");
-                     break;
-
-               } // switch (type_of_element)
-            } // el (all elements)
-         } // if ASCII
+                  delete all_elements[i];
+               }
+               if (status[el] == GMSH_NO_VERTEX)
+               {
+                  MFEM_ABORT("Gmsh file : vertex index doesn't exist");
+               }
+               MFEM_ABORT("Non-positive element attribute in Gmsh mesh!");
+            }
+            Element *elem = all_elements[el];
+            if (!elem)
+            {
+               num_unsupported++;
+               continue;
+            }
+            elements_dim[Geometry::Dimension[elem->GetGeometryType()]]
+            ->push_back(elem);
+         }
+         if (num_unsupported)
+         {
+            MFEM_WARNING("Unsupported Gmsh element type: skipped "
+                         << num_unsupported << " elements.");
+         }
 
          if (!elements_3D.empty())
          {
@@ -1285,10 +1821,6 @@ void Mesh::ReadGmshMesh(std::istream &input)
             MFEM_ABORT("Gmsh file : no elements found");
             return;
          }
-
-         MFEM_CONTRACT_VAR(n_partitions);
-         MFEM_CONTRACT_VAR(elem_domain);
-
       } // section '$Elements'
    } // we reach the end of the file
 }
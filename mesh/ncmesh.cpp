@@ -1086,6 +1086,12 @@ void NCMesh::RefineElement(int elem, char ref_type)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   // make room for the new nodes and faces of the whole batch at once (a
+   // lower estimate, forced refinements and hanging nodes can add more)
+   int nchild = 1 << Dim;
+   nodes.Reserve(nodes.Size() + (nchild-1)*refinements.Size());
+   faces.Reserve(faces.Size() + Dim*(nchild-1)*refinements.Size());
+
    // push all refinements on the stack in reverse order
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
@@ -1780,12 +1786,13 @@ void NCMesh::TraverseFace(int vn0, int vn1, int vn2, int vn3,
          // we have a slave face, add it to the list
          int elem = fa->GetSingleElement();
          face_list.slaves.push_back(Slave(fa->index, elem, -1));
-         DenseMatrix &mat = face_list.slaves.back().point_matrix;
+         DenseMatrix mat;
          pm.GetMatrix(mat);
 
          // reorder the point matrix according to slave face orientation
          int local = ReorderFacePointMat(vn0, vn1, vn2, vn3, elem, mat);
          face_list.slaves.back().local = local;
+         face_list.slaves.back().matrix = face_list.AddPointMatrix(mat);
 
          return;
       }
@@ -1901,9 +1908,10 @@ void NCMesh::TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
       edge_list.slaves.push_back(Slave(nd.edge_index, -1, -1));
       Slave &sl = edge_list.slaves.back();
 
-      sl.point_matrix.SetSize(1, 2);
-      sl.point_matrix(0,0) = t0;
-      sl.point_matrix(0,1) = t1;
+      DenseMatrix mat(1, 2);
+      mat(0,0) = t0;
+      mat(0,1) = t1;
+      sl.matrix = edge_list.AddPointMatrix(mat);
 
       // handle slave edge orientation
       sl.edge_flags = flags;
@@ -2062,21 +2070,22 @@ void NCMesh::BuildVertexList()
    }
 }
 
-void NCMesh::Slave::OrientedPointMatrix(DenseMatrix &oriented_matrix) const
+void NCMesh::NCList::OrientedPointMatrix(const Slave &slave,
+                                         DenseMatrix &oriented_matrix) const
 {
-   oriented_matrix = point_matrix;
+   oriented_matrix = *point_matrices[slave.matrix];
 
-   if (edge_flags)
+   if (slave.edge_flags)
    {
       MFEM_ASSERT(oriented_matrix.Height() == 1 &&
                   oriented_matrix.Width() == 2, "not an edge point matrix");
 
-      if (edge_flags & 1) // master inverted
+      if (slave.edge_flags & 1) // master inverted
       {
          oriented_matrix(0,0) = 1.0 - oriented_matrix(0,0);
          oriented_matrix(0,1) = 1.0 - oriented_matrix(0,1);
       }
-      if (edge_flags & 2) // slave inverted
+      if (slave.edge_flags & 2) // slave inverted
       {
          std::swap(oriented_matrix(0,0), oriented_matrix(0,1));
       }
@@ -2098,9 +2107,31 @@ void NCMesh::NCList::Clear(bool hard)
       masters.swap(empty.masters);
       slaves.swap(empty.slaves);
    }
+   for (int i = 0; i < point_matrices.Size(); i++)
+   {
+      delete point_matrices[i];
+   }
+   point_matrices.DeleteAll();
+   pm_index.clear();
    inv_index.DeleteAll();
 }
 
+int NCMesh::NCList::AddPointMatrix(const DenseMatrix &pm)
+{
+   // the matrices come from exact bisections of the master, so identical
+   // positions have bit-wise identical entries
+   std::vector<double> key(pm.Data(), pm.Data() + pm.Height()*pm.Width());
+   key.push_back(pm.Height());
+
+   std::map<std::vector<double>, int>::iterator it = pm_index.find(key);
+   if (it != pm_index.end()) { return it->second; }
+
+   int index = point_matrices.Size();
+   point_matrices.Append(new DenseMatrix(pm));
+   pm_index[key] = index;
+   return index;
+}
+
 long NCMesh::NCList::TotalSize() const
 {
    return conforming.size() + masters.size() + slaves.size();
@@ -2914,7 +2945,7 @@ const CoarseFineTransformations& NCMesh::GetRefinementTransforms()
       }
 
       MFEM_ASSERT(elements.Size() > free_element_ids.Size(), "");
-      Geometry::Type geom = elements[0].geom;
+      Geometry::Type geom = elements[0].Geom();
       const PointMatrix &identity = GetGeomIdentity(geom);
 
       transforms.point_matrices[geom].SetSize(Dim, identity.np, map.size());
@@ -2934,7 +2965,7 @@ const CoarseFineTransformations& NCMesh::GetDerefinementTransforms()
    MFEM_VERIFY(transforms.embeddings.Size() || !leaf_elements.Size(),
                "GetDerefinementTransforms() must be preceded by Derefine().");
 
-   Geometry::Type geom = elements[0].geom;
+   Geometry::Type geom = elements[0].Geom();
 
    if (!transforms.point_matrices[geom].SizeK())
    {
@@ -3550,16 +3581,17 @@ void NCMesh::Trim()
 
 long NCMesh::NCList::MemoryUsage() const
 {
-   int pmsize = 0;
-   if (slaves.size())
+   long pmsize = point_matrices.MemoryUsage();
+   for (int i = 0; i < point_matrices.Size(); i++)
    {
-      pmsize = slaves[0].point_matrix.MemoryUsage();
+      // the matrix and (approximately) its copy in 'pm_index'
+      pmsize += sizeof(DenseMatrix) + 2*point_matrices[i]->MemoryUsage();
    }
 
    return conforming.capacity() * sizeof(MeshId) +
           masters.capacity() * sizeof(Master) +
           slaves.capacity() * sizeof(Slave) +
-          slaves.size() * pmsize;
+          pmsize;
 }
 
 long CoarseFineTransformations::MemoryUsage() const
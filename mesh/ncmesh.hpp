@@ -161,14 +161,12 @@ public:
    struct Slave : public MeshId
    {
       int master; ///< master number (in Mesh numbering)
+      int matrix; ///< index of the position matrix in NCList::point_matrices
       int edge_flags; ///< edge orientation flags
-      DenseMatrix point_matrix; ///< position within the master edge/face
 
       Slave(int index, int element, int local)
-         : MeshId(index, element, local), master(-1), edge_flags(0) {}
-
-      /// Return the point matrix oriented according to the master and slave edges
-      void OrientedPointMatrix(DenseMatrix &oriented_matrix) const;
+         : MeshId(index, element, local), master(-1), matrix(-1),
+           edge_flags(0) {}
    };
 
    /// Lists all edges/faces in the nonconforming mesh.
@@ -178,7 +176,12 @@ public:
       std::vector<Master> masters;
       std::vector<Slave> slaves;
       // TODO: switch to Arrays when fixed for non-POD types
-      // TODO: make a list of unique slave matrices to save memory (+ time later)
+
+      /** Unique positions of the slaves within their masters, shared by all
+          slaves with the same Slave::matrix. */
+      Array<DenseMatrix*> point_matrices;
+
+      ~NCList() { Clear(); }
 
       void Clear(bool hard = false);
       bool Empty() const { return !conforming.size() && !masters.size(); }
@@ -186,8 +189,18 @@ public:
       long MemoryUsage() const;
 
       const MeshId& LookUp(int index, int *type = NULL) const;
+
+      /** Return the index of 'pm' in 'point_matrices', adding a copy of it if
+          an identical matrix is not stored yet. */
+      int AddPointMatrix(const DenseMatrix &pm);
+
+      /** Return the point matrix of the slave oriented according to the master
+          and slave edges. */
+      void OrientedPointMatrix(const Slave &slave,
+                               DenseMatrix &oriented_matrix) const;
    private:
       mutable Array<int> inv_index;
+      std::map<std::vector<double>, int> pm_index;
    };
 
    /// Return the current list of conforming and nonconforming faces.
@@ -277,7 +290,7 @@ public:
                                    Array<int> &bdr_edges);
 
    /// Return the type of elements in the mesh.
-   Geometry::Type GetElementGeometry() const { return elements[0].geom; }
+   Geometry::Type GetElementGeometry() const { return elements[0].Geom(); }
 
    Geometry::Type GetFaceGeometry() const { return Geometry::SQUARE; }
 
@@ -382,7 +395,7 @@ protected: // implementation
        to its vertex nodes. */
    struct Element
    {
-      Geometry::Type geom; ///< Geometry::Type of the element
+      char geom;     ///< Geometry::Type of the element (char for storage only)
       char ref_type; ///< bit mask of X,Y,Z refinements (bits 0,1,2 respectively)
       char flag;     ///< generic flag/marker, can be used by algorithms
       int index;     ///< element number in the Mesh, -1 if refined
@@ -396,6 +409,8 @@ protected: // implementation
       int parent; ///< parent element, -1 if this is a root element, -2 if free
 
       Element(Geometry::Type geom, int attr);
+
+      Geometry::Type Geom() const { return Geometry::Type(geom); }
    };
 
    // primary data
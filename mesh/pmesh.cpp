@@ -894,6 +894,16 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    have_face_nbr_data = false;
    pncmesh = NULL;
 
+   const bool fix_orientation = false;
+   ParLoader(input, refine, fix_orientation);
+
+   // note: attributes and bdr_attributes are local lists
+
+   // TODO: AMR meshes, NURBS meshes?
+}
+
+void ParMesh::ParLoader(istream &input, bool refine, bool fix_orientation)
+{
    string ident;
 
    // read the serial part of the mesh
@@ -1047,14 +1057,9 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
       }
    }
 
-   const bool fix_orientation = false;
    Finalize(refine, fix_orientation);
 
    // If the mesh has Nodes, convert them from GridFunction to ParGridFunction?
-
-   // note: attributes and bdr_attributes are local lists
-
-   // TODO: AMR meshes, NURBS meshes?
 }
 
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
@@ -87,6 +87,9 @@ protected:
    // Determine sedge_ledge and sface_lface.
    void FinalizeParTopo();
 
+   // Read the local part of a parallel mesh in the format of ParPrint().
+   void ParLoader(std::istream &input, bool refine, bool fix_orientation);
+
    // Mark all tets to ensure consistency across MPI tasks; also mark the
    // shared and boundary triangle faces using the consistently marked tets.
    virtual void MarkTetMeshForRefinement(DSTable &v_to_v);
@@ -205,6 +208,20 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Read a serial mesh file in parallel, each MPI rank reading only a
+       share of the file, and distribute it without forming the serial mesh. */
+   /** The file is split into equal byte ranges, one per rank. The elements
+       are sent to their ranks according to the partitioning read from
+       @a partition_file (in the format written by the mesh-explorer miniapp:
+       the number of elements and processors followed by the rank of each
+       element) or, if it is NULL, in blocks of consecutive element indices.
+       Only linear meshes in the MFEM mesh v1.0 and v1.2 formats are supported.
+       The @a refine and @a fix_orientation parameters are passed to the method
+       Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const char *filename,
+           const char *partition_file = NULL, bool refine = true,
+           bool fix_orientation = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -0,0 +1,1206 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of the distributed reading of serial mesh files by ParMesh
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "mesh_headers.hpp"
+#include "../general/sets.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+namespace mfem
+{
+
+// Exchange records of 'rsize' entries: record i of 'send' goes to the rank
+// dest[i]. The records sent to a rank keep their order and the received
+// records are ordered by the source rank, so if 'dest' is non-decreasing, the
+// answers to a set of requests are received in the order of the requests. If
+// 'src' is not NULL, it is set to the source rank of each received record.
+template <typename T>
+static void ExchangeRecords(MPI_Comm comm, int rsize, const Array<int> &dest,
+                            const Array<T> &send, Array<T> &recv,
+                            Array<int> *src = NULL)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int n = dest.Size();
+   MFEM_ASSERT(send.Size() == n*rsize, "invalid send buffer");
+
+   Array<int> send_cnt(nranks), recv_cnt(nranks);
+   Array<int> send_off(nranks+1), recv_off(nranks+1);
+   send_cnt = 0;
+   for (int i = 0; i < n; i++) { send_cnt[dest[i]]++; }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+   send_off[0] = recv_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_off[r+1] = send_off[r] + send_cnt[r];
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+
+   Array<T> buf(n*rsize);
+   Array<int> pos(nranks);
+   for (int r = 0; r < nranks; r++) { pos[r] = send_off[r]; }
+   for (int i = 0; i < n; i++)
+   {
+      const int k = pos[dest[i]]++;
+      for (int j = 0; j < rsize; j++) { buf[k*rsize + j] = send[i*rsize + j]; }
+   }
+
+   if (src)
+   {
+      src->SetSize(recv_off[nranks]);
+      for (int r = 0; r < nranks; r++)
+      {
+         for (int i = recv_off[r]; i < recv_off[r+1]; i++) { (*src)[i] = r; }
+      }
+   }
+
+   recv.SetSize(recv_off[nranks]*rsize);
+   for (int r = 0; r <= nranks; r++)
+   {
+      if (r < nranks) { send_cnt[r] *= rsize; recv_cnt[r] *= rsize; }
+      send_off[r] *= rsize;
+      recv_off[r] *= rsize;
+   }
+   MPI_Alltoallv(buf.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 MPITypeMap<T>::mpi_type, recv.GetData(), recv_cnt.GetData(),
+                 recv_off.GetData(), MPITypeMap<T>::mpi_type, comm);
+}
+
+// Answer the requests received from the ranks 'src' (non-decreasing, as
+// returned by ExchangeRecords()) with the rows 'row' of 'lists'. The answers
+// to the requests of this rank are returned in the rows of 'answers'.
+static void ExchangeLists(MPI_Comm comm, const Array<int> &src,
+                          const Table &lists, const Array<int> &row,
+                          Table &answers)
+{
+   Array<int> sizes(src.Size()), dest, entries, recv_sizes, recv_entries;
+   for (int i = 0; i < src.Size(); i++)
+   {
+      sizes[i] = lists.RowSize(row[i]);
+      const int *l = lists.GetRow(row[i]);
+      for (int j = 0; j < sizes[i]; j++)
+      {
+         dest.Append(src[i]);
+         entries.Append(l[j]);
+      }
+   }
+   ExchangeRecords(comm, 1, src, sizes, recv_sizes);
+   ExchangeRecords(comm, 1, dest, entries, recv_entries);
+
+   answers.MakeI(recv_sizes.Size());
+   for (int i = 0; i < recv_sizes.Size(); i++)
+   {
+      answers.AddColumnsInRow(i, recv_sizes[i]);
+   }
+   answers.MakeJ();
+   for (int i = 0, k = 0; i < recv_sizes.Size(); i++)
+   {
+      for (int j = 0; j < recv_sizes[i]; j++)
+      {
+         answers.AddConnection(i, recv_entries[k++]);
+      }
+   }
+   answers.ShiftUpI();
+}
+
+// Compare the records 'i' and 'j' of an array with 'stride' entries per record
+// by their first 'ksize' entries.
+struct RecordLess
+{
+   const int *data;
+   int stride, ksize;
+
+   RecordLess(const Array<int> &rec, int stride_, int ksize_)
+      : data(rec.GetData()), stride(stride_), ksize(ksize_) { }
+
+   bool operator()(int i, int j) const
+   {
+      const int *a = data + i*stride, *b = data + j*stride;
+      for (int k = 0; k < ksize; k++)
+      {
+         if (a[k] != b[k]) { return a[k] < b[k]; }
+      }
+      return false;
+   }
+};
+
+// Sort the records of 'rec' by their first 'ksize' entries. If 'unique' is
+// true, only the first record with a given key is kept.
+static void SortRecords(Array<int> &rec, int stride, int ksize,
+                        bool unique = false)
+{
+   const int n = rec.Size()/stride;
+   Array<int> order(n);
+   for (int i = 0; i < n; i++) { order[i] = i; }
+   RecordLess less(rec, stride, ksize);
+   std::sort(order.begin(), order.end(), less);
+
+   Array<int> sorted(n*stride);
+   int m = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (unique && i > 0 && !less(order[i-1], order[i])) { continue; }
+      const int *r = &rec[order[i]*stride];
+      for (int j = 0; j < stride; j++) { sorted[m*stride + j] = r[j]; }
+      m++;
+   }
+   sorted.SetSize(m*stride);
+   Swap(rec, sorted);
+}
+
+// Return the index of the record with the given key in the records 'rec',
+// sorted by their first 'ksize' entries, or -1 if there is no such record.
+static int FindRecord(const Array<int> &rec, int stride, int ksize,
+                      const int *key)
+{
+   int lo = 0, hi = rec.Size()/stride;
+   while (lo < hi)
+   {
+      const int mid = (lo + hi)/2;
+      const int *r = &rec[mid*stride];
+      int cmp = 0;
+      for (int k = 0; k < ksize && cmp == 0; k++)
+      {
+         cmp = (r[k] < key[k]) ? -1 : (r[k] > key[k]) ? 1 : 0;
+      }
+      if (cmp == 0) { return mid; }
+      if (cmp < 0) { lo = mid+1; }
+      else { hi = mid; }
+   }
+   return -1;
+}
+
+// The rank holding the item 'idx' of a list distributed with the given
+// offsets.
+static int Holder(const Array<int> &offsets, int idx)
+{
+   return int(std::upper_bound(offsets.begin(), offsets.end(), idx) -
+              offsets.begin()) - 1;
+}
+
+// Read the lines of a text file that start in the share of this rank: the file
+// is split into equal byte ranges, one per rank, and every line is read by the
+// rank whose range contains its first character. The line ends are replaced
+// by '\0' characters.
+static void ReadFileShare(MPI_Comm comm, const char *filename, string &text)
+{
+   int nranks, rank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &rank);
+
+   ifstream input(filename, ios::in | ios::binary);
+   int good = input.good() ? 1 : 0, all_good;
+   MPI_Allreduce(&good, &all_good, 1, MPI_INT, MPI_MIN, comm);
+   MFEM_VERIFY(all_good, "unable to open the file " << filename);
+
+   input.seekg(0, ios::end);
+   const streamoff size = input.tellg();
+   const streamoff begin = size*rank/nranks, end = size*(rank+1)/nranks;
+
+   // skip the line that started in the range of the previous rank
+   streamoff start = begin;
+   if (begin > 0)
+   {
+      input.seekg(begin-1);
+      if (input.get() != '\n')
+      {
+         input.ignore(numeric_limits<streamsize>::max(), '\n');
+      }
+      start = input.good() ? streamoff(input.tellg()) : size;
+   }
+
+   text.clear();
+   if (start < end)
+   {
+      input.clear();
+      input.seekg(start);
+      text.resize(end - start);
+      input.read(&text[0], end - start);
+      if (text[text.size()-1] != '\n')
+      {
+         // complete the last line
+         string rest;
+         getline(input, rest);
+         text += rest;
+         text += '\n';
+      }
+   }
+   for (size_t i = 0; i < text.size(); i++)
+   {
+      if (text[i] == '\n' || text[i] == '\r') { text[i] = '\0'; }
+   }
+}
+
+static const char *SkipBlanks(const char *p)
+{
+   while (*p == ' ' || *p == '\t') { p++; }
+   return p;
+}
+
+enum { LINE_BLANK, LINE_COMMENT, LINE_DATA, LINE_KEYWORD };
+
+static int LineKind(const char *line)
+{
+   const char c = *SkipBlanks(line);
+   if (c == '\0') { return LINE_BLANK; }
+   if (c == '#') { return LINE_COMMENT; }
+   if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+   {
+      return LINE_DATA;
+   }
+   return LINE_KEYWORD;
+}
+
+// Parse the integers of a data line, return their number (at most 'max').
+static int ParseInts(const char *line, int *v, int max)
+{
+   int n = 0;
+   const char *p = line;
+   for ( ; n < max; n++)
+   {
+      char *q;
+      const long x = strtol(p, &q, 10);
+      if (q == p) { break; }
+      v[n] = (int) x;
+      p = q;
+   }
+   MFEM_VERIFY(*SkipBlanks(p) == '\0', "invalid data line: " << line);
+   return n;
+}
+
+// The edges of the reference element: the number of edges and their pairs of
+// vertices.
+static int RefEdges(int geom, const int *&ev)
+{
+   typedef Geometry G;
+   switch (geom)
+   {
+      case G::TRIANGLE:
+         ev = G::Constants<G::TRIANGLE>::Edges[0];
+         return G::Constants<G::TRIANGLE>::NumEdges;
+      case G::SQUARE:
+         ev = G::Constants<G::SQUARE>::Edges[0];
+         return G::Constants<G::SQUARE>::NumEdges;
+      case G::TETRAHEDRON:
+         ev = G::Constants<G::TETRAHEDRON>::Edges[0];
+         return G::Constants<G::TETRAHEDRON>::NumEdges;
+      case G::CUBE:
+         ev = G::Constants<G::CUBE>::Edges[0];
+         return G::Constants<G::CUBE>::NumEdges;
+      case G::PRISM:
+         ev = G::Constants<G::PRISM>::Edges[0];
+         return G::Constants<G::PRISM>::NumEdges;
+   }
+   return 0;
+}
+
+// The faces of a 3D reference element: the number of faces and their vertices,
+// 'stride' per face, with -1 after the vertices of triangles in prisms.
+static int RefFaces(int geom, const int *&fv, int &stride)
+{
+   typedef Geometry G;
+   switch (geom)
+   {
+      case G::TETRAHEDRON:
+         fv = G::Constants<G::TETRAHEDRON>::FaceVert[0];
+         stride = 3;
+         return G::Constants<G::TETRAHEDRON>::NumFaces;
+      case G::CUBE:
+         fv = G::Constants<G::CUBE>::FaceVert[0];
+         stride = 4;
+         return G::Constants<G::CUBE>::NumFaces;
+      case G::PRISM:
+         fv = G::Constants<G::PRISM>::FaceVert[0];
+         stride = 4;
+         return G::Constants<G::PRISM>::NumFaces;
+   }
+   return 0;
+}
+
+// Set the attribute list of the local mesh part to the global one.
+static void ReduceAttributes(MPI_Comm comm, Array<int> &attr)
+{
+   int max_attr = attr.Size() ? attr.Max() : 0, glob_max_attr;
+   MPI_Allreduce(&max_attr, &glob_max_attr, 1, MPI_INT, MPI_MAX, comm);
+
+   Array<int> used(glob_max_attr+1), glob_used(glob_max_attr+1);
+   used = 0;
+   for (int i = 0; i < attr.Size(); i++)
+   {
+      if (attr[i] >= 0) { used[attr[i]] = 1; }
+   }
+   MPI_Allreduce(used.GetData(), glob_used.GetData(), used.Size(), MPI_INT,
+                 MPI_MAX, comm);
+
+   Array<int> neg;
+   for (int i = 0; i < attr.Size() && attr[i] < 0; i++) { neg.Append(attr[i]); }
+   attr.SetSize(0);
+   attr.Append(neg);
+   for (int a = 0; a <= glob_max_attr; a++)
+   {
+      if (glob_used[a]) { attr.Append(a); }
+   }
+}
+
+
+/** Reads a serial mesh in the MFEM format, each rank reading a share of the
+    file, and distributes its elements to the ranks. The local part of each
+    rank is written in the parallel MFEM format of ParMesh::ParPrint(). */
+class ParMeshFileReader
+{
+protected:
+   MPI_Comm comm;
+   int nranks, rank;
+
+   enum { SEC_NONE, SEC_DIMENSION, SEC_ELEMENTS, SEC_BOUNDARY, SEC_VERTICES,
+          SEC_END
+        };
+   enum { HDR_DIM, HDR_NE, HDR_NBE, HDR_NV, HDR_SDIM, NUM_HDR };
+
+   // element records: index, attribute, geometry, vertices (-1 if unused)
+   static const int elem_stride = 3 + 8;
+   // boundary element records: index, attribute, geometry, vertices
+   static const int bdr_stride = 3 + 4;
+
+   // Parsing state: section, number of pending header lines, item index.
+   struct State
+   {
+      int sec, hdr, item;
+   };
+
+   int header[NUM_HDR];
+   bool have_format;
+   string unsupported; // the first unsupported section found
+
+   // the records read from the file by this rank
+   Array<int> file_elems, file_bdr;
+   Array<double> file_coord; // 3 entries per vertex
+   Array<int> file_ncoord;   // number of coordinates of each vertex
+
+   // the offsets of the elements and vertices read by each rank
+   Array<int> elem_offsets, vert_offsets;
+
+   Array<int> elem_part; // the partitioning of the elements read
+
+   // the local part: elements (with local vertex indices), boundary elements
+   // (with global vertex indices), the global indices of the vertices in
+   // increasing order, their coordinates and the ranks using them
+   Array<int> elems, bdr, vert;
+   Array<double> coord;
+   Table vert_group;
+
+   // the ranks that use each vertex read from the file
+   Table file_vert_ranks;
+
+   // The local edges and faces with only shared vertices, which may be shared
+   // (a face has 4 sorted local vertices, -1 for triangles, followed by the
+   // vertices in the order of an element), and the ranks using them.
+   Array<int> edges, faces;
+   Table edge_groups, face_groups;
+
+   void ProcessLine(const char *line, State &st, bool parse);
+   void Distribute();
+   void FindGroups(int stride, int tsize, const Array<int> &tuples,
+                   Table &groups);
+   void FindEdgesAndFaces();
+   void DistributeBoundary();
+
+   int Dim() const { return header[HDR_DIM]; }
+   // The local index of a vertex, or -1 if it is not local.
+   int LocalVertex(int gv) const
+   {
+      const int *v = std::lower_bound(vert.begin(), vert.end(), gv);
+      return (v != vert.end() && *v == gv) ? int(v - vert.begin()) : -1;
+   }
+   bool SharedVertex(int lv) const { return vert_group.RowSize(lv) > 1; }
+
+public:
+   ParMeshFileReader(MPI_Comm comm_) : comm(comm_)
+   {
+      MPI_Comm_size(comm, &nranks);
+      MPI_Comm_rank(comm, &rank);
+   }
+
+   /// Read the share of the mesh file of this rank.
+   void ReadMesh(const char *filename);
+
+   /** Read the partitioning from a file in the format of the mesh-explorer
+       miniapp or, if @a filename is NULL, partition the elements in blocks of
+       consecutive indices. */
+   void ReadPartitioning(const char *filename);
+
+   /// Send the elements to their ranks, find the shared entities.
+   void DistributeMesh();
+
+   /// Write the local part in the format of ParMesh::ParPrint().
+   void PrintLocal(std::ostream &out) const;
+};
+
+void ParMeshFileReader::ProcessLine(const char *line, State &st, bool parse)
+{
+   const int kind = LineKind(line);
+   if (kind == LINE_BLANK || kind == LINE_COMMENT) { return; }
+
+   if (kind == LINE_KEYWORD)
+   {
+      string kw;
+      istringstream words(line);
+      words >> kw;
+      if (kw == "MFEM")
+      {
+         const string format(SkipBlanks(line));
+         MFEM_VERIFY(format == "MFEM mesh v1.0" || format == "MFEM mesh v1.2",
+                     "unsupported mesh format for a distributed read: "
+                     << format);
+         have_format = true;
+         return;
+      }
+      if (st.sec == SEC_END) { return; }
+
+      st.hdr = 1;
+      st.item = 0;
+      if (kw == "dimension") { st.sec = SEC_DIMENSION; }
+      else if (kw == "elements") { st.sec = SEC_ELEMENTS; }
+      else if (kw == "boundary") { st.sec = SEC_BOUNDARY; }
+      else if (kw == "vertices") { st.sec = SEC_VERTICES; st.hdr = 2; }
+      else if (kw == "mfem_mesh_end" || kw == "mfem_serial_mesh_end")
+      {
+         st.sec = SEC_END;
+      }
+      else
+      {
+         if (unsupported.empty()) { unsupported = kw; }
+         st.sec = SEC_NONE;
+      }
+      return;
+   }
+
+   if (st.sec == SEC_END) { return; }
+   if (st.hdr > 0)
+   {
+      st.hdr--;
+      if (!parse) { return; }
+      int value;
+      ParseInts(line, &value, 1);
+      switch (st.sec)
+      {
+         case SEC_DIMENSION: header[HDR_DIM] = value; break;
+         case SEC_ELEMENTS: header[HDR_NE] = value; break;
+         case SEC_BOUNDARY: header[HDR_NBE] = value; break;
+         case SEC_VERTICES:
+            header[st.hdr ? HDR_NV : HDR_SDIM] = value; break;
+         default:
+            MFEM_ABORT("data outside of the mesh sections: " << line);
+      }
+      return;
+   }
+
+   const int item = st.item++;
+   if (!parse) { return; }
+   switch (st.sec)
+   {
+      case SEC_ELEMENTS:
+      case SEC_BOUNDARY:
+      {
+         const bool el = (st.sec == SEC_ELEMENTS);
+         const int stride = el ? elem_stride : bdr_stride;
+         Array<int> &rec = el ? file_elems : file_bdr;
+         rec.SetSize(rec.Size() + stride, -1);
+         int *r = &rec[rec.Size() - stride];
+         r[0] = item;
+         const int n = ParseInts(line, r+1, stride-1);
+         MFEM_VERIFY(n >= 2 && r[2] >= 0 && r[2] < Geometry::NumGeom &&
+                     n == 2 + Geometry::NumVerts[r[2]],
+                     "invalid element: " << line);
+         break;
+      }
+      case SEC_VERTICES:
+      {
+         const char *p = line;
+         int n = 0;
+         double x[3] = { 0.0, 0.0, 0.0 };
+         for ( ; n < 4; n++)
+         {
+            char *q;
+            const double c = strtod(p, &q);
+            if (q == p) { break; }
+            MFEM_VERIFY(n < 3, "invalid vertex: " << line);
+            x[n] = c;
+            p = q;
+         }
+         MFEM_VERIFY(*SkipBlanks(p) == '\0', "invalid vertex: " << line);
+         file_coord.Append(x, 3);
+         file_ncoord.Append(n);
+         break;
+      }
+      default:
+         MFEM_ABORT("data outside of the mesh sections: " << line);
+   }
+}
+
+void ParMeshFileReader::ReadMesh(const char *filename)
+{
+   string text;
+   ReadFileShare(comm, filename, text);
+   const char *end = text.data() + text.size();
+
+   // The state at the start of the share depends on the preceding shares.
+   // Find the number of data lines before the first keyword and the state at
+   // the end of the share, if it contains a keyword.
+   int summary[6] = { 0, 0, SEC_NONE, 0, 0, 0 };
+   {
+      State st = { SEC_NONE, 0, 0 };
+      bool keyword = false;
+      have_format = false;
+      for (const char *l = text.data(); l < end; l += strlen(l) + 1)
+      {
+         const int kind = LineKind(l);
+         if (kind == LINE_KEYWORD) { keyword = true; }
+         else if (kind == LINE_DATA && !keyword) { summary[1]++; continue; }
+         ProcessLine(l, st, false);
+      }
+      summary[0] = keyword;
+      summary[2] = st.sec;
+      summary[3] = st.hdr;
+      summary[4] = st.item;
+      summary[5] = have_format + 2*!unsupported.empty();
+   }
+   Array<int> summaries(6*nranks);
+   MPI_Allgather(summary, 6, MPI_INT, summaries.GetData(), 6, MPI_INT, comm);
+
+   int format = 0, first_unsupported = -1;
+   for (int r = nranks-1; r >= 0; r--)
+   {
+      format |= summaries[6*r+5] & 1;
+      if (summaries[6*r+5] & 2) { first_unsupported = r; }
+   }
+   MFEM_VERIFY(format, "the file " << filename
+               << " is not an MFEM mesh v1.0 or v1.2");
+   if (first_unsupported >= 0)
+   {
+      // e.g. 'nodes' (curved meshes) or 'vertex_parents'
+      char section[64] = "";
+      strncpy(section, unsupported.c_str(), sizeof(section)-1);
+      MPI_Bcast(section, sizeof(section), MPI_CHAR, first_unsupported, comm);
+      MFEM_ABORT("unsupported mesh section for a distributed read: "
+                 << section);
+   }
+
+   State st = { SEC_NONE, 0, 0 };
+   for (int r = 0; r < rank; r++)
+   {
+      const int *s = &summaries[6*r];
+      if (s[0])
+      {
+         st.sec = s[2];
+         st.hdr = s[3];
+         st.item = s[4];
+      }
+      else
+      {
+         const int h = std::min(s[1], st.hdr);
+         st.hdr -= h;
+         st.item += s[1] - h;
+      }
+   }
+
+   for (int i = 0; i < NUM_HDR; i++) { header[i] = -1; }
+   for (const char *l = text.data(); l < end; l += strlen(l) + 1)
+   {
+      ProcessLine(l, st, true);
+   }
+
+   int glob_header[NUM_HDR];
+   MPI_Allreduce(header, glob_header, NUM_HDR, MPI_INT, MPI_MAX, comm);
+   for (int i = 0; i < NUM_HDR; i++)
+   {
+      MFEM_VERIFY(glob_header[i] >= 0, "incomplete mesh file: " << filename);
+      header[i] = glob_header[i];
+   }
+
+   // offsets of the elements and vertices of the shares
+   int counts[3] = { file_elems.Size()/elem_stride, file_bdr.Size()/bdr_stride,
+                     file_ncoord.Size()
+                   };
+   Array<int> all_counts(3*nranks);
+   MPI_Allgather(counts, 3, MPI_INT, all_counts.GetData(), 3, MPI_INT, comm);
+   elem_offsets.SetSize(nranks+1);
+   vert_offsets.SetSize(nranks+1);
+   elem_offsets[0] = vert_offsets[0] = 0;
+   int nbe = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      elem_offsets[r+1] = elem_offsets[r] + all_counts[3*r];
+      nbe += all_counts[3*r+1];
+      vert_offsets[r+1] = vert_offsets[r] + all_counts[3*r+2];
+   }
+   MFEM_VERIFY(elem_offsets[nranks] == header[HDR_NE] &&
+               nbe == header[HDR_NBE] &&
+               vert_offsets[nranks] == header[HDR_NV],
+               "inconsistent number of items in the mesh file " << filename);
+
+   for (int i = 0; i < file_ncoord.Size(); i++)
+   {
+      MFEM_VERIFY(file_ncoord[i] == header[HDR_SDIM],
+                  "invalid number of coordinates of vertex "
+                  << vert_offsets[rank] + i);
+   }
+   for (int i = 0; i < file_elems.Size(); i += elem_stride)
+   {
+      MFEM_VERIFY(Geometry::Dimension[file_elems[i+2]] == Dim(),
+                  "invalid geometry of element " << file_elems[i]);
+   }
+   for (int i = 0; i < file_bdr.Size(); i += bdr_stride)
+   {
+      MFEM_VERIFY(Geometry::Dimension[file_bdr[i+2]] == Dim()-1,
+                  "invalid geometry of boundary element " << file_bdr[i]);
+   }
+}
+
+void ParMeshFileReader::ReadPartitioning(const char *filename)
+{
+   const int ne = header[HDR_NE];
+   const int first = elem_offsets[rank];
+   elem_part.SetSize(elem_offsets[rank+1] - first);
+   if (!filename)
+   {
+      for (int i = 0; i < elem_part.Size(); i++)
+      {
+         elem_part[i] = int(((long) (first + i + 1)*nranks - 1)/ne);
+      }
+      return;
+   }
+
+   string text;
+   ReadFileShare(comm, filename, text);
+   const char *end = text.data() + text.size();
+
+   int sizes[2] = { -1, -1 }; // number_of_elements, number_of_processors
+   Array<int> part;
+   for (const char *l = text.data(); l < end; l += strlen(l) + 1)
+   {
+      const int kind = LineKind(l);
+      if (kind == LINE_DATA)
+      {
+         int p;
+         ParseInts(l, &p, 1);
+         MFEM_VERIFY(p >= 0 && p < nranks, "invalid partition: " << p);
+         part.Append(p);
+      }
+      else if (kind == LINE_KEYWORD)
+      {
+         string kw;
+         int value = -1;
+         istringstream words(l);
+         words >> kw >> value;
+         if (kw == "number_of_elements") { sizes[0] = value; }
+         else if (kw == "number_of_processors") { sizes[1] = value; }
+         else { MFEM_ABORT("invalid partitioning file: " << l); }
+      }
+   }
+   int glob_sizes[2], count = part.Size(), offset = 0, total;
+   MPI_Allreduce(sizes, glob_sizes, 2, MPI_INT, MPI_MAX, comm);
+   MPI_Allreduce(&count, &total, 1, MPI_INT, MPI_SUM, comm);
+   MPI_Exscan(&count, &offset, 1, MPI_INT, MPI_SUM, comm);
+   if (rank == 0) { offset = 0; }
+   MFEM_VERIFY(total == ne && (glob_sizes[0] < 0 || glob_sizes[0] == ne),
+               "the partitioning does not match the number of elements");
+   MFEM_VERIFY(glob_sizes[1] < 0 || glob_sizes[1] == nranks,
+               "the partitioning does not match the number of MPI ranks");
+
+   // send the entries to the ranks holding the elements
+   Array<int> dest(count), rec(2*count), recv;
+   for (int i = 0; i < count; i++)
+   {
+      dest[i] = Holder(elem_offsets, offset + i);
+      rec[2*i] = offset + i;
+      rec[2*i+1] = part[i];
+   }
+   ExchangeRecords(comm, 2, dest, rec, recv);
+   for (int i = 0; i < recv.Size(); i += 2)
+   {
+      elem_part[recv[i] - first] = recv[i+1];
+   }
+}
+
+void ParMeshFileReader::Distribute()
+{
+   // the elements, in increasing global order
+   ExchangeRecords(comm, elem_stride, elem_part, file_elems, elems);
+   file_elems.DeleteAll();
+
+   // the vertices of the local elements
+   for (int i = 0; i < elems.Size(); i += elem_stride)
+   {
+      const int nv = Geometry::NumVerts[elems[i+2]];
+      for (int j = 0; j < nv; j++)
+      {
+         const int v = elems[i+3+j];
+         MFEM_VERIFY(v >= 0 && v < header[HDR_NV],
+                     "invalid vertex index in element " << elems[i]);
+         vert.Append(v);
+      }
+   }
+   vert.Sort();
+   vert.Unique();
+
+   // Request the coordinates from the ranks holding the vertices. These ranks
+   // record the ranks using each vertex and answer with the vertex groups.
+   Array<int> dest(vert.Size()), requests, src;
+   for (int i = 0; i < vert.Size(); i++)
+   {
+      dest[i] = Holder(vert_offsets, vert[i]);
+   }
+   ExchangeRecords(comm, 1, dest, vert, requests, &src);
+
+   const int sdim = header[HDR_SDIM], first = vert_offsets[rank];
+   Array<double> answers(requests.Size()*sdim);
+   Array<int> row(requests.Size());
+   file_vert_ranks.MakeI(file_ncoord.Size());
+   for (int i = 0; i < requests.Size(); i++)
+   {
+      row[i] = requests[i] - first;
+      for (int d = 0; d < sdim; d++)
+      {
+         answers[i*sdim + d] = file_coord[3*row[i] + d];
+      }
+      file_vert_ranks.AddAColumnInRow(row[i]);
+   }
+   file_vert_ranks.MakeJ();
+   for (int i = 0; i < requests.Size(); i++)
+   {
+      file_vert_ranks.AddConnection(row[i], src[i]);
+   }
+   file_vert_ranks.ShiftUpI();
+   file_coord.DeleteAll();
+
+   ExchangeRecords(comm, sdim, src, answers, coord);
+   ExchangeLists(comm, src, file_vert_ranks, row, vert_group);
+
+   // Use local vertex indices in the elements. The local vertices usually
+   // have a compact range of global indices, then map them with an array.
+   const int range = vert.Size() ? vert.Last() - vert[0] + 1 : 0;
+   Array<int> local;
+   if (range <= 4*vert.Size() + 1024)
+   {
+      local.SetSize(range);
+      for (int i = 0; i < vert.Size(); i++) { local[vert[i] - vert[0]] = i; }
+   }
+   for (int i = 0; i < elems.Size(); i += elem_stride)
+   {
+      for (int j = 0; j < Geometry::NumVerts[elems[i+2]]; j++)
+      {
+         int &v = elems[i+3+j];
+         v = local.Size() ? local[v - vert[0]] : LocalVertex(v);
+      }
+   }
+}
+
+void ParMeshFileReader::FindGroups(int stride, int tsize,
+                                   const Array<int> &tuples, Table &groups)
+{
+   // Send the tuples of sorted global vertex indices to the holders of their
+   // first vertex, which find the ranks sending the same tuple.
+   const int n = tuples.Size()/stride;
+   Array<int> dest(n), send(n*tsize), recv, src;
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < tsize; j++)
+      {
+         const int lv = tuples[i*stride + j];
+         send[i*tsize + j] = (lv >= 0) ? vert[lv] : -1;
+      }
+      dest[i] = Holder(vert_offsets, send[i*tsize]);
+   }
+   ExchangeRecords(comm, tsize, dest, send, recv, &src);
+
+   const int m = src.Size(), rstride = tsize + 2;
+   Array<int> rec(m*rstride);
+   for (int i = 0; i < m; i++)
+   {
+      for (int j = 0; j < tsize; j++)
+      {
+         rec[i*rstride + j] = recv[i*tsize + j];
+      }
+      rec[i*rstride + tsize] = src[i];
+      rec[i*rstride + tsize + 1] = i;
+   }
+   SortRecords(rec, rstride, tsize + 1);
+
+   Table ranks;
+   Array<int> row(m);
+   ranks.MakeI(m);
+   int nrows = 0;
+   for (int i = 0; i < m; i++)
+   {
+      const int *r = &rec[i*rstride];
+      if (i > 0 && !std::equal(r, r + tsize, r - rstride)) { nrows++; }
+      row[r[tsize+1]] = nrows;
+      ranks.AddAColumnInRow(nrows);
+   }
+   ranks.MakeJ();
+   for (int i = 0; i < m; i++)
+   {
+      const int *r = &rec[i*rstride];
+      ranks.AddConnection(row[r[tsize+1]], r[tsize]);
+   }
+   ranks.ShiftUpI();
+
+   ExchangeLists(comm, src, ranks, row, groups);
+}
+
+void ParMeshFileReader::FindEdgesAndFaces()
+{
+   const int dim = Dim();
+   for (int i = 0; i < elems.Size(); i += elem_stride)
+   {
+      const int *v = &elems[i+3];
+      const int *ev, *fv;
+      int stride;
+      const int ne = (dim >= 2) ? RefEdges(elems[i+2], ev) : 0;
+      for (int j = 0; j < ne; j++, ev += 2)
+      {
+         const int v0 = v[ev[0]], v1 = v[ev[1]];
+         if (SharedVertex(v0) && SharedVertex(v1))
+         {
+            edges.Append(std::min(v0, v1));
+            edges.Append(std::max(v0, v1));
+         }
+      }
+      const int nf = (dim == 3) ? RefFaces(elems[i+2], fv, stride) : 0;
+      for (int j = 0; j < nf; j++, fv += stride)
+      {
+         const int nfv = (stride == 4 && fv[3] >= 0) ? 4 : 3;
+         bool shared = true;
+         int f[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+         for (int k = 0; k < nfv; k++)
+         {
+            f[k] = f[4+k] = v[fv[k]];
+            shared = shared && SharedVertex(f[k]);
+         }
+         if (!shared) { continue; }
+         std::sort(f, f + nfv);
+         faces.Append(f, 8);
+      }
+   }
+   SortRecords(edges, 2, 2, true);
+   SortRecords(faces, 8, 4, true);
+
+   FindGroups(2, 2, edges, edge_groups);
+   FindGroups(8, 4, faces, face_groups);
+   for (int i = 0; i < face_groups.Size(); i++)
+   {
+      MFEM_VERIFY(face_groups.RowSize(i) <= 2,
+                  "a face is shared by more than two elements");
+   }
+}
+
+void ParMeshFileReader::DistributeBoundary()
+{
+   // Send the boundary elements to the holders of their smallest vertex, which
+   // forward them to the ranks using that vertex.
+   const int nbe = file_bdr.Size()/bdr_stride, first = vert_offsets[rank];
+   Array<int> dest(nbe), recv;
+   for (int i = 0; i < nbe; i++)
+   {
+      const int *b = &file_bdr[i*bdr_stride];
+      int vmin = b[3];
+      for (int j = 1; j < Geometry::NumVerts[b[2]]; j++)
+      {
+         vmin = std::min(vmin, b[3+j]);
+      }
+      MFEM_VERIFY(vmin >= 0 && vmin < header[HDR_NV],
+                  "invalid vertex index in boundary element " << b[0]);
+      dest[i] = Holder(vert_offsets, vmin);
+   }
+   ExchangeRecords(comm, bdr_stride, dest, file_bdr, recv);
+   file_bdr.DeleteAll();
+
+   Array<int> fwd;
+   dest.SetSize(0);
+   for (int i = 0; i < recv.Size(); i += bdr_stride)
+   {
+      const int *b = &recv[i];
+      int vmin = b[3];
+      for (int j = 1; j < Geometry::NumVerts[b[2]]; j++)
+      {
+         vmin = std::min(vmin, b[3+j]);
+      }
+      const int row = vmin - first;
+      for (int j = 0; j < file_vert_ranks.RowSize(row); j++)
+      {
+         dest.Append(file_vert_ranks.GetRow(row)[j]);
+         fwd.Append(b, bdr_stride);
+      }
+   }
+   ExchangeRecords(comm, bdr_stride, dest, fwd, recv);
+
+   // Keep the boundary elements whose face is local. A face with a vertex
+   // that is not shared can only be local and a face with only shared
+   // vertices is local if it is in 'edges' (2D) or 'faces' (3D). A shared
+   // face is kept by the lowest rank of its group.
+   const int dim = Dim();
+   for (int i = 0; i < recv.Size(); i += bdr_stride)
+   {
+      const int *b = &recv[i];
+      const int nv = Geometry::NumVerts[b[2]];
+      int f[4] = { -1, -1, -1, -1 };
+      bool local = true, shared = true;
+      for (int j = 0; j < nv; j++)
+      {
+         f[j] = LocalVertex(b[3+j]);
+         local = local && (f[j] >= 0);
+         shared = shared && local && SharedVertex(f[j]);
+      }
+      if (!local) { continue; }
+
+      int lowest = rank;
+      if (shared)
+      {
+         std::sort(f, f + nv);
+         if (dim == 1)
+         {
+            lowest = vert_group.GetRow(f[0])[0];
+         }
+         else
+         {
+            const Array<int> &ent = (dim == 2) ? edges : faces;
+            const Table &groups = (dim == 2) ? edge_groups : face_groups;
+            const int e = FindRecord(ent, (dim == 2) ? 2 : 8,
+                                     (dim == 2) ? 2 : 4, f);
+            if (e < 0) { continue; }
+            lowest = groups.GetRow(e)[0];
+         }
+      }
+      if (lowest == rank) { bdr.Append(b, bdr_stride); }
+   }
+   SortRecords(bdr, bdr_stride, 1);
+}
+
+void ParMeshFileReader::DistributeMesh()
+{
+   Distribute();
+   FindEdgesAndFaces();
+   DistributeBoundary();
+}
+
+void ParMeshFileReader::PrintLocal(std::ostream &out) const
+{
+   const int dim = Dim(), sdim = header[HDR_SDIM];
+
+   out << "MFEM mesh v1.2\n\ndimension\n" << dim
+       << "\n\nelements\n" << elems.Size()/elem_stride << '\n';
+   for (int i = 0; i < elems.Size(); i += elem_stride)
+   {
+      const int *e = &elems[i];
+      out << e[1] << ' ' << e[2];
+      for (int j = 0; j < Geometry::NumVerts[e[2]]; j++)
+      {
+         out << ' ' << e[3+j];
+      }
+      out << '\n';
+   }
+
+   out << "\nboundary\n" << bdr.Size()/bdr_stride << '\n';
+   for (int i = 0; i < bdr.Size(); i += bdr_stride)
+   {
+      const int *b = &bdr[i];
+      out << b[1] << ' ' << b[2];
+      for (int j = 0; j < Geometry::NumVerts[b[2]]; j++)
+      {
+         out << ' ' << LocalVertex(b[3+j]);
+      }
+      out << '\n';
+   }
+
+   const std::streamsize old_prec = out.precision(17);
+   out << "\nvertices\n" << vert.Size() << '\n' << sdim << '\n';
+   for (int i = 0; i < vert.Size(); i++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         out << coord[i*sdim + d] << (d+1 < sdim ? ' ' : '\n');
+      }
+   }
+   out.precision(old_prec);
+   out << "\nmfem_serial_mesh_end\n";
+
+   // The communication groups, with the shared entities in increasing global
+   // order, which is the same on all ranks of a group.
+   ListOfIntegerSets groups;
+   IntegerSet me(1, &rank);
+   groups.Insert(me);
+   Array<int> ent_group[3];
+   Table group_ent[3];
+   for (int k = 0; k < 3; k++)
+   {
+      const Table &ranks = (k == 0) ? vert_group :
+                           (k == 1) ? edge_groups : face_groups;
+      ent_group[k].SetSize(ranks.Size());
+      for (int i = 0; i < ranks.Size(); i++)
+      {
+         ent_group[k][i] = -1;
+         if (ranks.RowSize(i) > 1)
+         {
+            IntegerSet set(ranks.RowSize(i), ranks.GetRow(i));
+            ent_group[k][i] = groups.Insert(set);
+         }
+      }
+   }
+   const int ngroups = groups.Size();
+   for (int k = 0; k < 3; k++)
+   {
+      // the shared entities in output order: triangles before quadrilaterals
+      Array<int> order;
+      for (int pass = 0; pass < ((k == 2) ? 2 : 1); pass++)
+      {
+         for (int i = 0; i < ent_group[k].Size(); i++)
+         {
+            if (ent_group[k][i] >= 0 &&
+                (k < 2 || (faces[8*i+3] >= 0) == (pass == 1)))
+            {
+               order.Append(i);
+            }
+         }
+      }
+      group_ent[k].MakeI(ngroups);
+      for (int i = 0; i < order.Size(); i++)
+      {
+         group_ent[k].AddAColumnInRow(ent_group[k][order[i]]);
+      }
+      group_ent[k].MakeJ();
+      for (int i = 0; i < order.Size(); i++)
+      {
+         group_ent[k].AddConnection(ent_group[k][order[i]], order[i]);
+      }
+      group_ent[k].ShiftUpI();
+   }
+
+   Table group_ranks;
+   groups.AsTable(group_ranks);
+   out << "\ncommunication_groups\nnumber_of_groups " << ngroups << "\n\n";
+   for (int g = 0; g < ngroups; g++)
+   {
+      out << group_ranks.RowSize(g);
+      for (int j = 0; j < group_ranks.RowSize(g); j++)
+      {
+         out << ' ' << group_ranks.GetRow(g)[j];
+      }
+      out << '\n';
+   }
+
+   out << "\ntotal_shared_vertices " << group_ent[0].Size_of_connections()
+       << '\n';
+   if (dim >= 2)
+   {
+      out << "total_shared_edges " << group_ent[1].Size_of_connections()
+          << '\n';
+   }
+   if (dim >= 3)
+   {
+      out << "total_shared_faces " << group_ent[2].Size_of_connections()
+          << '\n';
+   }
+   for (int g = 1; g < ngroups; g++)
+   {
+      out << "\n# group " << g << "\nshared_vertices "
+          << group_ent[0].RowSize(g) << '\n';
+      for (int j = 0; j < group_ent[0].RowSize(g); j++)
+      {
+         out << group_ent[0].GetRow(g)[j] << '\n';
+      }
+      if (dim >= 2)
+      {
+         out << "\nshared_edges " << group_ent[1].RowSize(g) << '\n';
+         for (int j = 0; j < group_ent[1].RowSize(g); j++)
+         {
+            const int *e = &edges[2*group_ent[1].GetRow(g)[j]];
+            out << e[0] << ' ' << e[1] << '\n';
+         }
+      }
+      if (dim >= 3)
+      {
+         out << "\nshared_faces " << group_ent[2].RowSize(g) << '\n';
+         for (int j = 0; j < group_ent[2].RowSize(g); j++)
+         {
+            const int *f = &faces[8*group_ent[2].GetRow(g)[j]];
+            if (f[3] < 0)
+            {
+               out << Geometry::TRIANGLE;
+               for (int k = 0; k < 3; k++) { out << ' ' << f[k]; }
+            }
+            else
+            {
+               // Start the quadrilateral at its smallest vertex, continue to
+               // the smaller of its neighbors, as on the other rank.
+               const int *c = f + 4;
+               int s = 0;
+               for (int k = 1; k < 4; k++) { if (c[k] < c[s]) { s = k; } }
+               const int dir = (c[(s+1)%4] < c[(s+3)%4]) ? 1 : 3;
+               out << Geometry::SQUARE;
+               for (int k = 0; k < 4; k++)
+               {
+                  out << ' ' << c[(s + k*dir)%4];
+               }
+            }
+            out << '\n';
+         }
+      }
+   }
+   out << "\nmfem_mesh_end" << endl;
+}
+
+
+ParMesh::ParMesh(MPI_Comm comm, const char *filename,
+                 const char *partition_file, bool refine,
+                 bool fix_orientation)
+   : gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   stringstream local;
+   {
+      ParMeshFileReader reader(comm);
+      reader.ReadMesh(filename);
+      reader.ReadPartitioning(partition_file);
+      reader.DistributeMesh();
+      reader.PrintLocal(local);
+   }
+   ParLoader(local, refine, fix_orientation);
+
+   // as in ParMesh(MPI_Comm, Mesh &, ...), the attribute lists are global
+   ReduceAttributes(MyComm, attributes);
+   ReduceAttributes(MyComm, bdr_attributes);
+}
+
+}
+
+#endif
@@ -444,9 +444,12 @@ void ParNCMesh::MakeSharedList(const NCList &list, NCList &shared)
    }
    for (unsigned i = 0; i < list.slaves.size(); i++)
    {
-      if (tmp_shared_flag[list.slaves[i].index] == 0x3)
+      const Slave &slave = list.slaves[i];
+      if (tmp_shared_flag[slave.index] == 0x3)
       {
-         shared.slaves.push_back(list.slaves[i]);
+         shared.slaves.push_back(slave);
+         shared.slaves.back().matrix =
+            shared.AddPointMatrix(*list.point_matrices[slave.matrix]);
       }
    }
 }
@@ -1184,7 +1187,7 @@ void ParNCMesh::GetFaceNeighbors(ParMesh &pmesh)
             MFEM_ASSERT(fi.Elem2No >= NElements, "");
             fi.Elem2No = -1 - fnbr_index[fi.Elem2No - NElements];
 
-            const DenseMatrix* pm = &sf.point_matrix;
+            const DenseMatrix* pm = full_list.point_matrices[sf.matrix];
             if (!sloc && Dim == 3)
             {
                // ghost slave in 3D needs flipping orientation
@@ -1196,7 +1199,7 @@ void ParNCMesh::GetFaceNeighbors(ParMesh &pmesh)
                fi.Elem2Inf ^= 1;
                pm = pm2;
 
-               // The problem is that sf.point_matrix is designed for P matrix
+               // The problem is that the point matrix is designed for P matrix
                // construction and always has orientation relative to the slave
                // face. In ParMesh::GetSharedFaceTransformations the result
                // would therefore be the same on both processors, which is not
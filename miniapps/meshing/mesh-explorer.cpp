@@ -20,6 +20,7 @@
 //    - mesh scaling, randomization, and general transformation
 //    - manipulation of the mesh curvature
 //    - the ability to simulate parallel partitioning
+//    - element reordering along Hilbert or Morton space-filling curves
 //    - quantitative and visual reports of mesh quality
 //
 // Compile with: make mesh-explorer
@@ -30,6 +31,7 @@
 //               mesh-explorer -m ../../data/disc-nurbs.mesh
 //               mesh-explorer -m ../../data/escher-p3.mesh
 //               mesh-explorer -m ../../data/mobius-strip.mesh
+//               mesh-explorer -m ../../data/fichera.mesh -sfc 1
 
 #include "mfem.hpp"
 #include <fstream>
@@ -118,11 +120,32 @@ Mesh *read_par_mesh(int np, const char *mesh_prefix)
    return mesh;
 }
 
+// Reorder the mesh elements along a space-filling curve, used with the 'o'
+// menu option and the -sfc command line option: 1 - Hilbert, 2 - Morton.
+void reorder_elements(Mesh *mesh, int sfc_type)
+{
+   Array<int> ordering;
+   if (sfc_type == 1)
+   {
+      mesh->GetHilbertElementOrdering(ordering);
+   }
+   else if (sfc_type == 2)
+   {
+      mesh->GetMortonElementOrdering(ordering);
+   }
+   else
+   {
+      return;
+   }
+   mesh->ReorderElements(ordering);
+}
+
 int main (int argc, char *argv[])
 {
    int np = 0;
    const char *mesh_file = "../../data/beam-hex.mesh";
    bool refine = true;
+   int sfc_type = 0;
 
    OptionsParser args(argc, argv);
    args.AddOption(&mesh_file, "-m", "--mesh",
@@ -131,6 +154,9 @@ int main (int argc, char *argv[])
                   "Load mesh from multiple processors.");
    args.AddOption(&refine, "-ref", "--refinement", "-no-ref", "--no-refinement",
                   "Prepare the mesh for refinement or not.");
+   args.AddOption(&sfc_type, "-sfc", "--space-filling-curve",
+                  "Reorder the elements on load: 0 - no reordering,"
+                  " 1 - Hilbert curve, 2 - Morton curve.");
    args.Parse();
    if (!args.Good())
    {
@@ -162,6 +188,7 @@ int main (int argc, char *argv[])
          return 3;
       }
    }
+   reorder_elements(mesh, sfc_type);
    int dim  = mesh->Dimension();
    int sdim = mesh->SpaceDimension();
 
@@ -221,6 +248,7 @@ int main (int argc, char *argv[])
            "x) Print sub-element stats\n"
            "f) Find physical point in reference space\n"
            "p) Generate a partitioning\n"
+           "o) Reorder elements\n"
            "S) Save in MFEM format\n"
            "V) Save in VTK format (only linear and quadratic meshes)\n"
 #ifdef MFEM_USE_GZSTREAM
@@ -341,6 +369,18 @@ int main (int argc, char *argv[])
          print_char = 1;
       }
 
+      if (mk == 'o')
+      {
+         cout << "What type of reordering?\n"
+              "h) Hilbert space-filling curve\n"
+              "z) Morton (Z-order) space-filling curve\n"
+              "--> " << flush;
+         char rk;
+         cin >> rk;
+         reorder_elements(mesh, (rk == 'h') ? 1 : (rk == 'z') ? 2 : 0);
+         print_char = 1;
+      }
+
       if (mk == 'j')
       {
          double jitter;
@@ -648,6 +648,14 @@ int main (int argc, char *argv[])
    cout << "Minimum det(J) of the original mesh is " << tauval << endl;
 
    // 19. Finally, perform the nonlinear optimization.
+   //     The target matrices depend only on x0, so they are computed once and
+   //     reused in all Newton iterations and line-search trials. With OpenMP,
+   //     the element loops of the energy, residual and gradient evaluations
+   //     run on threads, each with its own copy of the TMOP integrators.
+   target_c->EnableTargetCaching();
+   he_nlf_integ->PrecomputeTargets(*fespace);
+   a.UseThreadedMult();
+   a.UseThreadedGradient();
    NewtonSolver *newton = NULL;
    if (tauval > 0.0)
    {
@@ -3,6 +3,8 @@
 // Compile with: make ex1
 //
 // Sample runs:  ex1 -m ../../data/fichera.mesh -perf -mf  -pc lor
+//               ex1 -m ../../data/fichera.mesh -perf -mf  -pc lor -ev
+//               ex1 -m ../../data/fichera.mesh -perf -mf  -bench 100 -no-vis
 //               ex1 -m ../../data/fichera.mesh -perf -asm -pc ho
 //               ex1 -m ../../data/fichera.mesh -perf -asm -pc ho -sc
 //               ex1 -m ../../data/fichera.mesh -std  -asm -pc ho
@@ -71,6 +73,8 @@ int main(int argc, char *argv[])
    const char *pc = "none";
    bool perf = true;
    bool matrix_free = true;
+   bool elem_vect = false;
+   int bench = 0;
    bool visualization = 1;
 
    OptionsParser args(argc, argv);
@@ -89,6 +93,13 @@ int main(int argc, char *argv[])
    args.AddOption(&matrix_free, "-mf", "--matrix-free", "-asm", "--assembly",
                   "Use matrix-free evaluation or efficient matrix assembly in "
                   "the high-performance version.");
+   args.AddOption(&elem_vect, "-ev", "--element-vectorization", "-no-ev",
+                  "--no-element-vectorization",
+                  "Use SIMD vectorization across elements in the matrix-free "
+                  "evaluation.");
+   args.AddOption(&bench, "-bench", "--benchmark",
+                  "Number of matrix-free operator applications used to compare"
+                  " the scalar and the element-vectorized versions.");
    args.AddOption(&pc, "-pc", "--preconditioner",
                   "Preconditioner: lor - low-order-refined (matrix-free) GS, "
                   "ho - high-order (assembled) GS, none.");
@@ -285,6 +296,7 @@ int main(int argc, char *argv[])
       a_hpc = new HPCBilinearForm(integ_t(coeff_t(1.0)), *fespace);
       if (matrix_free)
       {
+         a_hpc->UseElementVectorization(elem_vect);
          a_hpc->Assemble(); // partial assembly
       }
       else
@@ -295,6 +307,38 @@ int main(int argc, char *argv[])
    tic_toc.Stop();
    cout << " done, " << tic_toc.RealTime() << "s." << endl;
 
+   // Optionally, compare the performance of the scalar and the
+   // element-vectorized matrix-free operator actions.
+   if (perf && matrix_free && bench > 0)
+   {
+      HPCBilinearForm a_scalar(integ_t(coeff_t(1.0)), *fespace);
+      HPCBilinearForm a_vect(integ_t(coeff_t(1.0)), *fespace);
+      a_vect.UseElementVectorization();
+      a_scalar.Assemble();
+      a_vect.Assemble();
+
+      Vector u(fespace->GetVSize()), y_scalar(u.Size()), y_vect(u.Size());
+      u.Randomize(1);
+      double t_mult[2];
+      for (int v = 0; v < 2; v++)
+      {
+         HPCBilinearForm &a_bench = v ? a_vect : a_scalar;
+         Vector &y_bench = v ? y_vect : y_scalar;
+         tic_toc.Clear();
+         tic_toc.Start();
+         for (int i = 0; i < bench; i++) { a_bench.Mult(u, y_bench); }
+         tic_toc.Stop();
+         t_mult[v] = tic_toc.RealTime();
+      }
+      const double y_norm = y_scalar.Normlinf();
+      y_vect -= y_scalar;
+      cout << "Benchmark of " << bench << " operator applications:\n"
+           << "   scalar     : " << t_mult[0] << "s.\n"
+           << "   vectorized : " << t_mult[1] << "s. (speedup "
+           << t_mult[0]/t_mult[1] << ", relative difference "
+           << y_vect.Normlinf()/y_norm << ")" << endl;
+   }
+
    // 12. Solve the system A X = B with CG. In the standard case, use a simple
    //     symmetric Gauss-Seidel preconditioner.
 
@@ -0,0 +1,111 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//    -----------------------------------------------------------------
+//    Table Benchmark Miniapp:  Timing of the Table transpose and product
+//    -----------------------------------------------------------------
+//
+// This miniapp times the connectivity operations used after each mesh
+// refinement in FiniteElementSpace::Update() and in the mesh topology setup:
+// the transpose of the element-to-dof table, i.e. the dof-to-element table,
+// and the dof-to-dof product dof_el * el_dof, on a Cartesian hexahedral mesh.
+// When MFEM is built with OpenMP, the timings are also reported with a single
+// thread, for comparison with the threaded versions.
+//
+// Compile with: make table-bench
+//
+// Sample runs:  table-bench -n 16
+//               table-bench -n 32 -o 3 -r 3
+
+#include "mfem.hpp"
+#include <iostream>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace mfem;
+
+// Return the times per call of the transpose and of the product.
+static void TimeTables(const Table &el_dof, int ndofs, int repeat,
+                       double &t_transpose, double &t_mult)
+{
+   StopWatch sw;
+   Table dof_el, dof_dof;
+
+   sw.Clear();
+   sw.Start();
+   for (int i = 0; i < repeat; i++)
+   {
+      Transpose(el_dof, dof_el, ndofs);
+   }
+   sw.Stop();
+   t_transpose = sw.RealTime()/repeat;
+
+   sw.Clear();
+   sw.Start();
+   for (int i = 0; i < repeat; i++)
+   {
+      Mult(dof_el, el_dof, dof_dof);
+   }
+   sw.Stop();
+   t_mult = sw.RealTime()/repeat;
+}
+
+int main(int argc, char *argv[])
+{
+   // Parse command-line options.
+   int n = 16;
+   int order = 2;
+   int repeat = 5;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&n, "-n", "--elements",
+                  "Number of elements in each direction of the mesh.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&repeat, "-r", "--repeat",
+                  "Number of repetitions of each operation.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   Mesh mesh(n, n, n, Element::HEXAHEDRON);
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   const Table &el_dof = fes.GetElementToDofTable();
+
+   cout << "Number of elements:    " << mesh.GetNE() << '\n'
+        << "Number of dofs:        " << fes.GetNDofs() << '\n'
+        << "Element-dof entries:   " << el_dof.Size_of_connections() << endl;
+
+   double t_transpose, t_mult;
+#ifdef MFEM_USE_OPENMP
+   const int max_threads = omp_get_max_threads();
+   omp_set_num_threads(1);
+   TimeTables(el_dof, fes.GetNDofs(), repeat, t_transpose, t_mult);
+   cout << "\n1 thread:\n"
+        << "   Transpose(el_dof)     : " << t_transpose << " s\n"
+        << "   Mult(dof_el, el_dof)  : " << t_mult << " s" << endl;
+   omp_set_num_threads(max_threads);
+   cout << '\n' << max_threads << " threads:\n";
+#endif
+   TimeTables(el_dof, fes.GetNDofs(), repeat, t_transpose, t_mult);
+   cout << "   Transpose(el_dof)     : " << t_transpose << " s\n"
+        << "   Mult(dof_el, el_dof)  : " << t_mult << " s" << endl;
+
+   return 0;
+}
@@ -13,9 +13,26 @@
 #include "catch.hpp"
 #include <stdio.h>
 #include <unistd.h>  // rmdir
+#include <fstream>
+#include <sstream>
 
 using namespace mfem;
 
+static std::string CycleDir(const char *name, int cycle)
+{
+   char dir[32];
+   sprintf(dir, "%s_%05d", name, cycle);
+   return dir;
+}
+
+static std::string ReadFile(const std::string &fname)
+{
+   std::ifstream file(fname.c_str());
+   std::stringstream buffer;
+   buffer << file.rdbuf();
+   return buffer.str();
+}
+
 TEST_CASE("Visit data collection for input and output", "[VisItDataCollection]")
 {
    SECTION("Save and load visit files from mesh and fields")
@@ -93,4 +110,85 @@ TEST_CASE("Visit data collection for input and output", "[VisItDataCollection]")
       REQUIRE(remove("base_00005/v.00000") == 0);
       REQUIRE(rmdir("base_00005") == 0);
    }
+
+   SECTION("Save asynchronously and compare with the synchronous output")
+   {
+      Mesh mesh(3, 2, Element::TRIANGLE, 0, 3.0, 2.0);
+      H1_FECollection fec(2, mesh.Dimension());
+      FiniteElementSpace fespace(&mesh, &fec, 2, Ordering::byVDIM);
+      GridFunction u(&fespace);
+      Vector u0(u.Size());
+      for (int i = 0; i < u.Size(); ++i) { u0(i) = 0.5*i + 1.0; }
+
+      // reference files, written synchronously
+      VisItDataCollection dc_ref("sync", &mesh);
+      dc_ref.RegisterField("u", &u);
+      dc_ref.SetPadDigits(5);
+
+      VisItDataCollection dc("async", &mesh);
+      dc.RegisterField("u", &u);
+      dc.SetPadDigits(5);
+      dc.SetAsyncSave(true);
+      REQUIRE(dc.GetAsyncSave());
+
+      // the asynchronous saves take a snapshot of the data: every cycle has
+      // different data, which is changed by the next cycle while the previous
+      // saves may still be pending
+      const int ncycles = 4;
+      for (int cycle = 1; cycle <= ncycles; cycle++)
+      {
+         u = u0;
+         u *= cycle;
+         mesh.GetVertex(0)[0] = -0.1*cycle;
+
+         dc_ref.SetCycle(cycle);
+         dc_ref.Save();
+         dc.SetCycle(cycle);
+         dc.Save();
+      }
+      u = -1.0;
+      mesh.GetVertex(0)[0] = 0.0;
+      dc.WaitSave();
+      REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+      for (int cycle = 1; cycle <= ncycles; cycle++)
+      {
+         const std::string dir = CycleDir("async", cycle);
+         const std::string ref_dir = CycleDir("sync", cycle);
+         const std::string mesh_ref = ReadFile(ref_dir + "/mesh.00000");
+         const std::string u_ref = ReadFile(ref_dir + "/u.00000");
+         REQUIRE(mesh_ref.size() > 0);
+         REQUIRE(u_ref.size() > 0);
+         REQUIRE(ReadFile(dir + "/mesh.00000") == mesh_ref);
+         REQUIRE(ReadFile(dir + "/u.00000") == u_ref);
+      }
+
+      // the root file of an asynchronous save can be loaded
+      VisItDataCollection dc_new("async");
+      dc_new.SetPadDigits(5);
+      dc_new.Load(ncycles);
+      REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+      GridFunction *u_new = dc_new.GetField("u");
+      REQUIRE(u_new);
+      Vector u_diff(*u_new);
+      u_diff.Add(-ncycles, u0);
+      REQUIRE(u_diff.Normlinf() < 1e-10);
+      REQUIRE(fabs(dc_new.GetMesh()->GetVertex(0)[0] + 0.1*ncycles) < 1e-10);
+
+      dc.SetAsyncSave(false);
+      REQUIRE(!dc.GetAsyncSave());
+
+      for (int cycle = 1; cycle <= ncycles; cycle++)
+      {
+         const char *names[2] = { "async", "sync" };
+         for (int k = 0; k < 2; k++)
+         {
+            const std::string d = CycleDir(names[k], cycle);
+            REQUIRE(remove((d + ".mfem_root").c_str()) == 0);
+            REQUIRE(remove((d + "/mesh.00000").c_str()) == 0);
+            REQUIRE(remove((d + "/u.00000").c_str()) == 0);
+            REQUIRE(rmdir(d.c_str()) == 0);
+         }
+      }
+   }
 }
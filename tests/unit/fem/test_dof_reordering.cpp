@@ -0,0 +1,167 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+#include <sstream>
+
+using namespace mfem;
+
+namespace dof_reordering
+{
+
+static double func(const Vector &x)
+{
+   return sin(x(0) + 2.0*x(1)) + x(0)*x(1);
+}
+
+static void vector_func(const Vector &x, Vector &v)
+{
+   v(0) = x(0);
+   v(1) = x(1)*x(2);
+   v(2) = func(x);
+}
+
+static int Bandwidth(const SparseMatrix &A)
+{
+   int bw = 0;
+   for (int i = 0; i < A.Height(); i++)
+   {
+      for (int j = 0; j < A.RowSize(i); j++)
+      {
+         bw = std::max(bw, std::abs(A.GetRowColumns(i)[j] - i));
+      }
+   }
+   return bw;
+}
+
+// Solve a Poisson problem and return the solution in the canonical numbering,
+// using GridFunction::Save().
+static std::string Solve(FiniteElementSpace &fes, int &bandwidth)
+{
+   Mesh &mesh = *fes.GetMesh();
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+
+   FunctionCoefficient bdr(func);
+   GridFunction x(&fes);
+   x = 0.0;
+   x.ProjectBdrCoefficient(bdr, ess_bdr);
+
+   SparseMatrix A;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   bandwidth = Bandwidth(A);
+
+   GSSmoother M(A);
+   PCG(A, M, B, X, 0, 2000, 1e-30, 0.0);
+   a.RecoverFEMSolution(X, b, x);
+
+   // Round the values, so the output does not depend on round-off errors
+   for (int i = 0; i < x.Size(); i++)
+   {
+      x(i) = 1e-8*floor(1e8*x(i) + 0.5);
+   }
+   std::ostringstream out;
+   x.Save(out);
+   return out.str();
+}
+
+TEST_CASE("DOF reordering", "[FiniteElementSpace]")
+{
+   const DofReordering::Type types[3] = { DofReordering::NONE,
+                                          DofReordering::FIRST_TOUCH,
+                                          DofReordering::RCM
+                                        };
+   SECTION("Conforming mesh")
+   {
+      Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+      H1_FECollection fec(3, 2);
+
+      std::string sol[3];
+      int bandwidth[3];
+      for (int t = 0; t < 3; t++)
+      {
+         FiniteElementSpace fes(&mesh, &fec);
+         fes.ReorderDofs(types[t]);
+         REQUIRE(fes.GetDofReordering() == types[t]);
+         REQUIRE(fes.GetDofReorderingMap().Size() ==
+                 (t == 0 ? 0 : fes.GetNDofs()));
+         sol[t] = Solve(fes, bandwidth[t]);
+      }
+      REQUIRE(sol[1] == sol[0]);
+      REQUIRE(sol[2] == sol[0]);
+      REQUIRE(bandwidth[2] < bandwidth[0]/3);
+   }
+
+   SECTION("Nonconforming mesh and Update")
+   {
+      std::string sol[3];
+      int bandwidth[3];
+      for (int t = 0; t < 3; t++)
+      {
+         Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+         mesh.EnsureNCMesh();
+         H1_FECollection fec(2, 2);
+         FiniteElementSpace fes(&mesh, &fec);
+         fes.ReorderDofs(types[t]);
+
+         // The reordering is kept after refinement and the GridFunction
+         // update uses it.
+         FunctionCoefficient coeff(func);
+         GridFunction x(&fes);
+         x.ProjectCoefficient(coeff);
+         Array<int> refs;
+         refs.Append(0);
+         refs.Append(5);
+         mesh.GeneralRefinement(refs);
+         fes.Update();
+         x.Update();
+         REQUIRE(fes.GetDofReorderingMap().Size() ==
+                 (t == 0 ? 0 : fes.GetNDofs()));
+         REQUIRE(x.ComputeL2Error(coeff) < 1e-2);
+
+         sol[t] = Solve(fes, bandwidth[t]);
+      }
+      REQUIRE(sol[1] == sol[0]);
+      REQUIRE(sol[2] == sol[0]);
+   }
+
+   SECTION("Vector space")
+   {
+      Mesh mesh(3, 3, 3, Element::HEXAHEDRON, true);
+      H1_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec, 3, Ordering::byVDIM);
+      FiniteElementSpace fes_r(&mesh, &fec, 3, Ordering::byVDIM);
+      fes_r.ReorderDofs(DofReordering::RCM);
+
+      VectorFunctionCoefficient coeff(3, vector_func);
+      GridFunction x(&fes), x_r(&fes_r);
+      x.ProjectCoefficient(coeff);
+      x_r.ProjectCoefficient(coeff);
+      std::ostringstream out, out_r;
+      x.Save(out);
+      x_r.Save(out_r);
+      REQUIRE(out_r.str() == out.str());
+   }
+}
+
+} // namespace dof_reordering
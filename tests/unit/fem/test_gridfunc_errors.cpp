@@ -0,0 +1,151 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace mfem;
+
+namespace gridfunc_errors
+{
+
+static double func(const Vector &x)
+{
+   return sin(2.0*x(0))*cos(x(1)) + x(0)*x(1);
+}
+
+static void func_grad(const Vector &x, Vector &g)
+{
+   g(0) = 2.0*cos(2.0*x(0))*cos(x(1)) + x(1);
+   g(1) = -sin(2.0*x(0))*sin(x(1)) + x(0);
+}
+
+// Reference computation of the Lp error, point by point.
+static double LpErrorReference(const double p, GridFunction &x,
+                               Coefficient &exsol)
+{
+   FiniteElementSpace &fes = *x.FESpace();
+   double error = 0.0;
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      const FiniteElement &fe = *fes.GetFE(i);
+      const IntegrationRule &ir =
+         IntRules.Get(fe.GetGeomType(), 2*fe.GetOrder() + 1);
+      ElementTransformation &T = *fes.GetElementTransformation(i);
+      for (int j = 0; j < ir.GetNPoints(); j++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(j);
+         T.SetIntPoint(&ip);
+         const double err = fabs(x.GetValue(i, ip) - exsol.Eval(T, ip));
+         error += ip.weight*T.Weight()*pow(err, p);
+      }
+   }
+   return pow(error, 1.0/p);
+}
+
+TEST_CASE("GridFunction error norms", "[GridFunction]")
+{
+   Mesh mesh(4, 3, Element::QUADRILATERAL, true, 1.5, 1.0);
+   mesh.SetCurvature(2);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient exsol(func);
+   VectorFunctionCoefficient exgrad(2, func_grad);
+   GridFunction x(&fes);
+   x.ProjectCoefficient(exsol);
+
+   SECTION("Lp errors")
+   {
+      const double l2 = x.ComputeL2Error(exsol);
+      REQUIRE(l2 > 0.0);
+      REQUIRE(fabs(l2 - LpErrorReference(2.0, x, exsol)) < 1e-12*l2);
+      const double l3 = x.ComputeLpError(3.0, exsol);
+      REQUIRE(fabs(l3 - LpErrorReference(3.0, x, exsol)) < 1e-12*l3);
+
+      Coefficient *exsol_arr[1] = { &exsol };
+      REQUIRE(fabs(x.ComputeL2Error(exsol_arr) - l2) < 1e-12*l2);
+
+      L2_FECollection el_fec(0, 2);
+      FiniteElementSpace el_fes(&mesh, &el_fec);
+      GridFunction el_errors(&el_fes);
+      x.ComputeElementL2Errors(exsol, el_errors);
+      REQUIRE(fabs(sqrt(el_errors*el_errors) - l2) < 1e-12*l2);
+      x.ComputeElementMaxErrors(exsol, el_errors);
+      REQUIRE(el_errors.Max() == x.ComputeMaxError(exsol));
+   }
+
+   SECTION("Batch coefficient evaluation")
+   {
+      GridFunctionCoefficient x_coeff(&x);
+      const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 5);
+      Vector vals, func_vals;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         ElementTransformation &T = *mesh.GetElementTransformation(i);
+         x_coeff.Eval(vals, T, ir);
+         exsol.Eval(func_vals, T, ir);
+         for (int j = 0; j < ir.GetNPoints(); j++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(j);
+            T.SetIntPoint(&ip);
+            REQUIRE(fabs(vals(j) - x_coeff.Eval(T, ip)) < 1e-12);
+            REQUIRE(func_vals(j) == exsol.Eval(T, ip));
+         }
+      }
+   }
+
+   SECTION("H1 error")
+   {
+      ConstantCoefficient one(1.0);
+      const double h1 = x.ComputeH1Error(&exsol, &exgrad, &one, 1.0, 1);
+      REQUIRE(h1 > 0.0);
+
+      // Reference H1 semi-norm of the error, point by point.
+      double ref = 0.0;
+      Vector grad, exact(2);
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 4);
+         ElementTransformation &T = *mesh.GetElementTransformation(i);
+         for (int j = 0; j < ir.GetNPoints(); j++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(j);
+            T.SetIntPoint(&ip);
+            x.GetGradient(T, grad);
+            exgrad.Eval(exact, T, ip);
+            exact -= grad;
+            ref += ip.weight*T.Weight()*(exact*exact);
+         }
+      }
+      REQUIRE(fabs(h1 - sqrt(ref)) < 1e-12*h1);
+   }
+
+#ifdef MFEM_USE_OPENMP
+   SECTION("Independence of the number of threads")
+   {
+      const int nthreads = omp_get_max_threads();
+      omp_set_num_threads(1);
+      const double l2_1 = x.ComputeL2Error(exsol);
+      const double h1_1 = x.ComputeH1Error(&exsol, &exgrad, &exsol, 1.0, 1);
+      omp_set_num_threads(3);
+      const double l2_3 = x.ComputeL2Error(exsol);
+      const double h1_3 = x.ComputeH1Error(&exsol, &exgrad, &exsol, 1.0, 1);
+      omp_set_num_threads(nthreads);
+      REQUIRE(l2_1 == l2_3);
+      REQUIRE(h1_1 == h1_3);
+   }
+#endif
+}
+
+} // namespace gridfunc_errors
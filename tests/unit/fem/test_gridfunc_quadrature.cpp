@@ -0,0 +1,209 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace gridfunc_quadrature
+{
+
+// Curve the mesh, so that the Jacobians vary inside the elements.
+static void PerturbMesh(Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   mesh.SetCurvature(2);
+   GridFunction &nodes = *mesh.GetNodes();
+   const int nn = nodes.Size()/dim;
+   for (int i = 0; i < nn; i++)
+   {
+      const double x0 = nodes(nodes.FESpace()->DofToVDof(i, 0));
+      for (int d = 0; d < dim; d++)
+      {
+         const int vi = nodes.FESpace()->DofToVDof(i, d);
+         nodes(vi) += 0.05*sin(3.0*x0 + d)*nodes(vi)*(1.0 - nodes(vi));
+      }
+   }
+}
+
+// Compare the QuadratureFunction values and gradients of x with the point by
+// point evaluation.
+static void CompareWithPointwise(GridFunction &x, int qorder)
+{
+   FiniteElementSpace &fes = *x.FESpace();
+   Mesh &mesh = *fes.GetMesh();
+   const int vdim = fes.GetVDim(), sdim = mesh.SpaceDimension();
+
+   QuadratureSpace qspace(&mesh, qorder);
+   QuadratureFunction qvals(&qspace), qgrads(&qspace);
+   x.GetQuadratureValues(qvals);
+   x.GetQuadratureGradients(qgrads);
+   REQUIRE(qvals.GetVDim() == vdim);
+   REQUIRE(qgrads.GetVDim() == vdim*sdim);
+
+   double max_val_err = 0.0, max_grad_err = 0.0;
+   DenseMatrix el_vals, el_grads, grad, ir_vals, ir_grads;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      const IntegrationRule &ir = qspace.GetElementIntRule(i);
+      ElementTransformation &T = *mesh.GetElementTransformation(i);
+      qvals.GetElementValues(i, el_vals);
+      qgrads.GetElementValues(i, el_grads);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         for (int c = 0; c < vdim; c++)
+         {
+            const double v = x.GetValue(i, ip, c+1);
+            max_val_err = std::max(max_val_err, fabs(el_vals(c,q) - v));
+         }
+         x.GetVectorGradient(T, grad);
+         for (int d = 0; d < sdim; d++)
+         {
+            for (int c = 0; c < vdim; c++)
+            {
+               const double g = el_grads(c+vdim*d,q) - grad(c,d);
+               max_grad_err = std::max(max_grad_err, fabs(g));
+            }
+         }
+      }
+
+      // The element-wise methods must agree with the QuadratureFunction.
+      x.GetVectorValues(T, ir, ir_vals);
+      ir_vals -= el_vals;
+      max_val_err = std::max(max_val_err, ir_vals.MaxMaxNorm());
+      if (vdim == 1)
+      {
+         x.GetGradients(T, ir, ir_grads);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            for (int d = 0; d < sdim; d++)
+            {
+               const double g = ir_grads(d,q) - el_grads(d,q);
+               max_grad_err = std::max(max_grad_err, fabs(g));
+            }
+         }
+      }
+   }
+   REQUIRE(max_val_err < 1e-12*x.Normlinf());
+   REQUIRE(max_grad_err < 1e-10*x.Normlinf());
+}
+
+static void TestSpaces(Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   PerturbMesh(mesh);
+
+   SECTION("H1, vector")
+   {
+      H1_FECollection fec(3, dim);
+      FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+      GridFunction x(&fes);
+      x.Randomize(1);
+      CompareWithPointwise(x, 7);
+   }
+
+   SECTION("H1, positive basis")
+   {
+      H1_FECollection fec(2, dim, BasisType::Positive);
+      FiniteElementSpace fes(&mesh, &fec);
+      GridFunction x(&fes);
+      x.Randomize(2);
+      CompareWithPointwise(x, 4);
+   }
+
+   SECTION("L2, Gauss-Legendre")
+   {
+      L2_FECollection fec(2, dim, BasisType::GaussLegendre);
+      FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byNODES);
+      GridFunction x(&fes);
+      x.Randomize(3);
+      CompareWithPointwise(x, 5);
+   }
+}
+
+static double poly(const Vector &x)
+{
+   return 1.0 + x(0) - 2.0*x(1) + x(0)*x(1) + x(1)*x(1);
+}
+
+TEST_CASE("GridFunction quadrature evaluation", "[GridFunction]")
+{
+   SECTION("Quadrilateral mesh")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      TestSpaces(mesh);
+   }
+
+   SECTION("Triangle mesh")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true);
+      TestSpaces(mesh);
+   }
+
+   SECTION("Hexahedral mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      TestSpaces(mesh);
+   }
+
+   SECTION("Tensor rules with different points per direction")
+   {
+      Mesh mesh(2, 2, Element::QUADRILATERAL, true);
+      H1_FECollection fec(3, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      GridFunction x(&fes);
+      x.Randomize(4);
+
+      // Rules with the same number of points in both directions, evaluated
+      // alternately so that a stale 1D tabulation would be detected.
+      QuadratureFunctions1D quad_func;
+      IntegrationRule ir_x, ir_y;
+      quad_func.GaussLegendre(4, &ir_x);
+      quad_func.GaussLobatto(4, &ir_y);
+      IntegrationRule ir_xy(ir_x, ir_y), ir_xx(ir_x, ir_x);
+      const IntegrationRule *irs[3] = { &ir_xy, &ir_xx, &ir_xy };
+
+      double max_err = 0.0;
+      Vector vals;
+      for (int k = 0; k < 3; k++)
+      {
+         const IntegrationRule &ir = *irs[k];
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            x.GetValues(i, ir, vals);
+            for (int q = 0; q < ir.GetNPoints(); q++)
+            {
+               const double v = x.GetValue(i, ir.IntPoint(q));
+               max_err = std::max(max_err, fabs(vals(q) - v));
+            }
+         }
+      }
+      REQUIRE(max_err < 1e-12*x.Normlinf());
+   }
+
+   SECTION("L2 error of an exactly represented function")
+   {
+      Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      FunctionCoefficient coeff(poly);
+      GridFunction x(&fes);
+      x.ProjectCoefficient(coeff);
+      REQUIRE(x.ComputeL2Error(coeff) < 1e-12);
+      Coefficient *coeffs[1] = { &coeff };
+      REQUIRE(x.ComputeL2Error(coeffs) < 1e-12);
+   }
+}
+
+} // namespace gridfunc_quadrature
@@ -0,0 +1,93 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace hybridization
+{
+
+static void rhs_func(const Vector &x, Vector &f)
+{
+   f = 0.0;
+   f(0) = 1.0 + x(1)*x(1);
+   f(1) = sin(3.0*x(0));
+}
+
+enum HybridizationMode { NONE, DOUBLE, SINGLE };
+
+// Solve the H(div) problem (div u, div v) + (u, v) = (f, v), as in example 4,
+// with or without hybridization.
+static void Solve(FiniteElementSpace &fes, HybridizationMode mode,
+                  Vector &sol)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   VectorFunctionCoefficient f(dim, rhs_func);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(f));
+   b.Assemble();
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DivDivIntegrator(one));
+   a.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+
+   const int order = fes.GetFE(0)->GetOrder();
+   DG_Interface_FECollection hfec(order-1, dim);
+   FiniteElementSpace hfes(&mesh, &hfec);
+   if (mode != NONE)
+   {
+      a.EnableHybridization(&hfes, new NormalTraceJumpIntegrator(),
+                            ess_tdof_list);
+      a.GetHybridization()->SetSinglePrecisionFactors(mode == SINGLE);
+   }
+   a.Assemble();
+
+   GridFunction x(&fes);
+   x = 0.0;
+   SparseMatrix A;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   GSSmoother M(A);
+   PCG(A, M, B, X, 0, 2000, 1e-28, 0.0);
+   a.RecoverFEMSolution(X, b, x);
+   sol = x;
+}
+
+TEST_CASE("Hybridization", "[Hybridization]")
+{
+   Mesh mesh(4, 3, Element::QUADRILATERAL, true, 1.5, 1.0);
+   mesh.SetCurvature(2);
+   RT_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Vector sol, sol_h, sol_h_sp;
+   Solve(fes, NONE, sol);
+   Solve(fes, DOUBLE, sol_h);
+   Solve(fes, SINGLE, sol_h_sp);
+
+   const double norm = sol.Normlinf();
+   REQUIRE(norm > 0.0);
+   sol_h -= sol;
+   REQUIRE(sol_h.Normlinf() < 1e-10*norm);
+   sol_h_sp -= sol;
+   REQUIRE(sol_h_sp.Normlinf() < 1e-5*norm);
+}
+
+} // namespace hybridization
@@ -0,0 +1,222 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mfem;
+
+namespace nonlinearform
+{
+
+// Perturb the interior nodes of the mesh to get a non-trivial state.
+void PerturbState(const FiniteElementSpace &fes, const Array<int> &ess_vdofs,
+                  GridFunction &x)
+{
+   const int nd = fes.GetNDofs();
+   for (int i = 0; i < nd; i++)
+   {
+      const double X = x(i), Y = x(i+nd);
+      x(i) += 0.02*X;
+      if (!ess_vdofs[i+nd]) { x(i+nd) += 0.01*sin(X + Y); }
+   }
+}
+
+// Return the max norm of the difference between the actions of the assembled
+// and the matrix-free gradients of the hyperelastic form with the given model.
+double GradientActionError(HyperelasticModel &model)
+{
+   Mesh mesh(3, 2, Element::QUADRILATERAL, true, 3.0, 2.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2);
+   mesh.SetNodalFESpace(&fes);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[3] = 1;
+   Array<int> ess_vdofs;
+   fes.GetEssentialVDofs(ess_bdr, ess_vdofs);
+
+   GridFunction x(&fes);
+   mesh.GetNodes(x);
+   PerturbState(fes, ess_vdofs, x);
+
+   NonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+   nlf.SetEssentialBC(ess_bdr);
+
+   Vector v(x.Size()), y_assembled(x.Size()), y_mf(x.Size());
+   v.Randomize(1);
+
+   nlf.GetGradient(x).Mult(v, y_assembled);
+   nlf.UseMatrixFreeGradient();
+   nlf.GetGradient(x).Mult(v, y_mf);
+
+   y_mf -= y_assembled;
+   return y_mf.Normlinf()/y_assembled.Normlinf();
+}
+
+double ShearModulus(const Vector &x) { return 0.25 + 0.1*x(0)*x(1); }
+
+// Return the max norm of the difference between the gradient matrices of the
+// hyperelastic form assembled serially and with threads.
+double ThreadedGradientError(HyperelasticModel &model)
+{
+   Mesh mesh(6, 4, Element::QUADRILATERAL, true, 3.0, 2.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2);
+   mesh.SetNodalFESpace(&fes);
+
+   Array<int> ess_vdofs(fes.GetVSize());
+   ess_vdofs = 0;
+   GridFunction x(&fes);
+   mesh.GetNodes(x);
+   PerturbState(fes, ess_vdofs, x);
+
+   NonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+
+   SparseMatrix grad(dynamic_cast<SparseMatrix&>(nlf.GetGradient(x)));
+   nlf.UseThreadedGradient();
+   SparseMatrix &grad_t = dynamic_cast<SparseMatrix&>(nlf.GetGradient(x));
+
+   grad_t.Add(-1.0, grad);
+   return grad_t.MaxNorm()/grad.MaxNorm();
+}
+
+// Return the max relative difference between the energy, the residual and the
+// gradient matrix of a TMOP form computed serially and with threads; with
+// 'cache', the threaded evaluations also use the cached target matrices.
+double ThreadedTMOPError(bool cache)
+{
+   Mesh mesh(6, 4, Element::QUADRILATERAL, true, 3.0, 2.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2);
+   mesh.SetNodalFESpace(&fes);
+
+   Array<int> ess_vdofs(fes.GetVSize());
+   ess_vdofs = 0;
+   GridFunction x0(&fes), x(&fes);
+   mesh.GetNodes(x0);
+   x = x0;
+   PerturbState(fes, ess_vdofs, x);
+
+   TMOP_Metric_002 metric;
+   TargetConstructor target_c(TargetConstructor::GIVEN_SHAPE_AND_SIZE);
+   target_c.SetNodes(x0);
+   ConstantCoefficient lim_coeff(0.5);
+   TMOP_Integrator *integ = new TMOP_Integrator(&metric, &target_c);
+   integ->EnableLimiting(x0, lim_coeff);
+   NonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(integ);
+
+   NonlinearFormIntegrator *copy = integ->Clone();
+   REQUIRE(copy != NULL);
+   delete copy;
+
+   Vector y(x.Size()), y_t(x.Size());
+   const double energy = nlf.GetEnergy(x);
+   nlf.Mult(x, y);
+   SparseMatrix grad(dynamic_cast<SparseMatrix&>(nlf.GetGradient(x)));
+
+   if (cache)
+   {
+      target_c.EnableTargetCaching();
+      integ->PrecomputeTargets(fes);
+   }
+   nlf.UseThreadedMult();
+   nlf.UseThreadedGradient();
+   const double energy_t = nlf.GetEnergy(x);
+   nlf.Mult(x, y_t);
+   SparseMatrix &grad_t = dynamic_cast<SparseMatrix&>(nlf.GetGradient(x));
+
+   y_t -= y;
+   grad_t.Add(-1.0, grad);
+   return std::max(std::fabs(energy_t - energy)/std::fabs(energy),
+                   std::max(y_t.Normlinf()/y.Normlinf(),
+                            grad_t.MaxNorm()/grad.MaxNorm()));
+}
+
+}
+
+TEST_CASE("Matrix-free NonlinearForm gradient", "[NonlinearForm]")
+{
+   SECTION("Exact gradient action")
+   {
+      NeoHookeanModel model(0.25, 5.0);
+      REQUIRE(nonlinearform::GradientActionError(model) < 1e-12);
+   }
+
+   SECTION("Finite difference gradient action")
+   {
+      InverseHarmonicModel model;
+      REQUIRE(nonlinearform::GradientActionError(model) < 1e-6);
+   }
+
+   SECTION("Linear integrator")
+   {
+      Mesh mesh(4, 4, Element::TRIANGLE, true);
+      H1_FECollection fec(3, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+
+      Array<int> ess_bdr(mesh.bdr_attributes.Max());
+      ess_bdr = 1;
+
+      NonlinearForm nlf(&fes);
+      nlf.AddDomainIntegrator(new DiffusionIntegrator);
+      nlf.SetEssentialBC(ess_bdr);
+
+      Vector x(fes.GetVSize()), v(fes.GetVSize());
+      Vector y_assembled(fes.GetVSize()), y_mf(fes.GetVSize());
+      x.Randomize(1);
+      v.Randomize(2);
+
+      nlf.GetGradient(x).Mult(v, y_assembled);
+      nlf.UseMatrixFreeGradient();
+      nlf.GetGradient(x).Mult(v, y_mf);
+
+      y_mf -= y_assembled;
+      REQUIRE(y_mf.Normlinf() < 1e-12*y_assembled.Normlinf());
+   }
+}
+
+TEST_CASE("Threaded NonlinearForm gradient", "[NonlinearForm]")
+{
+   SECTION("Model with Coefficients")
+   {
+      FunctionCoefficient mu(nonlinearform::ShearModulus);
+      ConstantCoefficient K(5.0);
+      NeoHookeanModel model(mu, K);
+      REQUIRE(nonlinearform::ThreadedGradientError(model) < 1e-12);
+   }
+
+   SECTION("Model without Coefficients")
+   {
+      InverseHarmonicModel model;
+      REQUIRE(nonlinearform::ThreadedGradientError(model) < 1e-12);
+   }
+}
+
+TEST_CASE("Threaded TMOP evaluation", "[NonlinearForm]")
+{
+   SECTION("Targets computed on the fly")
+   {
+      REQUIRE(nonlinearform::ThreadedTMOPError(false) < 1e-12);
+   }
+
+   SECTION("Cached targets")
+   {
+      REQUIRE(nonlinearform::ThreadedTMOPError(true) < 1e-12);
+   }
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace staticcond
+{
+
+static double rhs_func(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) - sin(2.0*x(1));
+}
+
+static void rhs_vfunc(const Vector &x, Vector &f)
+{
+   f(0) = rhs_func(x);
+   f(1) = x(0) - x(1);
+}
+
+// Assemble and solve the mass + diffusion problem with homogeneous Dirichlet
+// boundary conditions, optionally with static condensation and with element
+// matrices computed in advance. Return the solution and the entries of the
+// system matrix.
+static void Solve(FiniteElementSpace &fes, bool static_cond,
+                  bool precompute, Vector &sol, Vector &A_data)
+{
+   Mesh &mesh = *fes.GetMesh();
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   const int vdim = fes.GetVDim();
+   FunctionCoefficient f(rhs_func);
+   VectorFunctionCoefficient vf(vdim, rhs_vfunc);
+   LinearForm b(&fes);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   if (vdim == 1)
+   {
+      b.AddDomainIntegrator(new DomainLFIntegrator(f));
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.AddDomainIntegrator(new MassIntegrator(one));
+   }
+   else
+   {
+      b.AddDomainIntegrator(new VectorDomainLFIntegrator(vf));
+      a.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+   }
+   b.Assemble();
+   if (static_cond) { a.EnableStaticCondensation(); }
+   if (precompute) { a.ComputeElementMatrices(); }
+   a.Assemble();
+
+   GridFunction x(&fes);
+   x = 0.0;
+   SparseMatrix A;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   GSSmoother M(A);
+   PCG(A, M, B, X, 0, 1000, 1e-28, 0.0);
+   a.RecoverFEMSolution(X, b, x);
+   sol = x;
+   A_data.SetSize(A.NumNonZeroElems());
+   A_data = A.GetData();
+}
+
+static void CompareWithFullSystem(FiniteElementSpace &fes)
+{
+   Vector sol, sol_sc, sol_sc_pre;
+   Vector A, A_sc, A_sc_pre;
+   Solve(fes, false, false, sol, A);
+   Solve(fes, true, false, sol_sc, A_sc);
+   Solve(fes, true, true, sol_sc_pre, A_sc_pre);
+
+   // The reduced system is smaller than the full one.
+   REQUIRE(A_sc.Size() < A.Size());
+
+   // Both assembly paths add the element Schur complements in element order.
+   REQUIRE(A_sc_pre.Size() == A_sc.Size());
+   A_sc_pre -= A_sc;
+   REQUIRE(A_sc_pre.Normlinf() == 0.0);
+
+   const double tol = 1e-10*sol.Normlinf();
+   sol_sc -= sol;
+   REQUIRE(sol_sc.Normlinf() < tol);
+   sol_sc_pre -= sol;
+   REQUIRE(sol_sc_pre.Normlinf() < tol);
+}
+
+TEST_CASE("Static condensation", "[StaticCondensation]")
+{
+   SECTION("Quadrilateral mesh, scalar")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      mesh.SetCurvature(2);
+      H1_FECollection fec(4, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      CompareWithFullSystem(fes);
+   }
+
+   SECTION("Triangle mesh, vector")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true);
+      H1_FECollection fec(3, 2);
+      FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+      CompareWithFullSystem(fes);
+   }
+
+   SECTION("Hexahedral mesh, scalar")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      H1_FECollection fec(3, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      CompareWithFullSystem(fes);
+   }
+}
+
+} // namespace staticcond
@@ -0,0 +1,195 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem-performance.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace tbilinearform
+{
+
+// Curve the mesh with a smooth perturbation of its vertices.
+static void PerturbMesh(Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   mesh.SetCurvature(1, false, -1, Ordering::byNODES);
+   GridFunction &nodes = *mesh.GetNodes();
+   const int nv = nodes.Size()/dim;
+   Vector x(dim);
+   for (int i = 0; i < nv; i++)
+   {
+      for (int d = 0; d < dim; d++) { x(d) = nodes(i + d*nv); }
+      for (int d = 0; d < dim; d++)
+      {
+         nodes(i + d*nv) += 0.05*sin(3.0*x((d+1)%dim) + d)*x(d)*(1.0-x(d));
+      }
+   }
+}
+
+// Compare the matrix-free, the partially assembled and the element-vectorized
+// actions of a_t with the action of the assembled BilinearForm a.
+template <typename form_t>
+static void CompareMult(form_t &a_t, BilinearForm &a)
+{
+   const int n = a.Size();
+   REQUIRE(a_t.Height() == n);
+   Vector x(n), y(n), y_t(n);
+   x.Randomize(1);
+   a.Mult(x, y);
+   const double tol = 1e-12*y.Normlinf();
+
+   a_t.Mult(x, y_t);
+   y_t -= y;
+   REQUIRE(y_t.Normlinf() <= tol);
+
+   a_t.Assemble();
+   a_t.Mult(x, y_t);
+   y_t -= y;
+   REQUIRE(y_t.Normlinf() <= tol);
+
+   // UseElementVectorization() takes effect in the next Assemble()
+   a_t.UseElementVectorization();
+   a_t.Assemble();
+   a_t.Mult(x, y_t);
+   y_t -= y;
+   REQUIRE(y_t.Normlinf() <= tol);
+
+   a_t.UseElementVectorization(false);
+   a_t.Assemble();
+   a_t.Mult(x, y_t);
+   y_t -= y;
+   REQUIRE(y_t.Normlinf() <= tol);
+}
+
+template <Geometry::Type geom>
+static void TestVectorKernels(Mesh &mesh)
+{
+   typedef H1_FiniteElement<geom,1>              mesh_fe_t;
+   typedef TMesh<H1_FiniteElementSpace<mesh_fe_t> > mesh_t;
+   typedef TIntegrationRule<geom,6>              int_rule_t;
+   typedef TConstantCoefficient<>                coeff_t;
+
+   const int dim = mesh.Dimension();
+   const IntegrationRule &ir = int_rule_t::GetIntRule();
+   PerturbMesh(mesh);
+   REQUIRE(mesh_t::MatchesGeometry(mesh));
+   REQUIRE(mesh_t::MatchesNodes(mesh));
+
+   SECTION("H(curl)")
+   {
+      typedef ND_FiniteElementSpace<ND_FiniteElement<geom,2> > fes_t;
+      ND_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      REQUIRE(fes_t::Matches(fes));
+
+      ConstantCoefficient one(1.0), coeff(2.5);
+      BilinearForm a(&fes);
+
+      SECTION("Mass")
+      {
+         BilinearFormIntegrator *integ = new VectorFEMassIntegrator(one);
+         integ->SetIntRule(&ir);
+         a.AddDomainIntegrator(integ);
+         a.Assemble();
+         typedef TIntegrator<coeff_t,THCurlMassKernel> integ_t;
+         TBilinearForm<mesh_t,fes_t,int_rule_t,integ_t> a_t(
+            integ_t(coeff_t(1.0)), fes);
+         CompareMult(a_t, a);
+      }
+      SECTION("Curl-curl")
+      {
+         BilinearFormIntegrator *integ = new CurlCurlIntegrator(coeff);
+         integ->SetIntRule(&ir);
+         a.AddDomainIntegrator(integ);
+         a.Assemble();
+         typedef TIntegrator<coeff_t,TCurlCurlKernel> integ_t;
+         TBilinearForm<mesh_t,fes_t,int_rule_t,integ_t> a_t(
+            integ_t(coeff_t(2.5)), fes);
+         CompareMult(a_t, a);
+      }
+   }
+
+   SECTION("H(div)")
+   {
+      typedef RT_FiniteElementSpace<RT_FiniteElement<geom,1> > fes_t;
+      RT_FECollection fec(1, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      REQUIRE(fes_t::Matches(fes));
+
+      ConstantCoefficient one(1.0), coeff(2.5);
+      BilinearForm a(&fes);
+
+      SECTION("Mass")
+      {
+         BilinearFormIntegrator *integ = new VectorFEMassIntegrator(one);
+         integ->SetIntRule(&ir);
+         a.AddDomainIntegrator(integ);
+         a.Assemble();
+         typedef TIntegrator<coeff_t,THDivMassKernel> integ_t;
+         TBilinearForm<mesh_t,fes_t,int_rule_t,integ_t> a_t(
+            integ_t(coeff_t(1.0)), fes);
+         CompareMult(a_t, a);
+      }
+      SECTION("Div-div")
+      {
+         BilinearFormIntegrator *integ = new DivDivIntegrator(coeff);
+         integ->SetIntRule(&ir);
+         a.AddDomainIntegrator(integ);
+         a.Assemble();
+         typedef TIntegrator<coeff_t,TDivDivKernel> integ_t;
+         TBilinearForm<mesh_t,fes_t,int_rule_t,integ_t> a_t(
+            integ_t(coeff_t(2.5)), fes);
+         CompareMult(a_t, a);
+      }
+   }
+
+   SECTION("Elasticity")
+   {
+      const int vdim = mesh_fe_t::dim;
+      typedef H1_FiniteElementSpace<H1_FiniteElement<geom,2> > fes_t;
+      typedef VectorLayout<Ordering::byNODES,vdim> vec_layout_t;
+      typedef TCoefficientPair<coeff_t,coeff_t> lame_t;
+      typedef TIntegrator<lame_t,TElasticityKernel> integ_t;
+
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec, dim, Ordering::byNODES);
+      REQUIRE(fes_t::template VectorMatches<vec_layout_t>(fes));
+
+      ConstantCoefficient lambda(2.0), mu(0.5);
+      BilinearForm a(&fes);
+      BilinearFormIntegrator *elast = new ElasticityIntegrator(lambda, mu);
+      elast->SetIntRule(&ir);
+      a.AddDomainIntegrator(elast);
+      a.Assemble();
+
+      TBilinearForm<mesh_t,fes_t,int_rule_t,integ_t,vec_layout_t> a_t(
+         integ_t(lame_t(coeff_t(2.0), coeff_t(0.5))), fes);
+      CompareMult(a_t, a);
+   }
+}
+
+TEST_CASE("TBilinearForm vector kernels", "[TBilinearForm]")
+{
+   SECTION("Quadrilateral mesh")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      TestVectorKernels<Geometry::SQUARE>(mesh);
+   }
+
+   SECTION("Hexahedral mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      TestVectorKernels<Geometry::CUBE>(mesh);
+   }
+}
+
+} // namespace tbilinearform
@@ -0,0 +1,96 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem-performance.hpp"
+#include "fem/tregistry.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace tregistry
+{
+
+static double MultDifference(const Operator &op, BilinearForm &a)
+{
+   Vector x(a.Size()), y(a.Size()), y_op(a.Size());
+   x.Randomize(1);
+   a.Mult(x, y);
+   op.Mult(x, y_op);
+   y_op -= y;
+   return y_op.Normlinf()/y.Normlinf();
+}
+
+TEST_CASE("TBilinearFormRegistry", "[TBilinearForm]")
+{
+   typedef TBilinearFormRegistry Registry;
+
+   Registry registry;
+   // Quadratic elements on quadrilaterals with linear mesh nodes, using the
+   // default quadrature order 2*2+2-1 = 5.
+   registry.Register<Registry::Diffusion,Geometry::SQUARE,1,2,5>();
+   REQUIRE(registry.Size() == 1);
+
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   SECTION("Mesh without nodes")
+   {
+      REQUIRE(registry.Create(Registry::Diffusion, 1.0, fes) == NULL);
+   }
+
+   mesh.SetCurvature(1, false, -1, Ordering::byNODES);
+
+   SECTION("Registered form")
+   {
+      BilinearForm a(&fes);
+      BilinearFormIntegrator *integ = new DiffusionIntegrator;
+      integ->SetIntRule(&IntRules.Get(Geometry::SQUARE, 5));
+      a.AddDomainIntegrator(integ);
+      a.Assemble();
+
+      Operator *op = registry.Create(Registry::Diffusion, 1.0, fes);
+      REQUIRE(op != NULL);
+      REQUIRE(MultDifference(*op, a) < 1e-12);
+      delete op;
+
+      // Orders 4 and 5 give the same tensor-product rule
+      op = registry.Create(Registry::Diffusion, 1.0, fes, 4);
+      REQUIRE(op != NULL);
+      REQUIRE(MultDifference(*op, a) < 1e-12);
+      delete op;
+
+      REQUIRE(registry.Create(Registry::Diffusion, 1.0, fes, 7) == NULL);
+   }
+
+   SECTION("Fallback")
+   {
+      REQUIRE(registry.Create(Registry::Mass, 2.0, fes) == NULL);
+
+      ConstantCoefficient two(2.0);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new MassIntegrator(two));
+      a.Assemble();
+
+      bool templated = true;
+      Operator *op =
+         registry.CreateOrFallback(Registry::Mass, 2.0, fes, -1, &templated);
+      REQUIRE(!templated);
+      REQUIRE(MultDifference(*op, a) < 1e-12);
+      delete op;
+
+      H1_FECollection fec3(3, 2);
+      FiniteElementSpace fes3(&mesh, &fec3);
+      REQUIRE(registry.Create(Registry::Diffusion, 1.0, fes3) == NULL);
+   }
+}
+
+} // namespace tregistry
@@ -0,0 +1,86 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace mfem;
+
+static void ProfiledSolve()
+{
+   MFEM_PROFILE_REGION("solve");
+
+   Mesh mesh(4, 4, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+
+   Vector b(fes.GetVSize()), x(fes.GetVSize());
+   b = 1.0;
+   x = 0.0;
+   CG(a.SpMat(), b, x, -1, 100, 1e-12, 0.0);
+}
+
+static int Count(const std::string &s, const std::string &sub)
+{
+   int n = 0;
+   for (size_t pos = s.find(sub); pos != std::string::npos;
+        pos = s.find(sub, pos + 1)) { n++; }
+   return n;
+}
+
+TEST_CASE("Profiler", "[General]")
+{
+   Profiler::Reset();
+
+   SECTION("Disabled")
+   {
+      REQUIRE(!Profiler::IsEnabled());
+      ProfiledSolve();
+
+      std::ostringstream json;
+      Profiler::PrintJSON(json);
+      REQUIRE(Count(json.str(), "\"name\"") == 0);
+   }
+
+   SECTION("Nested regions")
+   {
+      Profiler::Enable();
+      ProfiledSolve();
+      ProfiledSolve();
+      Profiler::Enable(false);
+      ProfiledSolve();
+
+      std::ostringstream json;
+      Profiler::PrintJSON(json);
+      const std::string s = json.str();
+      REQUIRE(Count(s, "{ \"name\": \"solve\", \"calls\": 2,") == 1);
+      REQUIRE(Count(s, "\"BilinearForm::Assemble\", \"calls\": 2,") == 1);
+      REQUIRE(Count(s, "\"CGSolver::Mult\", \"calls\": 2,") == 1);
+      // Both library regions are children of "solve".
+      REQUIRE(Count(s, "\"name\"") == 3);
+      REQUIRE(s.find("solve") < s.find("BilinearForm::Assemble"));
+
+      std::ostringstream table;
+      Profiler::Print(table);
+      REQUIRE(Count(table.str(), "\n  CGSolver::Mult") == 1);
+
+      Profiler::Reset();
+      std::ostringstream empty;
+      Profiler::PrintJSON(empty);
+      REQUIRE(Count(empty.str(), "\"name\"") == 0);
+   }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace table
+{
+
+static bool SameTables(const Table &A, const Table &B)
+{
+   if (A.Size() != B.Size() ||
+       A.Size_of_connections() != B.Size_of_connections())
+   {
+      return false;
+   }
+   for (int i = 0; i <= A.Size(); i++)
+   {
+      if (A.GetI()[i] != B.GetI()[i]) { return false; }
+   }
+   for (int i = 0; i < A.Size_of_connections(); i++)
+   {
+      if (A.GetJ()[i] != B.GetJ()[i]) { return false; }
+   }
+   return true;
+}
+
+// Reference transpose with Table::MakeI/MakeJ
+static void RefTranspose(const Table &A, Table &At, int ncols)
+{
+   At.MakeI(ncols);
+   for (int i = 0; i < A.Size_of_connections(); i++)
+   {
+      At.AddAColumnInRow(A.GetJ()[i]);
+   }
+   At.MakeJ();
+   for (int i = 0; i < A.Size(); i++)
+   {
+      for (int j = A.GetI()[i]; j < A.GetI()[i+1]; j++)
+      {
+         At.AddConnection(A.GetJ()[j], i);
+      }
+   }
+   At.ShiftUpI();
+}
+
+// Reference product, with the columns of each row in the order of their first
+// appearance in the rows of B, as in Mult()
+static void RefMult(const Table &A, const Table &B, Table &C)
+{
+   Array<int> marker(B.Width()), cols;
+   marker = -1;
+   C.MakeI(A.Size());
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int i = 0; i < A.Size(); i++)
+      {
+         for (int j = A.GetI()[i]; j < A.GetI()[i+1]; j++)
+         {
+            B.GetRow(A.GetJ()[j], cols);
+            for (int l = 0; l < cols.Size(); l++)
+            {
+               if (marker[cols[l]] == 2*i + pass) { continue; }
+               marker[cols[l]] = 2*i + pass;
+               if (pass == 0) { C.AddAColumnInRow(i); }
+               else { C.AddConnection(i, cols[l]); }
+            }
+         }
+      }
+      if (pass == 0) { C.MakeJ(); }
+   }
+   C.ShiftUpI();
+}
+
+TEST_CASE("Table transpose and product", "[Table]")
+{
+   // The element-to-dof table is large enough to use the threaded versions
+   // with MFEM_USE_OPENMP
+   Mesh mesh(12, 12, 12, Element::HEXAHEDRON);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   const Table &el_dof = fes.GetElementToDofTable();
+   REQUIRE(el_dof.Size_of_connections() > 40000);
+
+   Table dof_el, dof_el_ref;
+   Transpose(el_dof, dof_el, fes.GetNDofs());
+   RefTranspose(el_dof, dof_el_ref, fes.GetNDofs());
+   REQUIRE(SameTables(dof_el, dof_el_ref));
+
+   Table dof_dof, dof_dof_ref;
+   Mult(dof_el, el_dof, dof_dof);
+   RefMult(dof_el, el_dof, dof_dof_ref);
+   REQUIRE(SameTables(dof_dof, dof_dof_ref));
+
+   // A table below the size threshold
+   Table *face_el = mesh.GetFaceToElementTable();
+   Table *el_face = Transpose(*face_el);
+   Table el_face_ref;
+   RefTranspose(*face_el, el_face_ref, mesh.GetNE());
+   REQUIRE(SameTables(*el_face, el_face_ref));
+   delete el_face;
+   delete face_el;
+}
+
+} // namespace table
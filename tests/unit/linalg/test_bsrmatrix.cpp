@@ -0,0 +1,177 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace bsrmatrix
+{
+
+// Compare the entries of a SparseMatrix and a BSRMatrix.
+static double MaxDifference(const SparseMatrix &S, const BSRMatrix &B)
+{
+   SparseMatrix *S_b = B.ToSparseMatrix();
+   SparseMatrix *D = Add(1.0, S, -1.0, *S_b);
+   const double diff = D->MaxNorm();
+   delete D;
+   delete S_b;
+   return diff;
+}
+
+TEST_CASE("BSRMatrix", "[BSRMatrix]")
+{
+   Mesh mesh(3, 3, 2, Element::HEXAHEDRON, true);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, Ordering::byVDIM);
+
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   // keep the symmetric sparsity for SparseMatrix::EliminateRowCol()
+   a.Assemble(0);
+   a.Finalize(0);
+   const SparseMatrix &S = a.SpMat();
+   const double norm = S.MaxNorm();
+
+   BSRMatrix *B = a.AssembleBSR();
+   BSRMatrix B_s(S, dim);
+   REQUIRE(B->GetBlockSize() == dim);
+   REQUIRE(B->Height() == S.Height());
+   REQUIRE(B->NumBlocks() == B_s.NumBlocks());
+   REQUIRE(MaxDifference(S, *B) < 1e-12*norm);
+   REQUIRE(MaxDifference(S, B_s) == 0.0);
+
+   SECTION("Products")
+   {
+      Vector x(S.Width()), y(S.Height()), y_b(S.Height());
+      x.Randomize(1);
+      S.Mult(x, y);
+      B->Mult(x, y_b);
+      y_b -= y;
+      REQUIRE(y_b.Normlinf() < 1e-12*y.Normlinf());
+
+      S.MultTranspose(x, y);
+      B->MultTranspose(x, y_b);
+      y_b -= y;
+      REQUIRE(y_b.Normlinf() < 1e-12*y.Normlinf());
+
+      // Scalar blocks
+      H1_FECollection fec1(2, dim);
+      FiniteElementSpace fes1(&mesh, &fec1);
+      BilinearForm a1(&fes1);
+      a1.AddDomainIntegrator(new DiffusionIntegrator(lambda));
+      a1.Assemble();
+      a1.Finalize();
+      BSRMatrix *B1 = a1.AssembleBSR();
+      REQUIRE(MaxDifference(a1.SpMat(), *B1) < 1e-12*a1.SpMat().MaxNorm());
+      delete B1;
+   }
+
+   SECTION("Elimination and smoothers")
+   {
+      Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_dofs;
+      ess_bdr = 0;
+      ess_bdr[0] = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+
+      Vector sol(S.Height()), b(S.Height()), b_b;
+      sol.Randomize(2);
+      b.Randomize(3);
+      b_b = b;
+
+      SparseMatrix S_e(S);
+      for (int i = 0; i < ess_dofs.Size(); i++)
+      {
+         S_e.EliminateRowCol(ess_dofs[i], sol(ess_dofs[i]), b);
+      }
+      B->EliminateRowsCols(ess_dofs, sol, b_b);
+      REQUIRE(MaxDifference(S_e, *B) < 1e-12*norm);
+      b_b -= b;
+      REQUIRE(b_b.Normlinf() < 1e-12*b.Normlinf());
+
+      for (int type = 0; type <= 3; type++)
+      {
+         // The forward and backward smoothers are not symmetric, use GMRES
+         // with them.
+         BSRSmoother M(*B, type, type == 3 ? 0.5 : 1.0);
+         CGSolver cg;
+         GMRESSolver gmres;
+         IterativeSolver &solver = (type == 1 || type == 2) ?
+                                   (IterativeSolver &) gmres :
+                                   (IterativeSolver &) cg;
+         solver.SetOperator(*B);
+         solver.SetPreconditioner(M);
+         solver.SetRelTol(1e-10);
+         solver.SetMaxIter(1000);
+         Vector x(S.Width()), r(S.Height());
+         x = 0.0;
+         solver.Mult(b, x);
+         REQUIRE(solver.GetConverged());
+         B->Mult(x, r);
+         r -= b;
+         REQUIRE(r.Norml2() < 1e-8*b.Norml2());
+      }
+   }
+
+#ifdef MFEM_USE_MPI
+   SECTION("Conversion to HypreParMatrix")
+   {
+      // The local matrices form the diagonal blocks of the parallel matrix.
+      MPI_Comm comm = MPI_COMM_WORLD;
+      int myid, num_procs;
+      MPI_Comm_rank(comm, &myid);
+      MPI_Comm_size(comm, &num_procs);
+
+      HYPRE_Int loc_size = B->Height(), offset, glob_size;
+      MPI_Scan(&loc_size, &offset, 1, HYPRE_MPI_INT, MPI_SUM, comm);
+      offset -= loc_size;
+      MPI_Allreduce(&loc_size, &glob_size, 1, HYPRE_MPI_INT, MPI_SUM, comm);
+      Array<HYPRE_Int> row_starts;
+      if (HYPRE_AssumedPartitionCheck())
+      {
+         row_starts.SetSize(3);
+         row_starts[0] = offset;
+         row_starts[1] = offset + loc_size;
+         row_starts[2] = glob_size;
+      }
+      else
+      {
+         row_starts.SetSize(num_procs + 1);
+         row_starts[0] = 0;
+         MPI_Allgather(&loc_size, 1, HYPRE_MPI_INT, row_starts.GetData() + 1,
+                       1, HYPRE_MPI_INT, comm);
+         for (int p = 0; p < num_procs; p++)
+         {
+            row_starts[p+1] += row_starts[p];
+         }
+      }
+
+      HypreParMatrix *H = B->ToHypreParMatrix(comm, glob_size, row_starts);
+      REQUIRE(H->Height() == B->Height());
+
+      Vector x(B->Width()), y(B->Height()), y_h(B->Height());
+      x.Randomize(4 + myid);
+      B->Mult(x, y);
+      H->Mult(x, y_h);
+      y_h -= y;
+      REQUIRE(y_h.Normlinf() < 1e-12*y.Normlinf());
+
+      delete H;
+   }
+#endif
+
+   delete B;
+}
+
+} // namespace bsrmatrix
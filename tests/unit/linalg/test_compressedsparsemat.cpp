@@ -0,0 +1,96 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace compressedsparsemat
+{
+
+// Compare the products with a CompressedSparseMatrix and the original matrix.
+static void CompareProducts(const SparseMatrix &S)
+{
+   CompressedSparseMatrix C(S);
+   REQUIRE(C.NumNonZeroElems() == S.NumNonZeroElems());
+
+   Vector x(S.Width()), y(S.Height()), y_c(S.Height());
+   x.Randomize(1);
+   S.Mult(x, y);
+   C.Mult(x, y_c);
+   y_c -= y;
+   REQUIRE(y_c.Normlinf() <= 1e-14*y.Normlinf());
+
+   Vector xt(S.Height()), yt(S.Width()), yt_c(S.Width());
+   xt.Randomize(2);
+   S.MultTranspose(xt, yt);
+   C.MultTranspose(xt, yt_c);
+   yt_c -= yt;
+   REQUIRE(yt_c.Normlinf() <= 1e-14*yt.Normlinf());
+
+   // The decompressed matrix has the same entries.
+   SparseMatrix *S_c = C.ToSparseMatrix();
+   int num_diff = 0;
+   for (int i = 0; i < S.Height(); i++)
+   {
+      num_diff += (S_c->RowSize(i) != S.RowSize(i));
+      for (int j = 0; j < S.RowSize(i); j++)
+      {
+         const int col = S.GetRowColumns(i)[j];
+         num_diff += ((*S_c)(i, col) != S.GetRowEntries(i)[j]);
+      }
+   }
+   REQUIRE(num_diff == 0);
+   delete S_c;
+}
+
+TEST_CASE("CompressedSparseMatrix", "[CompressedSparseMatrix]")
+{
+   SECTION("Finite element matrix")
+   {
+      Mesh mesh(4, 4, 4, Element::HEXAHEDRON, true);
+      H1_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      ConstantCoefficient one(1.0);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      a.Finalize();
+      const SparseMatrix &S = a.SpMat();
+      CompareProducts(S);
+
+      // The indices take less than 60% of the memory of the CSR indices.
+      CompressedSparseMatrix C(S);
+      const long csr_bytes = sizeof(int)*(S.Height() + 1 +
+                                          S.NumNonZeroElems());
+      REQUIRE(C.IndexMemoryUsage() < 0.6*csr_bytes);
+   }
+
+   SECTION("Matrix with wide rows")
+   {
+      // The column differences exceed 16 bits, so they are escaped.
+      const int n = 20, m = 300000;
+      SparseMatrix S(n, m);
+      for (int i = 0; i < n; i++)
+      {
+         S.Add(i, (i*7919) % m, 1.0 + i);
+         S.Add(i, m - 1 - i, -2.0);
+         S.Add(i, 70000 + 3*i, 0.5);
+         S.Add(i, 70001 + 3*i, 0.25);
+         S.Add(i, i, 4.0);
+      }
+      S.Finalize();
+      CompareProducts(S);
+   }
+}
+
+} // namespace compressedsparsemat
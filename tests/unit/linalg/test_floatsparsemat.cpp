@@ -0,0 +1,129 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace floatsparsemat
+{
+
+// Assemble the diffusion + mass matrix of a scalar H1 space.
+static SparseMatrix *DiffusionMatrix(FiniteElementSpace &fes)
+{
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   return a.LoseMat();
+}
+
+TEST_CASE("FloatSparseMatrix", "[FloatSparseMatrix]")
+{
+   Mesh mesh(6, 6, Element::QUADRILATERAL, true);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   SparseMatrix *A = DiffusionMatrix(fes);
+   const int n = A->Height();
+   FloatSparseMatrix A_sp(*A);
+
+   Vector x(n), y(n), y_sp(n);
+   x.Randomize(1);
+
+   SECTION("Products")
+   {
+      A->Mult(x, y);
+      A_sp.Mult(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() < 1e-6*y.Normlinf());
+
+      A->MultTranspose(x, y);
+      A_sp.MultTranspose(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() < 1e-6*y.Normlinf());
+
+      Vector d, d_sp;
+      A->GetDiag(d);
+      A_sp.GetDiag(d_sp);
+      d_sp -= d;
+      REQUIRE(d_sp.Normlinf() < 1e-6*d.Normlinf());
+
+      FloatSparseMatrix A_shared(*A, true);
+      REQUIRE(A_shared.GetJ() == A->GetJ());
+      A_shared.Mult(x, y);
+      A_sp.Mult(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() == 0.0);
+   }
+
+   SECTION("Smoothers")
+   {
+      GSSmoother gs(*A);
+      FloatGSSmoother gs_sp(A_sp);
+      gs.Mult(x, y);
+      gs_sp.Mult(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() < 1e-5*y.Normlinf());
+
+      DSmoother l1(*A, 1, 1.0, 3);
+      FloatDSmoother l1_sp(*A, 1, 1.0, 3);
+      l1.Mult(x, y);
+      l1_sp.Mult(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() < 1e-5*y.Normlinf());
+   }
+
+   SECTION("Mixed precision solvers")
+   {
+      Vector b(n), sol(n), r(n);
+      b.Randomize(2);
+      const double tol = 1e-12;
+
+      // Double precision FGMRES with a single precision preconditioner
+      FloatGSSmoother M(A_sp);
+      FGMRESSolver fgmres;
+      fgmres.SetOperator(*A);
+      fgmres.SetPreconditioner(M);
+      fgmres.SetRelTol(tol);
+      fgmres.SetMaxIter(500);
+      sol = 0.0;
+      fgmres.Mult(b, sol);
+      REQUIRE(fgmres.GetConverged());
+      A->Mult(sol, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 100*tol*b.Norml2());
+
+      // Iterative refinement with a single precision inner CG solve
+      CGSolver cg;
+      cg.SetOperator(A_sp);
+      cg.SetPreconditioner(M);
+      cg.SetRelTol(1e-4);
+      cg.SetMaxIter(200);
+      SLISolver refinement;
+      refinement.SetOperator(*A);
+      refinement.SetPreconditioner(cg);
+      refinement.SetRelTol(tol);
+      refinement.SetMaxIter(20);
+      sol = 0.0;
+      refinement.Mult(b, sol);
+      REQUIRE(refinement.GetConverged());
+      A->Mult(sol, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 100*tol*b.Norml2());
+   }
+
+   delete A;
+}
+
+} // namespace floatsparsemat
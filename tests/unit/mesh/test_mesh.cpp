@@ -13,6 +13,11 @@
 using namespace mfem;
 
 #include "catch.hpp"
+#include <sstream>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 #ifdef MFEM_USE_GECKO
 
@@ -95,3 +100,464 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
 }
 
 #endif
+
+// Average of the element vertices
+static void ElementCenter(Mesh &mesh, int i, Vector &c)
+{
+   Array<int> v;
+   mesh.GetElementVertices(i, v);
+   c.SetSize(mesh.SpaceDimension());
+   c = 0.0;
+   for (int j = 0; j < v.Size(); j++)
+   {
+      for (int d = 0; d < c.Size(); d++)
+      {
+         c(d) += mesh.GetVertex(v[j])[d]/v.Size();
+      }
+   }
+}
+
+// Check that the ordering is a permutation and return the maximum distance
+// between the centers of consecutive elements in the new order.
+static double CheckSFCOrdering(Mesh &mesh, const Array<int> &ordering)
+{
+   const int NE = mesh.GetNE();
+   REQUIRE(ordering.Size() == NE);
+   Array<int> inverse(NE);
+   inverse = -1;
+   for (int i = 0; i < NE; i++)
+   {
+      REQUIRE((ordering[i] >= 0 && ordering[i] < NE));
+      inverse[ordering[i]] = i;
+   }
+   REQUIRE(inverse.Min() == 0);
+
+   double max_dist = 0.0;
+   Vector c0, c1;
+   for (int k = 1; k < NE; k++)
+   {
+      ElementCenter(mesh, inverse[k-1], c0);
+      ElementCenter(mesh, inverse[k], c1);
+      max_dist = std::max(max_dist, c0.DistanceTo(c1.GetData()));
+   }
+   return max_dist;
+}
+
+TEST_CASE("Space-filling curve element ordering", "[Mesh]")
+{
+   Array<int> ordering;
+
+   SECTION("Quadrilateral mesh")
+   {
+      // On a 2^k x 2^k grid the Hilbert curve only moves between neighbors.
+      const int n = 16;
+      Mesh mesh(n, n, Element::QUADRILATERAL);
+      mesh.GetHilbertElementOrdering(ordering);
+      REQUIRE(CheckSFCOrdering(mesh, ordering) == Approx(1.0/n));
+      mesh.GetMortonElementOrdering(ordering);
+      REQUIRE(CheckSFCOrdering(mesh, ordering) > 1.0/n);
+   }
+
+   SECTION("Hexahedral mesh")
+   {
+      const int n = 8;
+      Mesh mesh(n, n, n, Element::HEXAHEDRON);
+      mesh.GetHilbertElementOrdering(ordering);
+      REQUIRE(CheckSFCOrdering(mesh, ordering) == Approx(1.0/n));
+      mesh.GetMortonElementOrdering(ordering);
+      CheckSFCOrdering(mesh, ordering);
+   }
+
+   SECTION("Reordered tetrahedral mesh")
+   {
+      Mesh mesh(3, 4, 5, Element::TETRAHEDRON);
+      mesh.GetHilbertElementOrdering(ordering);
+      CheckSFCOrdering(mesh, ordering);
+
+      Vector c0, c1;
+      ElementCenter(mesh, 0, c0);
+      const double volume = mesh.GetElementVolume(0);
+      mesh.ReorderElements(ordering);
+      ElementCenter(mesh, ordering[0], c1);
+      REQUIRE(c0.DistanceTo(c1.GetData()) < 1e-12);
+      REQUIRE(mesh.GetElementVolume(ordering[0]) == Approx(volume));
+   }
+}
+
+// Compare the edge and face numbering of the mesh with the numbering given by
+// the DSTable and STable3D classes, in the order of the element loop.
+static void CheckTopology(Mesh &mesh)
+{
+   Array<int> v, e, o;
+
+   DSTable v_to_v(mesh.GetNV());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementVertices(i, v);
+      const Element *el = mesh.GetElement(i);
+      for (int j = 0; j < el->GetNEdges(); j++)
+      {
+         const int *ev = el->GetEdgeVertices(j);
+         v_to_v.Push(v[ev[0]], v[ev[1]]);
+      }
+   }
+   REQUIRE(mesh.GetNEdges() == v_to_v.NumberOfEntries());
+
+   int num_diff = 0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementVertices(i, v);
+      mesh.GetElementEdges(i, e, o);
+      const Element *el = mesh.GetElement(i);
+      for (int j = 0; j < el->GetNEdges(); j++)
+      {
+         const int *ev = el->GetEdgeVertices(j);
+         num_diff += (e[j] != v_to_v(v[ev[0]], v[ev[1]]));
+      }
+   }
+   for (int i = 0; i < mesh.GetNEdges(); i++)
+   {
+      mesh.GetEdgeVertices(i, v);
+      num_diff += (v[0] >= v[1] || v_to_v(v[0], v[1]) != i);
+   }
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      mesh.GetBdrElementVertices(i, v);
+      if (mesh.Dimension() == 2)
+      {
+         num_diff += (mesh.GetBdrElementEdgeIndex(i) != v_to_v(v[0], v[1]));
+      }
+      else
+      {
+         mesh.GetBdrElementEdges(i, e, o);
+         const Element *el = mesh.GetBdrElement(i);
+         for (int j = 0; j < el->GetNEdges(); j++)
+         {
+            const int *ev = el->GetEdgeVertices(j);
+            num_diff += (e[j] != v_to_v(v[ev[0]], v[ev[1]]));
+         }
+      }
+   }
+   REQUIRE(num_diff == 0);
+
+   if (mesh.Dimension() < 3) { return; }
+
+   STable3D faces(mesh.GetNV());
+   Array<int> f;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementVertices(i, v);
+      mesh.GetElementFaces(i, f, o);
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(i);
+      for (int j = 0; j < f.Size(); j++)
+      {
+         const int *fv =
+            (geom == Geometry::TETRAHEDRON) ?
+            Geometry::Constants<Geometry::TETRAHEDRON>::FaceVert[j] :
+            (geom == Geometry::PRISM) ?
+            Geometry::Constants<Geometry::PRISM>::FaceVert[j] :
+            Geometry::Constants<Geometry::CUBE>::FaceVert[j];
+         const bool quad = (geom == Geometry::CUBE ||
+                            (geom == Geometry::PRISM && j >= 2));
+         const int fn =
+            quad ? faces.Push4(v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]]) :
+            faces.Push(v[fv[0]], v[fv[1]], v[fv[2]]);
+         num_diff += (f[j] != fn);
+      }
+   }
+   REQUIRE(mesh.GetNFaces() == faces.NumberOfElements());
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      mesh.GetBdrElementVertices(i, v);
+      const int fn = (v.Size() == 4) ? faces(v[0], v[1], v[2], v[3]) :
+                     faces(v[0], v[1], v[2]);
+      num_diff += (mesh.GetBdrElementEdgeIndex(i) != fn);
+   }
+   REQUIRE(num_diff == 0);
+}
+
+TEST_CASE("Mesh edge and face numbering", "[Mesh]")
+{
+   SECTION("2D meshes")
+   {
+      Mesh quad_mesh(5, 4, Element::QUADRILATERAL, true);
+      CheckTopology(quad_mesh);
+      Mesh tri_mesh(4, 5, Element::TRIANGLE, true);
+      CheckTopology(tri_mesh);
+   }
+
+   SECTION("3D meshes")
+   {
+      Mesh hex_mesh(3, 4, 2, Element::HEXAHEDRON, true);
+      CheckTopology(hex_mesh);
+      Mesh tet_mesh(2, 3, 4, Element::TETRAHEDRON, true);
+      CheckTopology(tet_mesh);
+      Mesh wedge_mesh(3, 2, 2, Element::WEDGE, true);
+      CheckTopology(wedge_mesh);
+      wedge_mesh.UniformRefinement();
+      CheckTopology(wedge_mesh);
+   }
+}
+
+// Refine a copy of the mesh with one thread and with all threads (when MFEM is
+// built with OpenMP), and compare the resulting meshes.
+static void CheckThreadedRefinement(const Mesh &mesh)
+{
+   Mesh serial_mesh(mesh, true), threaded_mesh(mesh, true);
+#ifdef MFEM_USE_OPENMP
+   const int max_threads = omp_get_max_threads();
+   omp_set_num_threads(1);
+#endif
+   serial_mesh.UniformRefinement();
+#ifdef MFEM_USE_OPENMP
+   omp_set_num_threads(max_threads);
+#endif
+   threaded_mesh.UniformRefinement();
+
+   REQUIRE(serial_mesh.GetNE() == (1 << mesh.Dimension())*mesh.GetNE());
+
+   std::ostringstream serial_out, threaded_out;
+   serial_mesh.Print(serial_out);
+   threaded_mesh.Print(threaded_out);
+   REQUIRE(threaded_out.str() == serial_out.str());
+   CheckTopology(threaded_mesh);
+}
+
+TEST_CASE("Threaded uniform refinement", "[Mesh]")
+{
+   SECTION("2D meshes")
+   {
+      Mesh quad_mesh(6, 5, Element::QUADRILATERAL, true);
+      CheckThreadedRefinement(quad_mesh);
+      Mesh tri_mesh(5, 6, Element::TRIANGLE, true);
+      CheckThreadedRefinement(tri_mesh);
+   }
+
+   SECTION("3D meshes")
+   {
+      Mesh hex_mesh(4, 3, 3, Element::HEXAHEDRON, true);
+      CheckThreadedRefinement(hex_mesh);
+      Mesh tet_mesh(3, 3, 4, Element::TETRAHEDRON, true);
+      CheckThreadedRefinement(tet_mesh);
+      Mesh wedge_mesh(3, 3, 2, Element::WEDGE, true);
+      CheckThreadedRefinement(wedge_mesh);
+   }
+
+   SECTION("Curved mesh")
+   {
+      Mesh tet_mesh(2, 2, 3, Element::TETRAHEDRON, true);
+      tet_mesh.SetCurvature(2);
+      CheckThreadedRefinement(tet_mesh);
+   }
+}
+
+static double quadratic(const Vector &x)
+{
+   double r = 1.0;
+   for (int i = 0; i < x.Size(); i++) { r += x(i)*(i + 1 - x(i)); }
+   return r;
+}
+
+// Refine every other element of the nonconforming mesh a few times and check
+// the slave point matrices through the conforming prolongation of an H1 space:
+// a continuous quadratic function must satisfy the hanging node constraints.
+static void CheckNonconformingRefinement(Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   mesh.EnsureNCMesh();
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   for (int l = 0; l < 3; l++)
+   {
+      Array<Refinement> refs;
+      for (int i = 0; i < mesh.GetNE(); i += 2) { refs.Append(Refinement(i)); }
+      mesh.GeneralRefinement(refs);
+      fes.Update();
+   }
+
+   const NCMesh::NCList &list = mesh.ncmesh->GetNCList(dim-1);
+   REQUIRE(list.slaves.size() > 0);
+   // the slaves share a few unique positions within their masters
+   REQUIRE(10*list.point_matrices.Size() < (int) list.slaves.size());
+   for (unsigned i = 0; i < list.slaves.size(); i++)
+   {
+      REQUIRE(list.slaves[i].matrix >= 0);
+      REQUIRE(list.slaves[i].matrix < list.point_matrices.Size());
+   }
+
+   FunctionCoefficient coeff(quadratic);
+   GridFunction x(&fes);
+   x.ProjectCoefficient(coeff);
+   REQUIRE(x.ComputeL2Error(coeff) < 1e-12);
+
+   const SparseMatrix *P = fes.GetConformingProlongation();
+   const SparseMatrix *R = fes.GetConformingRestriction();
+   REQUIRE(P != NULL);
+   Vector X(P->Width()), y(x.Size());
+   R->Mult(x, X);
+   P->Mult(X, y);
+   y -= x;
+   REQUIRE(y.Normlinf() < 1e-12);
+}
+
+TEST_CASE("Nonconforming refinement", "[Mesh]")
+{
+   Mesh quad_mesh(4, 4, Element::QUADRILATERAL, true);
+   CheckNonconformingRefinement(quad_mesh);
+   Mesh hex_mesh(3, 3, 3, Element::HEXAHEDRON, true);
+   CheckNonconformingRefinement(hex_mesh);
+}
+
+static void perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int i = 0; i < x.Size(); i++) { y(i) += 0.01*sin(7.0*x(i) + i); }
+}
+
+// Write the mesh in the Gmsh 2.2 format, ASCII or binary. The vertex ids are
+// not consecutive, to check the map from the ids to the vertices.
+static void PrintGmsh(const Mesh &mesh, bool binary, int id_step,
+                      std::ostream &out)
+{
+   const int gmsh_type[Geometry::NumGeom] = { 15, 1, 2, 3, 4, 5, 6 };
+   out << "$MeshFormat\n2.2 " << binary << " 8\n";
+   if (binary)
+   {
+      const int one = 1;
+      out.write(reinterpret_cast<const char*>(&one), sizeof(int));
+      out << '\n';
+   }
+   out << "$EndMeshFormat\n$Nodes\n" << mesh.GetNV() << '\n';
+   for (int i = 0; i < mesh.GetNV(); i++)
+   {
+      const int id = 1 + i*id_step;
+      double coord[3] = { 0.0, 0.0, 0.0 };
+      for (int d = 0; d < mesh.SpaceDimension(); d++)
+      {
+         coord[d] = mesh.GetVertex(i)[d];
+      }
+      if (binary)
+      {
+         out.write(reinterpret_cast<const char*>(&id), sizeof(int));
+         out.write(reinterpret_cast<const char*>(coord), sizeof(coord));
+      }
+      else
+      {
+         out << id << ' ' << coord[0] << ' ' << coord[1] << ' ' << coord[2]
+             << '\n';
+      }
+   }
+   if (binary) { out << '\n'; }
+   out << "$EndNodes\n$Elements\n" << mesh.GetNBE() + mesh.GetNE() << '\n';
+   for (int i = 0; i < mesh.GetNBE() + mesh.GetNE(); i++)
+   {
+      const Element *el = (i < mesh.GetNBE()) ? mesh.GetBdrElement(i) :
+                          mesh.GetElement(i - mesh.GetNBE());
+      // serial number, 2 tags (physical and elementary domain), vertices
+      int data[3 + 8];
+      data[0] = i + 1;
+      data[1] = el->GetAttribute();
+      data[2] = 1;
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         data[3 + j] = 1 + el->GetVertices()[j]*id_step;
+      }
+      const int size = 3 + el->GetNVertices();
+      if (binary)
+      {
+         const int header[3] = { gmsh_type[el->GetGeometryType()], 1, 2 };
+         out.write(reinterpret_cast<const char*>(header), sizeof(header));
+         out.write(reinterpret_cast<const char*>(data), size*sizeof(int));
+      }
+      else
+      {
+         out << data[0] << ' ' << gmsh_type[el->GetGeometryType()] << " 2";
+         for (int j = 1; j < size; j++) { out << ' ' << data[j]; }
+         out << '\n';
+      }
+   }
+   if (binary) { out << '\n'; }
+   out << "$EndElements\n";
+}
+
+// Read the mesh back from the MFEM format and from the Gmsh ASCII and binary
+// formats, and compare it to the original.
+static void CheckMeshReaders(Mesh &mesh, bool gmsh)
+{
+   mesh.Transform(perturb);
+   std::ostringstream mesh_out;
+   mesh_out.precision(17);
+   mesh.Print(mesh_out);
+
+   for (int format = 0; format < (gmsh ? 3 : 1); format++)
+   {
+      std::stringstream file;
+      file.precision(17);
+      if (format == 0) { file << mesh_out.str(); }
+      else { PrintGmsh(mesh, format == 2, format == 2 ? 1000 : 3, file); }
+
+      Mesh read_mesh(file, 1, 1, false);
+      std::ostringstream read_out;
+      read_out.precision(17);
+      read_mesh.Print(read_out);
+      REQUIRE(read_out.str() == mesh_out.str());
+   }
+}
+
+TEST_CASE("Mesh readers", "[Mesh]")
+{
+   SECTION("2D meshes")
+   {
+      Mesh quad_mesh(6, 5, Element::QUADRILATERAL, true);
+      CheckMeshReaders(quad_mesh, true);
+      Mesh tri_mesh(5, 6, Element::TRIANGLE, true);
+      CheckMeshReaders(tri_mesh, true);
+   }
+
+   SECTION("3D meshes")
+   {
+      Mesh tet_mesh(3, 3, 4, Element::TETRAHEDRON, true);
+      CheckMeshReaders(tet_mesh, true);
+      Mesh wedge_mesh(3, 3, 2, Element::WEDGE, true);
+      CheckMeshReaders(wedge_mesh, false);
+      // large enough to be read with several threads
+      Mesh hex_mesh(26, 26, 26, Element::HEXAHEDRON, true);
+      CheckMeshReaders(hex_mesh, true);
+   }
+
+   SECTION("Elements and vertices not on lines of their own")
+   {
+      const char *mfem_lines =
+         "MFEM mesh v1.0\n\ndimension\n2\n\nelements\n2\n"
+         "1 3 0 1 2 3\n2 3 1 4 5 2\n\nboundary\n1\n1 1 0 1\n\n"
+         "vertices\n6\n2\n0 0\n1 0\n1 1\n0 1\n2 0\n2 1\n";
+      // the second element is split over two lines, the first two vertices
+      // are on one line
+      const char *mfem_tokens =
+         "MFEM mesh v1.0\n\ndimension\n2\n\nelements\n2\n"
+         "1 3 0 1 2 3\n2 3\n1 4 5 2\n\nboundary\n1\n1 1 0 1\n\n"
+         "vertices\n6\n2\n0 0 1 0\n1 1\n0 1\n2 0\n2 1\n";
+      const char *gmsh_lines =
+         "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n4\n"
+         "1 0 0 0\n2 1 0 0\n3 1 1 0\n4 0 1 0\n$EndNodes\n"
+         "$Elements\n2\n1 1 2 1 1 1 2\n2 3 2 1 1 1 2 3 4\n$EndElements\n";
+      const char *gmsh_tokens =
+         "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n4\n"
+         "1 0 0 0 2 1 0 0\n3 1 1 0\n4 0 1\n0\n$EndNodes\n"
+         "$Elements\n2\n1 1 2 1 1 1 2\n2 3 2 1 1\n1 2 3 4\n$EndElements\n";
+      const char *lines[2] = { mfem_lines, gmsh_lines };
+      const char *tokens[2] = { mfem_tokens, gmsh_tokens };
+
+      for (int format = 0; format < 2; format++)
+      {
+         std::istringstream lines_in(lines[format]), tokens_in(tokens[format]);
+         Mesh lines_mesh(lines_in, 1, 1, false);
+         Mesh tokens_mesh(tokens_in, 1, 1, false);
+         std::ostringstream lines_out, tokens_out;
+         lines_mesh.Print(lines_out);
+         tokens_mesh.Print(tokens_out);
+         REQUIRE(tokens_mesh.GetNE() == lines_mesh.GetNE());
+         REQUIRE(tokens_out.str() == lines_out.str());
+      }
+   }
+}
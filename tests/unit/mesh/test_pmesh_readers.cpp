@@ -0,0 +1,129 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// Return the groups of the shared entities, each one given by the sorted list
+// of its ranks followed by its numbers of shared vertices, edges and faces.
+static std::vector<std::vector<int> > SharedGroups(ParMesh &pmesh)
+{
+   const GroupTopology &gtopo = pmesh.gtopo;
+   std::vector<std::vector<int> > groups;
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      std::vector<int> group;
+      for (int i = 0; i < gtopo.GetGroupSize(g); i++)
+      {
+         group.push_back(gtopo.GetNeighborRank(gtopo.GetGroup(g)[i]));
+      }
+      std::sort(group.begin(), group.end());
+      group.push_back(pmesh.GroupNVertices(g));
+      group.push_back(pmesh.GroupNEdges(g));
+      group.push_back(pmesh.GroupNTriangles(g) +
+                      pmesh.GroupNQuadrilaterals(g));
+      groups.push_back(group);
+   }
+   std::sort(groups.begin(), groups.end());
+   return groups;
+}
+
+static void CompareParMeshes(ParMesh &pmesh, ParMesh &ref)
+{
+   REQUIRE(pmesh.GetNE() == ref.GetNE());
+   REQUIRE(pmesh.GetNV() == ref.GetNV());
+   REQUIRE(pmesh.GetNBE() == ref.GetNBE());
+   REQUIRE(pmesh.GetGlobalNE() == ref.GetGlobalNE());
+   for (int i = 0; i < ref.GetNE(); i++)
+   {
+      REQUIRE(pmesh.GetAttribute(i) == ref.GetAttribute(i));
+   }
+   REQUIRE(pmesh.attributes.Size() == ref.attributes.Size());
+   REQUIRE(pmesh.bdr_attributes.Size() == ref.bdr_attributes.Size());
+   REQUIRE(pmesh.GetNSharedFaces() == ref.GetNSharedFaces());
+   REQUIRE(pmesh.GetNGroups() == ref.GetNGroups());
+   REQUIRE(SharedGroups(pmesh) == SharedGroups(ref));
+}
+
+TEST_CASE("Parallel mesh file reader", "[ParMesh]")
+{
+   MPI_Comm comm = MPI_COMM_WORLD;
+   int myid, num_procs;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+
+   const char *mesh_file = "pmesh_readers_test.mesh";
+   const char *part_file = "pmesh_readers_test.part";
+   const int ne = 4*3*5;
+   if (myid == 0)
+   {
+      Mesh mesh(4, 3, 5, Element::HEXAHEDRON);
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         mesh.SetAttribute(i, 1 + i%3);
+      }
+      std::ofstream mesh_ofs(mesh_file);
+      mesh.Print(mesh_ofs);
+
+      std::ofstream part_ofs(part_file);
+      part_ofs << "number_of_elements " << ne << '\n'
+               << "number_of_processors " << num_procs << '\n';
+      for (int i = 0; i < ne; i++)
+      {
+         part_ofs << num_procs - 1 - i%num_procs << '\n';
+      }
+   }
+   MPI_Barrier(comm);
+
+   Mesh mesh(mesh_file, 1, 1);
+   REQUIRE(mesh.GetNE() == ne);
+   Array<int> part(ne);
+
+   SECTION("Block partitioning")
+   {
+      for (int i = 0; i < ne; i++)
+      {
+         part[i] = int(((long) (i + 1)*num_procs - 1)/ne);
+      }
+      ParMesh ref(comm, mesh, part.GetData());
+      ParMesh pmesh(comm, mesh_file);
+      CompareParMeshes(pmesh, ref);
+   }
+
+   SECTION("Partitioning from a file")
+   {
+      for (int i = 0; i < ne; i++)
+      {
+         part[i] = num_procs - 1 - i%num_procs;
+      }
+      ParMesh ref(comm, mesh, part.GetData());
+      ParMesh pmesh(comm, mesh_file, part_file);
+      CompareParMeshes(pmesh, ref);
+   }
+
+   MPI_Barrier(comm);
+   if (myid == 0)
+   {
+      std::remove(mesh_file);
+      std::remove(part_file);
+   }
+}
+
+#endif // MFEM_USE_MPI
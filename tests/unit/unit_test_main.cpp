@@ -9,5 +9,21 @@
 // terms of the GNU Lesser General Public License (as published by the Free
 // Software Foundation) version 2.1 dated February 1999.
 
+#include "mfem.hpp"
+
+#ifndef MFEM_USE_MPI
 #define CATCH_CONFIG_MAIN     // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch.hpp"
+#else
+// In parallel builds, initialize MPI for the tests of the parallel classes
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+int main(int argc, char *argv[])
+{
+   MPI_Init(&argc, &argv);
+   int result = Catch::Session().run(argc, argv);
+   MPI_Finalize();
+   return result;
+}
+#endif